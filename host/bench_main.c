@@ -0,0 +1,112 @@
+/*
+ *  tw_bench: the on-device benchmarks (bench.h) on the host simulator,
+ *  plus the flush cost on the simulated bus.
+ *
+ *    tw_bench [--glyphs glyphs.bin] [--dict dict.bin] [case...]
+ *
+ *  stdout gets one JSON object per line and nothing else; the firmware's
+ *  boot log goes to stderr. Cases run with hostClockCountCpu() on, so they
+ *  time this machine's CPU; "flush" runs on the model alone.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "esp_timer.h"
+#include "esp_app_desc.h"
+#include "host.h"
+#include "sharp.h"
+#include "bench.h"
+#include "console.h"
+
+#define FLUSHES 16
+
+void app_main(void);
+
+static char **cases;
+static int ncases;
+static int failed;
+
+typedef struct {
+    bool full;
+    int64_t us;
+} Flush_t;
+
+static void flushCall(void *arg) {
+    Flush_t *f = arg;
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < FLUSHES; i++) {
+        if (f->full) refreshDisplay();
+        else updateRow(0);
+    }
+    f->us = esp_timer_get_time() - t0;
+}
+
+/* A full frame and one text row through updateLines(), CS to CS, bytes at
+ * the panel clock plus the driver cost per transaction */
+static void benchFlush(void) {
+    static const char *names[] = { "row", "frame" };
+    const HostSpiTrans_t *log;
+
+    for (int full = 0; full < 2; full++) {
+        Flush_t f = { .full = full };
+        hostSpiClear();
+        keyTaskCall(flushCall, &f);
+        size_t n = hostSpiLog(&log);
+        uint32_t bytes = 0, trans = 0;
+        for (size_t i = 0; i < n; i++) {
+            bytes += log[i].bytes;
+            trans++;
+        }
+        printf("{\"bench\":\"flush\",\"version\":\"%s\",\"iters\":%d,\"us\":%" PRId64 ",\"flush_us\":%" PRId64
+               ",\"lines\":\"%s\",\"bytes\":%" PRIu32 ",\"transactions\":%" PRIu32 "}\n",
+               esp_app_get_description()->version, FLUSHES, f.us, f.us / FLUSHES, names[full], bytes / FLUSHES,
+               trans / FLUSHES);
+    }
+}
+
+static void benchMain(void) {
+    for (int i = 0; i < ncases; i++) {
+        if (strcmp(cases[i], "flush") == 0) {
+            benchFlush();
+            continue;
+        }
+        char line[64];
+        snprintf(line, sizeof(line), "bench %s", cases[i]);
+        hostClockCountCpu(true);
+        if (hostConsoleRun(line)) failed = 1;
+        hostClockCountCpu(false);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    static char *all[] = { "flush", "keys", "frame", "row", "blit", "styles", "scaled", "glyphs", "fbops", "rect",
+                           "rotate", "editor", "search", "isearch", "spell", "complete", "lz" };
+    int i;
+
+    for (i = 1; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        const char *label = strcmp(argv[i], "--glyphs") == 0 ? "glyphs" : strcmp(argv[i], "--dict") == 0 ? "dict" : NULL;
+        if (!label) break;
+        if (!hostPartitionLoad(label, argv[i + 1])) return 2;
+    }
+    if (i < argc && argv[i][0] == '-') {
+        fprintf(stderr, "usage: %s [--glyphs glyphs.bin] [--dict dict.bin] [case...]\n", argv[0]);
+        return 2;
+    }
+    cases = i < argc ? argv + i : all;
+    ncases = i < argc ? argc - i : (int)(sizeof(all) / sizeof(all[0]));
+
+    // Boot with the log on stderr, then hand stdout back for the results
+    fflush(stdout);
+    int out = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);                // the boot's key burst and flushes
+    fflush(stdout);
+    dup2(out, STDOUT_FILENO);
+    close(out);
+
+    hostRunMain(benchMain);
+    return failed;
+}
@@ -0,0 +1,221 @@
+/*
+ *  Host shims: GPIO, LEDC, sleep, heap, reset reason, app description,
+ *  ROM CRC and the cycle counter. See host.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "esp_sleep.h"
+#include "esp_heap_caps.h"
+#include "esp_system.h"
+#include "esp_app_desc.h"
+#include "esp_rom_crc.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sim.h"
+
+#ifndef HOST_APP_VERSION
+#define HOST_APP_VERSION "host"
+#endif
+
+/* RC_FAST, the LEDC clock that keeps running in light sleep */
+#define LEDC_RC_FAST_HZ 17500000
+#define LEDC_APB_HZ 80000000
+#define LEDC_DIV_MAX 1023
+
+/* Free after boot on the S3, and the Feather S3's PSRAM */
+#define HEAP_INTERNAL_BYTES (300 * 1024)
+#define HEAP_PSRAM_BYTES (8 * 1024 * 1024)
+
+esp_reset_reason_t sim_reset_reason = ESP_RST_POWERON;
+
+/* GPIO */
+
+static uint8_t levels[GPIO_NUM_MAX];
+static gpio_mode_t modes[GPIO_NUM_MAX];
+static uint32_t edges;
+
+static bool validPin(gpio_num_t pin) {
+    return pin >= 0 && pin < GPIO_NUM_MAX;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t pin, gpio_mode_t mode) {
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    modes[pin] = mode;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t pin, gpio_pull_mode_t pull) {
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    if (modes[pin] != GPIO_MODE_OUTPUT) levels[pin] = pull == GPIO_PULLUP_ONLY;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t pin, uint32_t level) {
+    if (!validPin(pin)) return ESP_ERR_INVALID_ARG;
+    if (level && !levels[pin] && modes[pin] == GPIO_MODE_OUTPUT) edges++;
+    levels[pin] = level != 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t pin) {
+    return validPin(pin) ? levels[pin] : 0;
+}
+
+uint32_t simGpioEdges(void) {
+    return edges;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t type) {
+    if (!validPin(pin) || (type != GPIO_INTR_LOW_LEVEL && type != GPIO_INTR_HIGH_LEVEL)) return ESP_ERR_INVALID_ARG;
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void) {
+    return ESP_OK;
+}
+
+/* LEDC */
+
+static ledc_timer_config_t ledc_timers[LEDC_TIMER_MAX];
+static bool ledc_timer_set[LEDC_TIMER_MAX];
+static ledc_channel_config_t ledc_channels[LEDC_CHANNEL_MAX];
+static bool ledc_channel_set[LEDC_CHANNEL_MAX];
+static int64_t ledc_start[LEDC_TIMER_MAX];
+
+/* The timer divides its clock down to freq_hz << resolution, by at most
+ * LEDC_DIV_MAX; the driver fails the same way when it cannot */
+esp_err_t ledc_timer_config(const ledc_timer_config_t *config) {
+    if (config->timer_num >= LEDC_TIMER_MAX || !config->freq_hz) return ESP_ERR_INVALID_ARG;
+    uint64_t src = config->clk_cfg == LEDC_USE_RC_FAST_CLK ? LEDC_RC_FAST_HZ
+                 : config->clk_cfg == LEDC_USE_XTAL_CLK ? CONFIG_XTAL_FREQ * 1000000ULL : LEDC_APB_HZ;
+    uint64_t div = src / ((uint64_t)config->freq_hz << config->duty_resolution);
+    if (div < 1 || div > LEDC_DIV_MAX) {
+        printf("E ledc: requested frequency %u and duty resolution %u cannot be achieved\n",
+               (unsigned)config->freq_hz, (unsigned)config->duty_resolution);
+        return ESP_FAIL;
+    }
+    ledc_timers[config->timer_num] = *config;
+    ledc_timer_set[config->timer_num] = true;
+    ledc_start[config->timer_num] = esp_timer_get_time();
+    return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *config) {
+    if (config->channel >= LEDC_CHANNEL_MAX || config->timer_sel >= LEDC_TIMER_MAX ||
+        !ledc_timer_set[config->timer_sel] || !validPin(config->gpio_num))
+        return ESP_ERR_INVALID_ARG;
+    if (config->duty > (1u << ledc_timers[config->timer_sel].duty_resolution)) return ESP_ERR_INVALID_ARG;
+    ledc_channels[config->channel] = *config;
+    ledc_channel_set[config->channel] = true;
+    return ESP_OK;
+}
+
+const ledc_channel_config_t *hostLedcChannel(int channel) {
+    return channel >= 0 && channel < LEDC_CHANNEL_MAX && ledc_channel_set[channel] ? &ledc_channels[channel] : NULL;
+}
+
+const ledc_timer_config_t *hostLedcTimer(int timer) {
+    return timer >= 0 && timer < LEDC_TIMER_MAX && ledc_timer_set[timer] ? &ledc_timers[timer] : NULL;
+}
+
+/* High from hpoint for duty counts of every period */
+int hostLedcLevel(int channel, int64_t t_us) {
+    const ledc_channel_config_t *ch = hostLedcChannel(channel);
+    if (!ch) return -1;
+    const ledc_timer_config_t *tm = &ledc_timers[ch->timer_sel];
+    uint64_t counts = 1ull << tm->duty_resolution;
+    int64_t since = t_us - ledc_start[ch->timer_sel];
+    if (since < 0) return -1;
+    uint64_t count = (uint64_t)since * tm->freq_hz % 1000000 * counts / 1000000;
+    uint64_t on = (count + counts - ch->hpoint) % counts;
+    return (on < ch->duty) ^ ch->flags.output_invert;
+}
+
+/* Heap: the budget reports see the device's two heaps, internal SRAM
+ * left after boot and the board's PSRAM */
+
+typedef struct {
+    size_t size, used, peak;
+} Heap_t;
+
+static Heap_t heaps[2] = { { HEAP_INTERNAL_BYTES }, { HEAP_PSRAM_BYTES } };
+
+static Heap_t *heapFor(uint32_t caps) {
+    return &heaps[(caps & MALLOC_CAP_SPIRAM) != 0];
+}
+
+/* The size and heap go in a header in front of the block */
+typedef struct {
+    size_t size;
+    Heap_t *heap;
+    size_t offset;
+} Block_t;
+
+static void *heapAlloc(size_t alignment, size_t size, uint32_t caps) {
+    Heap_t *h = heapFor(caps);
+    if (size > h->size - h->used) return NULL;
+    if (alignment < 16) alignment = 16;
+    uint8_t *raw = malloc(size + alignment + sizeof(Block_t));
+    if (!raw) return NULL;
+    uint8_t *p = (uint8_t *)(((uintptr_t)raw + sizeof(Block_t) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    ((Block_t *)p)[-1] = (Block_t){ size, h, p - raw };
+    h->used += size;
+    if (h->used > h->peak) h->peak = h->used;
+    return p;
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    return heapAlloc(sizeof(void *), size, caps);
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    return heapAlloc(alignment, size, caps);
+}
+
+void heap_caps_free(void *p) {
+    if (!p) return;
+    Block_t *b = &((Block_t *)p)[-1];
+    b->heap->used -= b->size;
+    free((uint8_t *)p - b->offset);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return heapFor(caps)->size - heapFor(caps)->used;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return heapFor(caps)->size - heapFor(caps)->peak;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return heap_caps_get_free_size(caps);
+}
+
+/* System */
+
+esp_reset_reason_t esp_reset_reason(void) {
+    return sim_reset_reason;
+}
+
+const esp_app_desc_t *esp_app_get_description(void) {
+    static const esp_app_desc_t desc = { .version = HOST_APP_VERSION, .project_name = "SHARP" };
+    return &desc;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void) {
+    return (esp_cpu_cycle_count_t)(esp_timer_get_time() * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+}
@@ -0,0 +1,54 @@
+/*
+ *  Console command registry for the host. See host.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "esp_console.h"
+#include "host.h"
+
+#define CONSOLE_MAX_COMMANDS 32
+#define CONSOLE_MAX_ARGS 16
+#define CONSOLE_LINE_MAX 256
+
+static esp_console_cmd_t commands[CONSOLE_MAX_COMMANDS];
+static int ncommands;
+
+esp_err_t esp_console_new_repl_uart(const esp_console_dev_uart_config_t *dev, const esp_console_repl_config_t *config,
+                                    esp_console_repl_t **out) {
+    static int repl;
+    *out = (esp_console_repl_t *)&repl;
+    return ESP_OK;
+}
+
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd) {
+    if (!cmd->command || !cmd->func || strchr(cmd->command, ' ')) return ESP_ERR_INVALID_ARG;
+    for (int i = 0; i < ncommands; i++)
+        if (strcmp(commands[i].command, cmd->command) == 0) {
+            commands[i] = *cmd;
+            return ESP_OK;
+        }
+    if (ncommands == CONSOLE_MAX_COMMANDS) return ESP_ERR_NO_MEM;
+    commands[ncommands++] = *cmd;
+    return ESP_OK;
+}
+
+/* No REPL task: lines come from hostConsoleRun() */
+esp_err_t esp_console_start_repl(esp_console_repl_t *repl) {
+    return ESP_OK;
+}
+
+int hostConsoleRun(const char *line) {
+    char buf[CONSOLE_LINE_MAX];
+    char *argv[CONSOLE_MAX_ARGS + 1];
+    int argc = 0;
+
+    snprintf(buf, sizeof(buf), "%s", line);
+    for (char *tok = strtok(buf, " \t\n"); tok && argc < CONSOLE_MAX_ARGS; tok = strtok(NULL, " \t\n"))
+        argv[argc++] = tok;
+    argv[argc] = NULL;
+    if (!argc) return 0;
+    for (int i = 0; i < ncommands; i++)
+        if (strcmp(commands[i].command, argv[0]) == 0) return commands[i].func(argc, argv);
+    printf("Unrecognized command\n");
+    return -1;
+}
@@ -0,0 +1,326 @@
+/*
+ *  Host shims for flash: the data partitions, NVS, and the state kept
+ *  across simulated resets. See host.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_partition.h"
+#include "nvs_flash.h"
+#include "host.h"
+#include "sim.h"
+
+#define MB (1024 * 1024)
+#define NVS_MAX_ENTRIES 32
+#define NVS_NAME_MAX 16
+/* A 24 KB partition keeps one page free for compaction; 32 bytes of
+ * every page's entries are headers */
+#define NVS_CAPACITY (5 * (HOST_FLASH_SECTOR - 128))
+#define STATE_MAGIC 0x54535754      /* "TWST" */
+
+/* The data partitions of partitions.csv */
+typedef struct {
+    esp_partition_t part;
+    uint8_t *data;          /* erased flash until first used */
+} Partition_t;
+
+static Partition_t partitions[] = {
+    { { ESP_PARTITION_TYPE_DATA, 0x01, 0x9000, 0x6000, HOST_FLASH_SECTOR, "nvs" } },
+    { { ESP_PARTITION_TYPE_DATA, 0x40, 0x410000, 2 * MB, HOST_FLASH_SECTOR, "glyphs" } },
+    { { ESP_PARTITION_TYPE_DATA, 0x41, 0x610000, 2 * MB, HOST_FLASH_SECTOR, "dict" } },
+    { { ESP_PARTITION_TYPE_DATA, 0x42, 0x810000, 2 * MB, HOST_FLASH_SECTOR, "docs" } },
+};
+#define NPARTITIONS (sizeof(partitions) / sizeof(partitions[0]))
+
+typedef struct {
+    char ns[NVS_NAME_MAX];
+    char key[NVS_NAME_MAX];
+    size_t len;
+    uint8_t *data;
+} NvsEntry_t;
+
+static NvsEntry_t nvs[NVS_MAX_ENTRIES];
+static bool nvs_ready;
+static char nvs_open_ns[8][NVS_NAME_MAX];
+
+/* Partitions */
+
+static Partition_t *partitionFor(const esp_partition_t *part) {
+    for (size_t i = 0; i < NPARTITIONS; i++)
+        if (&partitions[i].part == part) {
+            if (!partitions[i].data) {
+                partitions[i].data = malloc(part->size);
+                if (!partitions[i].data) abort();
+                memset(partitions[i].data, 0xff, part->size);
+            }
+            return &partitions[i];
+        }
+    return NULL;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label) {
+    for (size_t i = 0; i < NPARTITIONS; i++) {
+        const esp_partition_t *p = &partitions[i].part;
+        if (p->type == type && (subtype == ESP_PARTITION_SUBTYPE_ANY || p->subtype == subtype) &&
+            (!label || strcmp(p->label, label) == 0))
+            return p;
+    }
+    return NULL;
+}
+
+static bool inside(const esp_partition_t *part, size_t offset, size_t size) {
+    return offset <= part->size && size <= part->size - offset;
+}
+
+/* Reads through the cache cost nothing here; the first touch of a page
+ * would cost a cache miss on the device */
+esp_err_t esp_partition_mmap(const esp_partition_t *part, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void **out, esp_partition_mmap_handle_t *handle) {
+    Partition_t *p = partitionFor(part);
+    if (!p || !inside(part, offset, size)) return ESP_ERR_INVALID_ARG;
+    *out = p->data + offset;
+    *handle = 1;
+    return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle) {
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size) {
+    Partition_t *p = partitionFor(part);
+    if (!p || !inside(part, offset, size)) return ESP_ERR_INVALID_ARG;
+    memcpy(dst, p->data + offset, size);
+    simStall((int64_t)size * HOST_FLASH_READ_NS / 1000);
+    return ESP_OK;
+}
+
+/* NOR flash: a write only clears bits */
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size) {
+    Partition_t *p = partitionFor(part);
+    if (!p || !inside(part, offset, size)) return ESP_ERR_INVALID_ARG;
+    const uint8_t *s = src;
+    for (size_t i = 0; i < size; i++) p->data[offset + i] &= s[i];
+    simStall((int64_t)size * HOST_FLASH_WRITE_NS / 1000);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size) {
+    Partition_t *p = partitionFor(part);
+    if (!p || !inside(part, offset, size) || offset % HOST_FLASH_SECTOR || size % HOST_FLASH_SECTOR)
+        return ESP_ERR_INVALID_ARG;
+    memset(p->data + offset, 0xff, size);
+    simStall((int64_t)(size / HOST_FLASH_SECTOR) * HOST_FLASH_ERASE_US);
+    return ESP_OK;
+}
+
+uint8_t *hostPartition(const char *label, size_t *size) {
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part) return NULL;
+    if (size) *size = part->size;
+    return partitionFor(part)->data;
+}
+
+bool hostPartitionLoad(const char *label, const char *path) {
+    size_t size;
+    uint8_t *data = hostPartition(label, &size);
+    FILE *f = fopen(path, "rb");
+    if (!data || !f) {
+        printf("host: cannot load %s into \"%s\"\n", path, label);
+        if (f) fclose(f);
+        return false;
+    }
+    size_t n = fread(data, 1, size, f);
+    bool ok = n > 0 && fgetc(f) == EOF;
+    fclose(f);
+    if (!ok) printf("host: %s does not fit \"%s\"\n", path, label);
+    return ok;
+}
+
+/* NVS */
+
+esp_err_t nvs_flash_init(void) {
+    simStall(HOST_NVS_INIT_US);
+    nvs_ready = true;
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    for (size_t i = 0; i < NVS_MAX_ENTRIES; i++) {
+        free(nvs[i].data);
+        memset(&nvs[i], 0, sizeof(nvs[i]));
+    }
+    nvs_ready = false;
+    simStall(6 * HOST_FLASH_ERASE_US);
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *out) {
+    if (!nvs_ready) return ESP_ERR_NVS_NOT_INITIALIZED;
+    if (strlen(name) >= NVS_NAME_MAX) return ESP_ERR_INVALID_ARG;
+    for (nvs_handle_t h = 0; h < 8; h++)
+        if (!nvs_open_ns[h][0]) {
+            strcpy(nvs_open_ns[h], name);
+            *out = h + 1;
+            return ESP_OK;
+        }
+    return ESP_ERR_NO_MEM;
+}
+
+void nvs_close(nvs_handle_t h) {
+    if (h >= 1 && h <= 8) nvs_open_ns[h - 1][0] = 0;
+}
+
+static NvsEntry_t *nvsFind(nvs_handle_t h, const char *key) {
+    if (h < 1 || h > 8 || !nvs_open_ns[h - 1][0]) return NULL;
+    for (size_t i = 0; i < NVS_MAX_ENTRIES; i++)
+        if (nvs[i].data && strcmp(nvs[i].ns, nvs_open_ns[h - 1]) == 0 && strcmp(nvs[i].key, key) == 0)
+            return &nvs[i];
+    return NULL;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t h, const char *key, void *out, size_t *len) {
+    NvsEntry_t *e = nvsFind(h, key);
+    simStall(HOST_NVS_OP_US);
+    if (!e) return ESP_ERR_NVS_NOT_FOUND;
+    if (!out) {
+        *len = e->len;
+        return ESP_OK;
+    }
+    if (*len < e->len) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out, e->data, e->len);
+    *len = e->len;
+    simStall((int64_t)e->len * HOST_FLASH_READ_NS / 1000);
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t h, const char *key, const void *value, size_t len) {
+    if (h < 1 || h > 8 || !nvs_open_ns[h - 1][0] || strlen(key) >= NVS_NAME_MAX) return ESP_ERR_INVALID_ARG;
+    NvsEntry_t *e = nvsFind(h, key);
+    size_t used = 0;
+    for (size_t i = 0; i < NVS_MAX_ENTRIES; i++)
+        if (nvs[i].data && &nvs[i] != e) used += nvs[i].len;
+    if (used + len > NVS_CAPACITY) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    if (!e)
+        for (size_t i = 0; i < NVS_MAX_ENTRIES && !e; i++)
+            if (!nvs[i].data) e = &nvs[i];
+    if (!e) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    uint8_t *data = malloc(len ? len : 1);
+    if (!data) return ESP_ERR_NO_MEM;
+    memcpy(data, value, len);
+    free(e->data);
+    strcpy(e->ns, nvs_open_ns[h - 1]);
+    strcpy(e->key, key);
+    e->data = data;
+    e->len = len;
+    simStall(HOST_NVS_OP_US + (int64_t)len * HOST_FLASH_WRITE_NS / 1000);
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t h, const char *key) {
+    NvsEntry_t *e = nvsFind(h, key);
+    simStall(HOST_NVS_OP_US);
+    if (!e) return ESP_ERR_NVS_NOT_FOUND;
+    free(e->data);
+    memset(e, 0, sizeof(*e));
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t h) {
+    return ESP_OK;
+}
+
+/* State across resets: the partitions' written sectors, the NVS entries
+ * and the RTC_NOINIT section */
+
+extern uint8_t __start_rtc_noinit[] __attribute__((weak));
+extern uint8_t __stop_rtc_noinit[] __attribute__((weak));
+
+static size_t rtcSize(void) {
+    return __start_rtc_noinit ? (size_t)(__stop_rtc_noinit - __start_rtc_noinit) : 0;
+}
+
+static bool sectorErased(const uint8_t *s) {
+    for (size_t i = 0; i < HOST_FLASH_SECTOR; i++)
+        if (s[i] != 0xff) return false;
+    return true;
+}
+
+bool hostSaveState(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    uint32_t magic = STATE_MAGIC;
+    fwrite(&magic, sizeof(magic), 1, f);
+
+    for (size_t i = 0; i < NPARTITIONS; i++) {
+        const uint8_t *data = partitions[i].data;
+        for (uint32_t s = 0; data && s < partitions[i].part.size / HOST_FLASH_SECTOR; s++) {
+            if (sectorErased(data + s * HOST_FLASH_SECTOR)) continue;
+            uint32_t at[2] = { i, s };
+            fwrite(at, sizeof(at), 1, f);
+            fwrite(data + s * HOST_FLASH_SECTOR, HOST_FLASH_SECTOR, 1, f);
+        }
+    }
+    uint32_t end[2] = { UINT32_MAX, 0 };
+    fwrite(end, sizeof(end), 1, f);
+
+    for (size_t i = 0; i < NVS_MAX_ENTRIES; i++) {
+        if (!nvs[i].data) continue;
+        uint32_t len = nvs[i].len;
+        fwrite(nvs[i].ns, NVS_NAME_MAX, 1, f);
+        fwrite(nvs[i].key, NVS_NAME_MAX, 1, f);
+        fwrite(&len, sizeof(len), 1, f);
+        fwrite(nvs[i].data, len, 1, f);
+    }
+    char none[NVS_NAME_MAX] = { 0 };
+    fwrite(none, NVS_NAME_MAX, 1, f);
+
+    uint32_t rtc = rtcSize();
+    fwrite(&rtc, sizeof(rtc), 1, f);
+    fwrite(__start_rtc_noinit, rtc, 1, f);
+    return fclose(f) == 0;
+}
+
+bool hostLoadState(const char *path, esp_reset_reason_t reason) {
+    FILE *f = fopen(path, "rb");
+    uint32_t magic = 0, rtc = 0;
+    bool ok = false;
+
+    if (!f) return false;
+    if (fread(&magic, sizeof(magic), 1, f) != 1 || magic != STATE_MAGIC) goto done;
+    for (;;) {
+        uint32_t at[2];
+        if (fread(at, sizeof(at), 1, f) != 1) goto done;
+        if (at[0] == UINT32_MAX) break;
+        if (at[0] >= NPARTITIONS || at[1] >= partitions[at[0]].part.size / HOST_FLASH_SECTOR) goto done;
+        uint8_t *data = partitionFor(&partitions[at[0]].part)->data;
+        if (fread(data + at[1] * HOST_FLASH_SECTOR, HOST_FLASH_SECTOR, 1, f) != 1) goto done;
+    }
+    for (size_t i = 0;; i++) {
+        char ns[NVS_NAME_MAX];
+        uint32_t len;
+        if (fread(ns, NVS_NAME_MAX, 1, f) != 1) goto done;
+        if (!ns[0]) break;
+        if (i == NVS_MAX_ENTRIES || fread(nvs[i].key, NVS_NAME_MAX, 1, f) != 1 ||
+            fread(&len, sizeof(len), 1, f) != 1 || !(nvs[i].data = malloc(len ? len : 1)) ||
+            (len && fread(nvs[i].data, len, 1, f) != 1))
+            goto done;
+        memcpy(nvs[i].ns, ns, NVS_NAME_MAX);
+        nvs[i].len = len;
+    }
+    if (fread(&rtc, sizeof(rtc), 1, f) != 1 || rtc != rtcSize()) goto done;
+
+    // RTC memory keeps its contents over a warm reset only
+    bool warm = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+    if (warm) {
+        if (rtc && fread(__start_rtc_noinit, rtc, 1, f) != 1) goto done;
+    } else {
+        for (uint32_t i = 0; i < rtc; i++) __start_rtc_noinit[i] = (uint8_t)(i * 151 + 7);
+    }
+    sim_reset_reason = reason;
+    ok = true;
+done:
+    fclose(f);
+    if (!ok) printf("host: %s is not a saved state\n", path);
+    return ok;
+}
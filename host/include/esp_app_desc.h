@@ -0,0 +1,9 @@
+#pragma once
+
+typedef struct {
+    char version[32];
+    char project_name[32];
+} esp_app_desc_t;
+
+/* version is the git description the host build was configured at */
+const esp_app_desc_t *esp_app_get_description(void);
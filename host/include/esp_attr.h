@@ -0,0 +1,13 @@
+/*
+ *  Memory placement attributes. Only RTC_NOINIT_ATTR means anything on the
+ *  host: those variables go in their own section, which host.h keeps
+ *  across a simulated warm reset.
+ */
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define DMA_ATTR WORD_ALIGNED_ATTR DRAM_ATTR
+#define EXT_RAM_BSS_ATTR
+#define RTC_NOINIT_ATTR __attribute__((section("rtc_noinit")))
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Busy-waits on the device; advances the host clock */
+void esp_rom_delay_us(uint32_t us);
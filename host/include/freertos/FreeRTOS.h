@@ -0,0 +1,50 @@
+/*
+ *  FreeRTOS on the host simulator (host/sim.c): tasks are coroutines run
+ *  one at a time by priority, and time only moves when they all wait, so
+ *  a run is the same every time. The tick rate is the device's.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t StackType_t;            /* stack sizes are in bytes, as on ESP-IDF */
+typedef void (*TaskFunction_t)(void *arg);
+
+/* Queues and semaphores live in the caller's static buffer */
+typedef struct HostQueue {
+    uint8_t *storage;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+typedef StaticQueue_t *QueueHandle_t;
+typedef StaticQueue_t *SemaphoreHandle_t;
+
+typedef struct HostTask *TaskHandle_t;
+typedef struct {
+    TaskHandle_t task;
+} StaticTask_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define errQUEUE_FULL 0
+
+#define configTICK_RATE_HZ CONFIG_FREERTOS_HZ
+#define configMAX_PRIORITIES 25
+#define tskIDLE_PRIORITY 0
+#define portMAX_DELAY ((TickType_t)0xffffffffu)
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define tskNO_AFFINITY 0x7fffffff
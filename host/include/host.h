@@ -0,0 +1,99 @@
+/*
+ *  Host simulator controls, for the benchmarks and tests in host/.
+ *
+ *  The firmware's modules build unchanged against the shims in
+ *  host/include. FreeRTOS tasks run as coroutines, one at a time, highest
+ *  priority first; a task runs until it blocks, and time only moves when
+ *  every task is blocked: to the next timeout or esp_timer deadline, at
+ *  once. On top of that the shims charge what the hardware would take:
+ *
+ *    SPI           bytes at the device's bus clock plus HOST_SPI_TRANS_NS
+ *                  per transaction; the sending task blocks meanwhile
+ *    flash         reads, page writes and sector erases (HOST_FLASH_*),
+ *                  with the CPU stalled as on the device
+ *    NVS           the flash writes of a blob, plus HOST_NVS_OP_US
+ *    esp_rom_delay_us()  as given
+ *    a queue or semaphore polled empty (0 timeout)  HOST_POLL_US, and the
+ *                  task yields to others of its priority
+ *
+ *  Code itself takes no time unless hostClockCountCpu() is on, so a run is
+ *  the same on every machine. The benchmarks turn it on to time real work.
+ *
+ *  Power: while every task is blocked and no esp_pm lock is held, the chip
+ *  is in light sleep, if the next deadline the tickless idle knows of is
+ *  at least HOST_SLEEP_MIN_TICKS away (CONFIG_FREERTOS_IDLE_TIME_BEFORE_SLEEP).
+ *  Tasks marked with hostTaskExternal() stand for interrupts (a key press):
+ *  their deadlines wake the chip but are not known in advance.
+ *
+ *  Resets: hostSaveState() writes the partitions, NVS and the RTC_NOINIT
+ *  variables to a file; a fresh process (the tests fork one per boot)
+ *  loads them back with hostLoadState(), keeping RTC memory only for a
+ *  warm reset reason.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_system.h"
+#include "driver/ledc.h"
+
+#define HOST_SPI_TRANS_NS 18000         /* driver cost of one spi_device_transmit() */
+#define HOST_FLASH_READ_NS 25           /* per byte, about 40 MB/s through the cache */
+#define HOST_FLASH_WRITE_NS 2000        /* per byte, a 256 byte page in about 0.5 ms */
+#define HOST_FLASH_ERASE_US 40000       /* per 4 KB sector */
+#define HOST_FLASH_SECTOR 4096
+#define HOST_NVS_OP_US 300              /* lookup and entry bookkeeping */
+#define HOST_NVS_INIT_US 8000           /* page scan of the 24 KB "nvs" partition */
+#define HOST_SLEEP_MIN_TICKS 3
+#define HOST_POLL_US 1
+
+/* Clock */
+void hostClockCountCpu(bool on);
+/* Run tasks and timers until the clock reaches until_us */
+void hostRun(int64_t until_us);
+void hostRunFor(int64_t us);
+/* Run fn as the main task (priority 1, as ESP-IDF's app_main) until it
+ * returns; the tasks it starts run too */
+void hostRunMain(void (*fn)(void));
+/* The task stands for an interrupt source, see above */
+void hostTaskExternal(TaskHandle_t task);
+
+/* Power, since start */
+typedef struct {
+    int64_t sleep_us;       /* light sleep */
+    int64_t idle_us;        /* all tasks blocked but awake: a lock held, or too short to sleep */
+    uint32_t wakeups;       /* light sleeps ended */
+} HostPower_t;
+void hostPowerGet(HostPower_t *out);
+
+/* SPI transactions since the last hostSpiClear() */
+typedef struct {
+    int64_t start_us;
+    uint32_t duration_ns;
+    uint32_t bytes;
+    uint32_t window;        /* CS window (rising edges of output pins) it was sent in */
+    uint8_t first;          /* first byte: the command byte if it opens the window */
+} HostSpiTrans_t;
+size_t hostSpiLog(const HostSpiTrans_t **out);
+void hostSpiClear(void);
+
+/* Configuration of an LEDC channel, NULL if never configured, and its
+ * output level at a time on the host clock */
+const ledc_channel_config_t *hostLedcChannel(int channel);
+const ledc_timer_config_t *hostLedcTimer(int timer);
+int hostLedcLevel(int channel, int64_t t_us);
+
+/* Flash partitions by label, erased until written */
+uint8_t *hostPartition(const char *label, size_t *size);
+/* Write a file (a glyph or dictionary image) at the start of a partition */
+bool hostPartitionLoad(const char *label, const char *path);
+
+/* Resets */
+bool hostSaveState(const char *path);
+bool hostLoadState(const char *path, esp_reset_reason_t reason);
+
+/* Run a console line through the registered commands, as the REPL would;
+ * call it from a task. Returns the command's result, -1 if unknown. */
+int hostConsoleRun(const char *line);
@@ -0,0 +1,12 @@
+/*
+ *  Host build configuration: the options the code tests, as the device's
+ *  sdkconfig.defaults sets them, on the Linux target.
+ */
+#pragma once
+
+#define CONFIG_IDF_TARGET_LINUX 1
+#define CONFIG_PM_ENABLE 1
+#define CONFIG_FREERTOS_USE_TICKLESS_IDLE 1
+#define CONFIG_FREERTOS_HZ 100
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 240
+#define CONFIG_XTAL_FREQ 40
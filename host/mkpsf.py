@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""Write a synthetic 8x16 PSF2 font with a Unicode table, for the host tests.
+
+Covers ASCII, Latin-1, Greek, Cyrillic, arrows, math operators and the
+miscellaneous symbols, each glyph a pattern of its codepoint so any two
+tell apart. As in real console fonts, look-alike capitals share one glyph
+(Latin A, Greek Alpha and Cyrillic A) and some entries carry a combining
+sequence, which tools/mkglyphs.py skips.
+
+    host/mkpsf.py synthetic.psf
+    tools/mkglyphs.py synthetic.psf glyphs.bin
+"""
+import struct
+import sys
+
+PSF2_MAGIC = 0x864AB572
+PSF2_HAS_UNICODE_TABLE = 0x01
+RANGES = [(0x20, 0x7E), (0xA0, 0xFF), (0x370, 0x3FF), (0x400, 0x4FF),
+          (0x2190, 0x21FF), (0x2200, 0x22FF), (0x2600, 0x26FF)]
+# Drawn with the glyph of the first codepoint
+SHARED = {0x391: 0x41, 0x392: 0x42, 0x395: 0x45, 0x410: 0x41, 0x412: 0x42, 0x415: 0x45}
+# Sequences after a glyph's codepoints, as "e" with a combining acute
+SEQUENCES = {0xE9: [0x65, 0x301]}
+
+
+def glyph(cp):
+    """A box with the codepoint's bits inside, MSB first, 1 = ink"""
+    rows = [0x00, 0x7E]
+    for r in range(12):
+        rows.append(0x42 | (((cp * 2654435761) >> (r * 2) & 0x0F) << 2))
+    return bytes(rows + [0x7E, 0x00])
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    cps = [cp for lo, hi in RANGES for cp in range(lo, hi + 1) if cp not in SHARED]
+    glyphs, table = b'', b''
+    for cp in cps:
+        glyphs += glyph(cp)
+        entry = chr(cp) + ''.join(chr(c) for c, to in sorted(SHARED.items()) if to == cp)
+        table += entry.encode('utf-8')
+        if cp in SEQUENCES:
+            table += b'\xfe' + ''.join(chr(c) for c in SEQUENCES[cp]).encode('utf-8')
+        table += b'\xff'
+    header = struct.pack('<8I', PSF2_MAGIC, 0, 32, PSF2_HAS_UNICODE_TABLE, len(cps), 16, 16, 8)
+    open(sys.argv[1], 'wb').write(header + glyphs + table)
+
+
+if __name__ == '__main__':
+    main()
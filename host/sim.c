@@ -0,0 +1,509 @@
+/*
+ *  Host simulator: FreeRTOS tasks, queues and semaphores, esp_timer, the
+ *  clock and the power accounting. See host.h.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_pm.h"
+#include "esp_rom_sys.h"
+#include "host.h"
+#include "sim.h"
+
+/* Tasks run on stacks of their own, much larger than the ones they ask
+ * for: host code (glibc printf) needs more. Painted, to find how deep a
+ * task went. */
+#define SIM_STACK (256 * 1024)
+#define STACK_PAINT 0xa5
+#define NEVER INT64_MAX
+#define TICK_US (1000000 / configTICK_RATE_HZ)
+
+typedef enum { TASK_READY, TASK_BLOCKED, TASK_DELETED } TaskState;
+
+struct HostTask {
+    ucontext_t ctx;
+    TaskFunction_t fn;
+    void *arg;
+    const char *name;
+    UBaseType_t priority;
+    uint32_t stack_bytes;           /* asked for */
+    uint8_t *stack;
+    TaskState state;
+    bool timed_out;
+    bool external;
+    int64_t wake_at;                /* NEVER without a timeout */
+    const void *waiting_on;         /* queue, NULL for a delay */
+    uint64_t ready_seq;             /* FIFO among equal priorities */
+    struct HostTask *next;
+};
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    bool skip_unhandled;
+    bool active;
+    int64_t period;                 /* 0 for one-shot */
+    int64_t due;
+    struct esp_timer *next;
+};
+
+static struct HostTask *tasks, *current;
+static ucontext_t sched_ctx;
+static uint64_t ready_seq;
+static struct esp_timer *timers;
+
+static int64_t now_us;
+static bool count_cpu;
+static int64_t cpu_mark;
+static int64_t awake_until;         /* busy hardware keeps the chip awake */
+static bool sleeping;
+static bool light_sleep;
+static int pm_locks;
+static HostPower_t power;
+
+/* Clock */
+
+static int64_t monotonicUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+int64_t esp_timer_get_time(void) {
+    if (count_cpu) {
+        int64_t t = monotonicUs();
+        now_us += t - cpu_mark;
+        cpu_mark = t;
+    }
+    return now_us;
+}
+
+void hostClockCountCpu(bool on) {
+    esp_timer_get_time();
+    count_cpu = on;
+    cpu_mark = monotonicUs();
+}
+
+void simStall(int64_t us) {
+    if (us > 0) now_us = esp_timer_get_time() + us;
+}
+
+void esp_rom_delay_us(uint32_t us) {
+    simStall(us);
+}
+
+/* Timers */
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+    struct esp_timer *t = calloc(1, sizeof(*t));
+    if (!t) return ESP_ERR_NO_MEM;
+    t->callback = args->callback;
+    t->arg = args->arg;
+    t->skip_unhandled = args->skip_unhandled_events;
+    t->next = timers;
+    timers = t;
+    *out = t;
+    return ESP_OK;
+}
+
+static esp_err_t timerStart(esp_timer_handle_t t, uint64_t us, bool periodic) {
+    if (t->active) return ESP_ERR_INVALID_STATE;
+    t->active = true;
+    t->period = periodic ? (int64_t)us : 0;
+    t->due = esp_timer_get_time() + us;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t t, uint64_t period_us) {
+    return timerStart(t, period_us, true);
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t timeout_us) {
+    return timerStart(t, timeout_us, false);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t t) {
+    if (!t->active) return ESP_ERR_INVALID_STATE;
+    t->active = false;
+    return ESP_OK;
+}
+
+static void wake(void) {
+    if (!sleeping) return;
+    sleeping = false;
+    power.wakeups++;
+}
+
+/* Callbacks run outside any task, as on the esp_timer task: they must
+ * not block */
+static void fireTimers(void) {
+    for (;;) {
+        int64_t now = esp_timer_get_time();
+        struct esp_timer *due = NULL;
+        for (struct esp_timer *t = timers; t; t = t->next)
+            if (t->active && t->due <= now && (!due || t->due < due->due)) due = t;
+        if (!due) return;
+        if (!due->period) due->active = false;
+        else if (due->skip_unhandled) due->due += due->period * ((now - due->due) / due->period + 1);
+        else due->due += due->period;
+        wake();
+        struct HostTask *was = current;
+        current = NULL;
+        due->callback(due->arg);
+        current = was;
+    }
+}
+
+/* Tasks */
+
+static void makeReady(struct HostTask *t) {
+    t->state = TASK_READY;
+    t->waiting_on = NULL;
+    t->wake_at = NEVER;
+    t->ready_seq = ready_seq++;
+}
+
+static void trampoline(void) {
+    current->fn(current->arg);
+    vTaskDelete(NULL);
+}
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_bytes, void *arg,
+                                           UBaseType_t priority, StackType_t *stack, StaticTask_t *tcb,
+                                           BaseType_t core) {
+    struct HostTask *t = calloc(1, sizeof(*t));
+    if (!t || !(t->stack = malloc(SIM_STACK))) {
+        free(t);
+        return NULL;
+    }
+    memset(t->stack, STACK_PAINT, SIM_STACK);
+    t->fn = fn;
+    t->arg = arg;
+    t->name = name;
+    t->priority = priority;
+    t->stack_bytes = stack_bytes;
+    getcontext(&t->ctx);
+    t->ctx.uc_stack.ss_sp = t->stack;
+    t->ctx.uc_stack.ss_size = SIM_STACK;
+    t->ctx.uc_link = NULL;
+    makecontext(&t->ctx, trampoline, 0);
+    makeReady(t);
+    t->next = tasks;
+    tasks = t;
+    if (tcb) tcb->task = t;
+    return t;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_bytes, void *arg, UBaseType_t priority,
+                       TaskHandle_t *out) {
+    TaskHandle_t t = xTaskCreateStaticPinnedToCore(fn, name, stack_bytes, arg, priority, NULL, NULL, tskNO_AFFINITY);
+    if (out) *out = t;
+    return t ? pdPASS : pdFAIL;
+}
+
+void hostTaskExternal(TaskHandle_t task) {
+    task->external = true;
+}
+
+/* Back to the scheduler until made ready again */
+static void suspend(void) {
+    struct HostTask *t = current;
+    swapcontext(&t->ctx, &sched_ctx);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    struct HostTask *t = task ? task : current;
+    t->state = TASK_DELETED;
+    if (t == current) suspend();
+}
+
+/* Block the current task on obj until the deadline; false on timeout */
+static bool block(const void *obj, int64_t deadline) {
+    current->state = TASK_BLOCKED;
+    current->waiting_on = obj;
+    current->wake_at = deadline;
+    current->timed_out = false;
+    suspend();
+    return !current->timed_out;
+}
+
+/* Timeouts end on a tick, as FreeRTOS counts them */
+static int64_t deadlineOf(TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return NEVER;
+    return (esp_timer_get_time() / TICK_US + ticks) * TICK_US;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (!current) {
+        simStall(deadlineOf(ticks) - esp_timer_get_time());
+        return;
+    }
+    block(NULL, deadlineOf(ticks));
+}
+
+void simWait(int64_t us) {
+    int64_t until = esp_timer_get_time() + us;
+    if (until > awake_until) awake_until = until;
+    if (!current) {
+        simStall(us);
+        return;
+    }
+    block(NULL, until);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(esp_timer_get_time() / TICK_US);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return current;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    struct HostTask *t = task ? task : current;
+    size_t untouched = 0;
+    while (untouched < SIM_STACK && t->stack[untouched] == STACK_PAINT) untouched++;
+    size_t used = SIM_STACK - untouched;
+    return used < t->stack_bytes ? t->stack_bytes - used : 0;
+}
+
+/* Queues and semaphores: every task blocked on one is woken by any change
+ * and tries again */
+
+static void wakeWaiters(const void *obj) {
+    for (struct HostTask *t = tasks; t; t = t->next)
+        if (t->state == TASK_BLOCKED && t->waiting_on == obj) makeReady(t);
+}
+
+/* A poll that found nothing: it takes CPU time, so a task spinning on one
+ * still sees the clock move, and other ready tasks of its priority run */
+static void pollFailed(void) {
+    simStall(HOST_POLL_US);
+    if (current) {
+        makeReady(current);
+        suspend();
+    }
+}
+
+/* Wait for obj to change, false once the deadline passed */
+static bool waitOn(const void *obj, int64_t deadline) {
+    if (deadline <= esp_timer_get_time()) return false;
+    if (!current) {
+        if (deadline == NEVER) {
+            printf("host: would block forever outside a task\n");
+            abort();
+        }
+        simStall(deadline - esp_timer_get_time());
+        fireTimers();
+        return true;
+    }
+    block(obj, deadline);
+    return true;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t *storage, StaticQueue_t *buf) {
+    memset(buf, 0, sizeof(*buf));
+    buf->storage = storage;
+    buf->length = length;
+    buf->item_size = item_size;
+    return buf;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+    int64_t deadline = deadlineOf(wait);
+    while (q->count == q->length) {
+        if (!wait) pollFailed();
+        if (!wait || !waitOn(q, deadline)) return errQUEUE_FULL;
+    }
+    if (q->item_size && item)       // semaphores give with no item
+        memcpy(q->storage + ((q->head + q->count) % q->length) * q->item_size, item, q->item_size);
+    q->count++;
+    wakeWaiters(q);
+    return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken) {
+    if (woken) *woken = pdFALSE;
+    return xQueueSend(q, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+    int64_t deadline = deadlineOf(wait);
+    while (q->count == 0) {
+        if (!wait) pollFailed();
+        if (!wait || !waitOn(q, deadline)) return pdFALSE;
+    }
+    if (q->item_size) memcpy(item, q->storage + q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    wakeWaiters(q);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    return q->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buf) {
+    xQueueCreateStatic(1, 0, NULL, buf);
+    buf->count = 1;
+    return buf;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buf) {
+    return xQueueCreateStatic(1, 0, NULL, buf);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) {
+    return xQueueReceive(s, NULL, wait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    return xQueueSend(s, NULL, 0);
+}
+
+/* Power management */
+
+esp_err_t esp_pm_configure(const void *config) {
+    light_sleep = ((const esp_pm_config_t *)config)->light_sleep_enable;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char *name, esp_pm_lock_handle_t *out) {
+    static int dummy;
+    *out = (esp_pm_lock_handle_t)&dummy;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t lock) {
+    pm_locks++;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t lock) {
+    if (!pm_locks) return ESP_ERR_INVALID_STATE;
+    pm_locks--;
+    return ESP_OK;
+}
+
+void hostPowerGet(HostPower_t *out) {
+    *out = power;
+}
+
+/* Scheduler */
+
+static struct HostTask *pickReady(void) {
+    struct HostTask *best = NULL;
+    for (struct HostTask *t = tasks; t; t = t->next)
+        if (t->state == TASK_READY &&
+            (!best || t->priority > best->priority || (t->priority == best->priority && t->ready_seq < best->ready_seq)))
+            best = t;
+    return best;
+}
+
+/* Next deadline of a task or timer; the tickless idle only knows of the
+ * ones that are not external */
+static int64_t nextEvent(bool known) {
+    int64_t next = NEVER;
+    for (struct HostTask *t = tasks; t; t = t->next)
+        if (t->state == TASK_BLOCKED && t->wake_at < next && !(known && t->external)) next = t->wake_at;
+    for (struct esp_timer *t = timers; t; t = t->next)
+        if (t->active && t->due < next) next = t->due;
+    return next;
+}
+
+static void wakeTimedOut(void) {
+    int64_t now = esp_timer_get_time();
+    for (struct HostTask *t = tasks; t; t = t->next)
+        if (t->state == TASK_BLOCKED && t->wake_at <= now) {
+            makeReady(t);
+            t->timed_out = true;
+        }
+}
+
+static void reap(void) {
+    for (struct HostTask **p = &tasks; *p; ) {
+        struct HostTask *t = *p;
+        if (t->state == TASK_DELETED && t != current) {
+            *p = t->next;
+            free(t->stack);
+            free(t);
+        } else {
+            p = &t->next;
+        }
+    }
+}
+
+/* All tasks blocked: move the clock to next, asleep if allowed */
+static void idle(int64_t next) {
+    int64_t now = esp_timer_get_time();
+    int64_t from = awake_until > now ? (awake_until < next ? awake_until : next) : now;
+    int64_t expected = nextEvent(true);
+
+    if (light_sleep && !pm_locks && next > from && expected - from >= HOST_SLEEP_MIN_TICKS * TICK_US) {
+        power.sleep_us += next - from;
+        power.idle_us += from - now;
+        sleeping = true;
+    } else {
+        power.idle_us += next - now;
+    }
+    now_us = next;
+    if (count_cpu) cpu_mark = monotonicUs();
+}
+
+static void schedule(int64_t until, const volatile bool *stop) {
+    if (current) {
+        printf("host: the simulator cannot be run from a task\n");
+        abort();
+    }
+    while (!(stop && *stop)) {
+        fireTimers();
+        wakeTimedOut();
+        struct HostTask *t = pickReady();
+        if (t) {
+            wake();
+            current = t;
+            swapcontext(&sched_ctx, &t->ctx);
+            current = NULL;
+            reap();
+            continue;
+        }
+        int64_t now = esp_timer_get_time();
+        if (now >= until) return;
+        int64_t next = nextEvent(false);
+        if (next == NEVER && until == NEVER) {
+            printf("host: every task blocked forever\n");
+            abort();
+        }
+        idle(next < until ? next : until);
+    }
+}
+
+void hostRun(int64_t until_us) {
+    schedule(until_us, NULL);
+}
+
+void hostRunFor(int64_t us) {
+    schedule(esp_timer_get_time() + us, NULL);
+}
+
+static volatile bool main_done;
+
+static void mainTask(void *arg) {
+    ((void (*)(void))arg)();
+    main_done = true;
+}
+
+void hostRunMain(void (*fn)(void)) {
+    main_done = false;
+    xTaskCreate(mainTask, "main", 3584, (void *)fn, 1, NULL);
+    schedule(NEVER, &main_done);
+}
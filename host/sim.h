@@ -0,0 +1,18 @@
+/*
+ *  Between the host simulator's parts: how a shim takes time.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_system.h"
+
+/* The CPU is busy for us: the clock moves, no task runs */
+void simStall(int64_t us);
+/* Hardware is busy for us: the calling task blocks, others run, the chip
+ * stays awake */
+void simWait(int64_t us);
+
+/* Rising edges on output pins so far, to tell CS windows apart */
+uint32_t simGpioEdges(void);
+
+extern esp_reset_reason_t sim_reset_reason;
@@ -0,0 +1,91 @@
+/*
+ *  SPI master shim: transactions take their wire time and are logged.
+ *  See host.h.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "driver/spi_master.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sim.h"
+
+#define SPI_MAX_DEVICES 3
+
+struct spi_device_t {
+    spi_host_device_t host;
+    int clock_hz;
+};
+
+static struct spi_device_t devices[SPI_MAX_DEVICES];
+static int ndevices;
+static bool bus_ready[3];
+static int bus_max[3];
+
+static HostSpiTrans_t *log_buf;
+static size_t log_len, log_cap;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus, int dma) {
+    if (host < SPI2_HOST || host > SPI3_HOST) return ESP_ERR_INVALID_ARG;
+    if (bus_ready[host]) return ESP_ERR_INVALID_STATE;
+    bus_ready[host] = true;
+    bus_max[host] = bus->max_transfer_sz ? bus->max_transfer_sz : 4092;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev, spi_device_handle_t *out) {
+    if (host < SPI2_HOST || host > SPI3_HOST || !bus_ready[host] || dev->clock_speed_hz <= 0) return ESP_ERR_INVALID_ARG;
+    if (ndevices == SPI_MAX_DEVICES) return ESP_ERR_NOT_FOUND;
+    devices[ndevices] = (struct spi_device_t){ .host = host, .clock_hz = dev->clock_speed_hz };
+    *out = &devices[ndevices++];
+    return ESP_OK;
+}
+
+/* Log it and return how long it takes */
+static int64_t transaction(spi_device_handle_t dev, const spi_transaction_t *t, uint32_t *ns) {
+    size_t bytes = (t->length + 7) / 8;
+    if (!dev || !t->tx_buffer || bytes > (size_t)bus_max[dev->host]) return -1;
+
+    *ns = HOST_SPI_TRANS_NS + (uint32_t)((uint64_t)t->length * 1000000000 / dev->clock_hz);
+    if (log_len == log_cap) {
+        size_t cap = log_cap ? log_cap * 2 : 1024;
+        HostSpiTrans_t *p = realloc(log_buf, cap * sizeof(*p));
+        if (!p) abort();
+        log_buf = p;
+        log_cap = cap;
+    }
+    log_buf[log_len++] = (HostSpiTrans_t){
+        .start_us = esp_timer_get_time(),
+        .duration_ns = *ns,
+        .bytes = bytes,
+        .window = simGpioEdges(),
+        .first = ((const uint8_t *)t->tx_buffer)[0],
+    };
+    return (*ns + 999) / 1000;
+}
+
+/* Queued with DMA: the task sleeps on the result */
+esp_err_t spi_device_transmit(spi_device_handle_t dev, spi_transaction_t *t) {
+    uint32_t ns;
+    int64_t us = transaction(dev, t, &ns);
+    if (us < 0) return ESP_ERR_INVALID_ARG;
+    simWait(us);
+    return ESP_OK;
+}
+
+/* The CPU spins on the result */
+esp_err_t spi_device_polling_transmit(spi_device_handle_t dev, spi_transaction_t *t) {
+    uint32_t ns;
+    int64_t us = transaction(dev, t, &ns);
+    if (us < 0) return ESP_ERR_INVALID_ARG;
+    simStall(us);
+    return ESP_OK;
+}
+
+size_t hostSpiLog(const HostSpiTrans_t **out) {
+    *out = log_buf;
+    return log_len;
+}
+
+void hostSpiClear(void) {
+    log_len = 0;
+}
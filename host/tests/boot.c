@@ -0,0 +1,117 @@
+/*
+ *  Boot to usable (resume.h), on the simulator's timing model, for the
+ *  three ways the firmware can come up:
+ *
+ *    cold   nothing saved: the panel is cleared after its power-up delay
+ *    flash  power cycled after an edit: the packed frame comes back from
+ *           NVS and goes up in one refresh, before the document loads
+ *    warm   software reset: the panel kept its image; only the cursor's
+ *           row goes out
+ *
+ *  Each boot runs in a process of its own, the flash and warm ones from
+ *  the state the cold one saved after typing (hostSaveState()). "Picture"
+ *  is the first transfer to the panel, "usable" when app_main() hands over
+ *  to the key task.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sharp.h"
+#include "resume.h"
+#include "check.h"
+#include "typist.h"
+
+/* Panel power-up delay before the first transfer of a cold boot */
+#define PANEL_POWERUP_US (100 * 1000)
+/* Budgets, with room over the model's figures */
+#define COLD_USABLE_US (250 * 1000)
+#define FLASH_PICTURE_US (200 * 1000)
+#define FLASH_USABLE_US (300 * 1000)
+#define WARM_USABLE_US (150 * 1000)
+
+void app_main(void);
+
+static char state[64];
+
+/* The cursor's text row, command and trailer bytes included */
+#define ROW_BYTES (PSF_GLYPH_SIZE * (BYTES_PER_LINE + 2) + 2)
+
+/* First transfer to the panel, -1 if none */
+static int64_t firstPicture(void) {
+    const HostSpiTrans_t *log;
+    return hostSpiLog(&log) ? log[0].start_us : -1;
+}
+
+static uint32_t panelBytes(void) {
+    const HostSpiTrans_t *log;
+    uint32_t bytes = 0;
+    for (size_t i = 0, n = hostSpiLog(&log); i < n; i++) bytes += log[i].bytes;
+    return bytes;
+}
+
+static int64_t boot(const char *name, int64_t *picture) {
+    hostSpiClear();
+    hostRunMain(app_main);
+    int64_t usable = esp_timer_get_time();
+    *picture = firstPicture();
+    printf("%s boot: picture at %lld us, usable at %lld us\n", name, (long long)*picture, (long long)usable);
+    return usable;
+}
+
+static int coldBoot(void) {
+    int64_t picture, usable = boot("cold", &picture);
+    CHECK(picture >= PANEL_POWERUP_US, "panel written %lld us into its power-up", (long long)picture);
+    CHECK(usable <= COLD_USABLE_US, "usable at %lld us", (long long)usable);
+
+    // An edit, then idle long enough for the save and the snapshot
+    hostRunFor(1000 * 1000);
+    typistText(0, 120, "iResume me.\033");
+    typistStart();
+    while (!typistDone()) hostRunFor(100 * 1000);
+    hostRunFor((RESUME_IDLE_MS + 3000) * 1000LL);
+    CHECK(hostSaveState(state), "cannot save %s", state);
+    return checkDone();
+}
+
+static int flashBoot(void) {
+    int64_t picture;
+    CHECK(hostLoadState(state, ESP_RST_POWERON), "cannot load %s", state);
+    int64_t usable = boot("flash", &picture);
+    CHECK(picture >= PANEL_POWERUP_US, "panel written %lld us into its power-up", (long long)picture);
+    CHECK(picture <= FLASH_PICTURE_US, "picture at %lld us", (long long)picture);
+    CHECK(panelBytes() >= PXHEIGHT * (BYTES_PER_LINE + 2), "%u bytes sent, no full refresh", (unsigned)panelBytes());
+    CHECK(usable <= FLASH_USABLE_US, "usable at %lld us", (long long)usable);
+    return checkDone();
+}
+
+static int warmBoot(void) {
+    int64_t picture;
+    CHECK(hostLoadState(state, ESP_RST_SW), "cannot load %s", state);
+    int64_t usable = boot("warm", &picture);
+    uint32_t bytes = panelBytes();
+    CHECK(bytes <= ROW_BYTES, "%u bytes sent at %lld us, the panel still shows the frame", (unsigned)bytes,
+          (long long)picture);
+    CHECK(usable <= WARM_USABLE_US, "usable at %lld us", (long long)usable);
+    return checkDone();
+}
+
+/* A fresh process per boot, as a reset would give */
+static bool run(int (*fn)(void)) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) exit(fn());
+    int status;
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(void) {
+    snprintf(state, sizeof(state), "/tmp/tw_boot_%d.state", (int)getpid());
+    bool ok = run(coldBoot) && run(flashBoot) && run(warmBoot);
+    unlink(state);
+    printf("%s\n", ok ? "all boots ok" : "FAIL");
+    return !ok;
+}
@@ -0,0 +1,25 @@
+/*
+ *  Minimal checks for the host tests: a failed CHECK prints where and why
+ *  and the test goes on; checkDone() gives the exit code.
+ */
+#pragma once
+
+#include <stdio.h>
+
+static int check_failures;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) {                                                  \
+            printf("FAIL %s:%d: %s: ", __FILE__, __LINE__, #cond);      \
+            printf(__VA_ARGS__);                                        \
+            printf("\n");                                               \
+            check_failures++;                                           \
+        }                                                               \
+    } while (0)
+
+static inline int checkDone(void) {
+    if (check_failures) printf("%d check(s) failed\n", check_failures);
+    else printf("ok\n");
+    fflush(stdout);
+    return check_failures != 0;
+}
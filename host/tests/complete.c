@@ -0,0 +1,182 @@
+/*
+ *  Word completion (complete.h, editor.h) with the dictionaries built from
+ *  host/data:
+ *
+ *    test_complete dict.bin
+ *
+ *  Typed words must come most typed first, a word typed more overtaking
+ *  the ones before it; a full trie must keep offering what it holds and
+ *  still count words it has; a typed word the dictionary also offers must
+ *  come once; a capitalized prefix must get the dictionary's lowercase
+ *  words capitalized, accented capitals included. A document loaded at
+ *  boot must be counted by editorBackground() slices, its misspelled
+ *  words left out.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "host.h"
+#include "editor.h"
+#include "console.h"
+#include "complete.h"
+#include "spell.h"
+#include "mem.h"
+#include "check.h"
+
+#define DOC_SIZE (64 * 1024)
+
+void app_main(void);
+
+static MemArena_t arena;
+static Editor_t editor;
+static Cursor_t cursor;
+
+static void add(Complete_t *c, const char *word, int times) {
+    while (times-- > 0) completeAdd(c, (const uint8_t *)word, strlen(word));
+}
+
+static size_t lookup(const Complete_t *c, const char *prefix, Completion_t *out, size_t max) {
+    return completeLookup(c, (const uint8_t *)prefix, strlen(prefix), out, max);
+}
+
+static bool is(const Completion_t *w, const char *text) {
+    return w->len == strlen(text) && memcmp(w->text, text, w->len) == 0;
+}
+
+/* Prefixes no English word starts with, so only typed words come back */
+static void ranking(void) {
+    Complete_t c;
+    Completion_t out[COMPLETE_TOP];
+    size_t mark = memArenaMark(&arena);
+    completeInit(&c, &arena, 256);
+
+    add(&c, "qzab", 1);
+    add(&c, "qzac", 3);
+    add(&c, "qzad", 2);
+    size_t n = lookup(&c, "qz", out, COMPLETE_TOP);
+    CHECK(n == 3 && is(&out[0], "qzac") && is(&out[1], "qzad") && is(&out[2], "qzab"), "most typed first");
+
+    add(&c, "qzab", 3);         // 4 now: from last to first
+    n = lookup(&c, "qza", out, COMPLETE_TOP);
+    CHECK(n == 3 && is(&out[0], "qzab") && is(&out[1], "qzac") && is(&out[2], "qzad"), "qzab did not overtake");
+
+    // Five words for four places: one typed once stays out
+    add(&c, "qzae", 5);
+    add(&c, "qzaf", 1);
+    n = lookup(&c, "qz", out, COMPLETE_TOP);
+    CHECK(n == COMPLETE_TOP && is(&out[0], "qzae") && is(&out[1], "qzab") && is(&out[3], "qzad"),
+          "top four of five");
+    // The prefix itself typed is not offered for itself
+    add(&c, "qza", 9);
+    n = lookup(&c, "qza", out, COMPLETE_TOP);
+    CHECK(n >= 1 && !is(&out[0], "qza"), "a prefix offered as its own completion");
+    CHECK(lookup(&c, "qzx", out, COMPLETE_TOP) == 0 && lookup(&c, "", out, COMPLETE_TOP) == 0, "offers for nothing");
+    memArenaRelease(&arena, mark);
+}
+
+static void full(void) {
+    Complete_t c;
+    Completion_t out[COMPLETE_TOP];
+    size_t mark = memArenaMark(&arena);
+    completeInit(&c, &arena, 12);
+
+    add(&c, "qzab", 1);         // the root and 4 nodes
+    add(&c, "qzcd", 1);         // 2 more
+    add(&c, "qzefgh", 1);       // 4 more: 11
+    add(&c, "qzijkl", 5);       // no room past qzi
+    CHECK(c.used <= c.size, "%u nodes of %u", c.used, c.size);
+    size_t n = lookup(&c, "qz", out, COMPLETE_TOP);
+    CHECK(n == 3 && !is(&out[0], "qzijkl"), "%zu offered from a full trie", n);
+    add(&c, "qzcd", 2);         // known words still count
+    n = lookup(&c, "qz", out, COMPLETE_TOP);
+    CHECK(n == 3 && is(&out[0], "qzcd"), "a full trie stopped counting");
+    memArenaRelease(&arena, mark);
+}
+
+static void dictionary(void) {
+    Complete_t c;
+    Completion_t out[COMPLETE_SHOW];
+    SpellWord_t words[SPELL_COMPLETE_TOP];
+    size_t mark = memArenaMark(&arena);
+    completeInit(&c, &arena, 256);
+
+    // "that" comes from both: typed first, and once
+    spellSetLanguage("en");
+    size_t m = spellComplete((const uint8_t *)"th", 2, words, SPELL_COMPLETE_TOP);
+    add(&c, "that", 2);
+    size_t n = lookup(&c, "th", out, COMPLETE_SHOW);
+    int seen = 0;
+    for (size_t i = 0; i < n; i++) seen += is(&out[i], "that");
+    CHECK(m > 1 && n == COMPLETE_SHOW && is(&out[0], "that") && seen == 1, "\"that\" offered %d times", seen);
+
+    // Capitals: "Th" offers the dictionary's "th" words as The, That...
+    n = lookup(&c, "Th", out, COMPLETE_SHOW);
+    bool same = n == (m < COMPLETE_SHOW ? m : COMPLETE_SHOW);
+    for (size_t i = 0; same && i < n; i++)
+        same = out[i].len == words[i].len && out[i].text[0] == 'T' &&
+               memcmp(out[i].text + 1, words[i].text + 1, words[i].len - 1) == 0;
+    CHECK(same, "\"Th\": %zu offered, first \"%.*s\"", n, n ? out[0].len : 0, n ? (const char *)out[0].text : "");
+
+    // A two-byte capital keeps its own bytes: "É" offers "Él"
+    spellSetLanguage("es");
+    n = lookup(&c, "É", out, COMPLETE_SHOW);
+    seen = 0;
+    for (size_t i = 0; i < n; i++) seen += is(&out[i], "Él");
+    CHECK(seen == 1, "\"É\" does not offer \"Él\"");
+    spellSetLanguage("en");
+    memArenaRelease(&arena, mark);
+}
+
+/* "sentence" is far down the dictionary's "s" words: offered first only
+ * once the loaded document has been counted */
+static void seeding(void *arg) {
+    static const char line[] = "A sentence, then another sentence and a sentence more.\n";
+    Completion_t out[COMPLETE_SHOW];
+
+    docClear(&editor.doc);
+    docInsert(&editor.doc, 0, (const uint8_t *)line, sizeof(line) - 1, 400);
+    size_t n = lookup(&editor.complete, "s", out, COMPLETE_SHOW);
+    CHECK(!n || !is(&out[0], "sentence"), "\"sentence\" offered before counting");
+
+    editorRestore(&editor, 0, 0);
+    CHECK(editorBusy(&editor) && editorSeeding(&editor), "a loaded document is not counted");
+    int slices = 0;
+    while (editorBusy(&editor)) {
+        editorBackground(&editor);
+        slices++;
+    }
+    size_t expect = (docLength(&editor.doc) + EDITOR_SEED_SLICE - 1) / EDITOR_SEED_SLICE;
+    CHECK(slices >= (int)expect - 1 && slices <= (int)expect + 1, "%d slices for %zu bytes", slices,
+          docLength(&editor.doc));
+    n = lookup(&editor.complete, "s", out, COMPLETE_SHOW);
+    CHECK(n && is(&out[0], "sentence"), "\"sentence\" not offered first after counting");
+    // Not in the word list, so taken for misspelled and not counted
+    CHECK(lookup(&editor.complete, "ano", out, COMPLETE_SHOW) == 0, "\"another\" counted");
+}
+
+static void completeMain(void) {
+    size_t mark = memArenaMark(&doc_arena);
+    if (!memArenaInit(&arena, "complete test", 64 * 1024, MEM_PSRAM) ||
+        !editorInit(&editor, &cursor, &doc_arena, DOC_SIZE)) {
+        CHECK(false, "no memory");
+        return;
+    }
+    CHECK(spellSetLanguage("en") && spellSetLanguage("es"), "no en or es dictionary");
+    ranking();
+    full();
+    dictionary();
+    keyTaskCall(seeding, NULL);
+    memArenaRelease(&doc_arena, mark);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        printf("usage: %s dict.bin\n", argv[0]);
+        return 2;
+    }
+    if (!hostPartitionLoad("dict", argv[1])) return 2;
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    hostRunMain(completeMain);
+    return checkDone();
+}
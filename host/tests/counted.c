@@ -0,0 +1,152 @@
+/*
+ *  Counted commands (editor.h) against the same work typed a step at a
+ *  time, each step redrawn and flushed as the key task would. Both must
+ *  leave the same text, and but for a put the same point; the counted
+ *  command must take a single redraw of at most one screen. Both times
+ *  are reported, not checked. Counts whose product overflows 32 bits must
+ *  fail with "document full" or clamp, never wrap.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sharp.h"
+#include "render.h"
+#include "keymap.h"
+#include "keyboard_input.h"
+#include "editor.h"
+#include "console.h"
+#include "stats.h"
+#include "mem.h"
+#include "check.h"
+
+#define LINES 400
+#define DOC_SIZE (128 * 1024)
+#define BIG_LINES 1200          /* about 50 KB, yanked whole for a large paste */
+
+void app_main(void);
+
+typedef struct {
+    const char *setup;      /* from NORMAL mode */
+    const char *counted;
+    const char *step;
+    uint8_t steps;
+    bool same_point;        /* 3p stays on the first line put, p moves on */
+} Case_t;
+
+static const Case_t cases[] = {
+    { "1G", "10dd", "dd", 10, true },
+    { "1G", "5w", "w", 5, true },
+    { "1Gyy", "3p", "p", 3, false },
+    { "1G", "20j", "j", 20, true },
+    { "5G", "6x", "x", 6, true },
+    { "7G", "4dw", "dw", 4, true },
+};
+
+typedef struct {
+    int64_t us;
+    uint32_t lines;         /* scanlines sent */
+    size_t point;
+    size_t length;
+    uint8_t *text;
+} Result_t;
+
+static Editor_t editor;
+static Cursor_t cursor;
+static Result_t results[2];
+
+static void feed(const char *keys) {
+    KeyInput_t in;
+    for (; *keys; keys++) {
+        keymapFromVk(*keys == '\033' ? VK_ESC : *keys - ' ' + VKCHAROFFSET, &in);
+        editorKey(&editor, &in);
+    }
+}
+
+static void fill(int lines) {
+    char line[48];
+    docClear(&editor.doc);
+    for (int i = 0; i < lines; i++) {
+        int n = snprintf(line, sizeof(line), "line %03d: the quick brown fox jumps\n", i);
+        docInsert(&editor.doc, docLength(&editor.doc), (const uint8_t *)line, n, 1);
+    }
+    editor.point = editor.top = 0;
+    feed("\033");
+}
+
+static void reset(const char *setup) {
+    fill(LINES);
+    feed(setup);
+    editorRedraw(&editor);
+    renderFlush();
+}
+
+static void run(const char *keys, uint8_t times, Result_t *r) {
+    uint32_t sent = display_stats.lines_sent;
+    int64_t t0 = esp_timer_get_time();
+    for (uint8_t i = 0; i < times; i++) {
+        feed(keys);
+        editorRedraw(&editor);
+        renderFlush();
+    }
+    r->us = esp_timer_get_time() - t0;
+    r->lines = display_stats.lines_sent - sent;
+    r->point = editor.point;
+    r->length = docLength(&editor.doc);
+    free(r->text);
+    r->text = malloc(r->length + 1);
+    docCopy(&editor.doc, 0, r->length, r->text);
+}
+
+static void compare(void *arg) {
+    const Case_t *c = arg;
+    reset(c->setup);
+    run(c->counted, 1, &results[0]);
+    reset(c->setup);
+    run(c->step, c->steps, &results[1]);
+}
+
+/* 99999 x 50 KB is past 32 bits: the paste must find no room */
+static void overflow(void *arg) {
+    fill(BIG_LINES);
+    size_t length = docLength(&editor.doc);
+    feed("1GyG99999p");
+    CHECK(docLength(&editor.doc) == length, "99999p of %zu bytes: %zu bytes after", length, docLength(&editor.doc));
+
+    // 65536 x 65536 is 0 in 32 bits; clamped, it deletes every word
+    fill(BIG_LINES);
+    feed("1G65536d65536w");
+    CHECK(docLength(&editor.doc) < 16, "65536d65536w left %zu bytes", docLength(&editor.doc));
+}
+
+static void countedMain(void) {
+    size_t mark = memArenaMark(&doc_arena);
+    if (!editorInit(&editor, &cursor, &doc_arena, DOC_SIZE)) {
+        CHECK(false, "no memory for the editor");
+        return;
+    }
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const Case_t *c = &cases[i];
+        const Result_t *counted = &results[0], *replay = &results[1];
+        keyTaskCall(compare, (void *)c);
+        printf("{\"cmd\":\"%s\",\"us\":%lld,\"replay_us\":%lld,\"lines\":%u,\"replay_lines\":%u}\n", c->counted,
+               (long long)counted->us, (long long)replay->us, (unsigned)counted->lines, (unsigned)replay->lines);
+
+        CHECK(counted->length == replay->length && memcmp(counted->text, replay->text, counted->length) == 0,
+              "%s: text differs from %u x %s", c->counted, c->steps, c->step);
+        CHECK(!c->same_point || counted->point == replay->point, "%s: point %zu, %zu after the replay", c->counted, counted->point,
+              replay->point);
+        CHECK(counted->lines <= PXHEIGHT, "%s: %u lines sent", c->counted, (unsigned)counted->lines);
+    }
+    keyTaskCall(overflow, NULL);
+    memArenaRelease(&doc_arena, mark);
+}
+
+int main(void) {
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    hostRunMain(countedMain);
+    return checkDone();
+}
@@ -0,0 +1,125 @@
+/*
+ *  Framebuffer kernels (fbops.h) against plain byte loops: the same bytes
+ *  and line masks for aligned and unaligned buffers of every length up to
+ *  a few words, and for full frames that differ in one byte per changed
+ *  line. Both are timed on full frames and reported, not checked: the
+ *  times are of this machine's CPU and build (at -O2 GCC vectorizes the
+ *  byte loops too). The PIE path only builds for the S3.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "fbops.h"
+#include "check.h"
+
+#define FRAME (PXWIDTH * PXHEIGHT / 8)
+#define REPS 256
+
+static uint8_t a[FRAME + FBOPS_ALIGN] __attribute__((aligned(FBOPS_ALIGN)));
+static uint8_t b[FRAME + FBOPS_ALIGN] __attribute__((aligned(FBOPS_ALIGN)));
+static uint8_t ref[FRAME + FBOPS_ALIGN] __attribute__((aligned(FBOPS_ALIGN)));
+
+static void fill(uint8_t *p, size_t n, uint32_t seed) {
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        p[i] = seed >> 16;
+    }
+}
+
+static void byteInvert(uint8_t *dst, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] = ~dst[i];
+}
+
+static void byteXor(uint8_t *dst, const uint8_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] ^= src[i];
+}
+
+static void byteDiffLines(const uint8_t *x, const uint8_t *y, LineMask_t out) {
+    memset(out, 0, sizeof(LineMask_t));
+    for (uint16_t line = 0; line < PXHEIGHT; line++)
+        for (int i = 0; i < BYTES_PER_LINE; i++)
+            if (x[line * BYTES_PER_LINE + i] != y[line * BYTES_PER_LINE + i]) {
+                LINEMASK_SET(out, line);
+                break;
+            }
+}
+
+/* Every offset and length: the head and tail bytes around the words */
+static void lengths(void) {
+    for (size_t off = 0; off < FBOPS_ALIGN; off++)
+        for (size_t n = 0; n <= 4 * FBOPS_ALIGN; n++) {
+            fill(a, sizeof(a), off * 1000 + n);
+            fill(b, sizeof(b), off * 7 + n);
+            memcpy(ref, a, sizeof(ref));
+            fbInvert(a + off, n);
+            byteInvert(ref + off, n);
+            CHECK(memcmp(a, ref, sizeof(a)) == 0, "invert at +%zu, %zu bytes", off, n);
+            fbXor(a + off, b + (off * 3 & (FBOPS_ALIGN - 1)), n);
+            byteXor(ref + off, b + (off * 3 & (FBOPS_ALIGN - 1)), n);
+            CHECK(memcmp(a, ref, sizeof(a)) == 0, "xor at +%zu, %zu bytes", off, n);
+        }
+}
+
+/* Frames differing in one byte on some lines, at either end of the line or
+ * inside it, and lines compared at unaligned addresses */
+static void lines(void) {
+    LineMask_t got, want;
+    for (int round = 0; round < 16; round++) {
+        fill(a, FRAME, round);
+        memcpy(b, a, FRAME);
+        for (uint16_t y = round; y < PXHEIGHT; y += 7 + round)
+            b[y * BYTES_PER_LINE + (y * 13 + round) % BYTES_PER_LINE] ^= 1 << (y & 7);
+        fbDiffLines(a, b, got);
+        byteDiffLines(a, b, want);
+        CHECK(memcmp(got, want, sizeof(got)) == 0, "diff lines, round %d", round);
+        for (uint16_t y = 0; y < PXHEIGHT; y++) {
+            bool equal = !LINEMASK_TEST(want, y);
+            CHECK(fbLineEqual(a + y * BYTES_PER_LINE, b + y * BYTES_PER_LINE) == equal, "line %u, round %d",
+                  y, round);
+        }
+    }
+    memcpy(b + 1, a, BYTES_PER_LINE);
+    CHECK(fbLineEqual(a, b + 1), "unaligned equal line");
+    b[1 + BYTES_PER_LINE - 1] ^= 0x80;
+    CHECK(!fbLineEqual(a, b + 1), "unaligned line differing in its last byte");
+}
+
+typedef enum { K_INVERT, K_XOR, K_DIFF } Kernel;
+
+static int64_t timed(Kernel k, bool bytes) {
+    LineMask_t mask;
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < REPS; i++) {
+        if (k == K_INVERT) bytes ? byteInvert(a, FRAME) : fbInvert(a, FRAME);
+        else if (k == K_XOR) bytes ? byteXor(a, b, FRAME) : fbXor(a, b, FRAME);
+        else bytes ? byteDiffLines(a, b, mask) : fbDiffLines(a, b, mask);
+    }
+    return esp_timer_get_time() - t0;
+}
+
+static void speed(void) {
+    static const char *const names[] = { "invert", "xor", "diff" };
+    fill(a, FRAME, 1);
+    memcpy(b, a, FRAME);        // equal frames: diff compares every byte
+    hostClockCountCpu(true);
+    for (Kernel k = K_INVERT; k <= K_DIFF; k++) {
+        int64_t byte_us = timed(k, true), us = timed(k, false);
+        printf("{\"bench\":\"fbops\",\"kernel\":\"%s\",\"iters\":%d,\"us\":%lld,\"byte_us\":%lld}\n", names[k], REPS,
+               (long long)us, (long long)byte_us);
+    }
+    hostClockCountCpu(false);
+}
+
+static void fbopsMain(void) {
+    lengths();
+    lines();
+    speed();
+}
+
+int main(void) {
+    hostRunMain(fbopsMain);
+    return checkDone();
+}
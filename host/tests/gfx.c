@@ -0,0 +1,127 @@
+/*
+ *  Drawing primitives (gfx.h) against the same pixels drawn one at a time
+ *  with setPixel(): every primitive must leave the framebuffer as the
+ *  per-pixel loop does and mark just the lines it touched for the next
+ *  flush. Both are timed and the speedup reported, not checked: it is of
+ *  this machine's CPU (hostClockCountCpu()) and the build's optimization.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sharp.h"
+#include "render.h"
+#include "gfx.h"
+#include "check.h"
+
+#define REPS 1000
+
+void app_main(void);
+
+typedef enum { SHAPE_HLINE, SHAPE_VLINE, SHAPE_FILL, SHAPE_OUTLINE } Shape;
+
+typedef struct {
+    const char *name;
+    Shape shape;
+    int16_t x, y, w, h;
+    GfxColor color;
+} Case_t;
+
+static const Case_t cases[] = {
+    { "hline", SHAPE_HLINE, 5, 7, 300, 1, GFX_BLACK },
+    { "vline", SHAPE_VLINE, 9, 20, 1, 200, GFX_BLACK },
+    { "vline_invert", SHAPE_VLINE, 310, 0, 1, 240, GFX_INVERT },
+    { "fill", SHAPE_FILL, 3, 5, 123, 45, GFX_BLACK },
+    { "fill_white", SHAPE_FILL, 3, 5, 123, 45, GFX_WHITE },
+    { "fill_invert", SHAPE_FILL, 3, 5, 123, 45, GFX_INVERT },
+    { "outline", SHAPE_OUTLINE, 17, 20, 200, 100, GFX_BLACK },
+    { "clipped", SHAPE_FILL, -40, 200, 120, 100, GFX_INVERT },
+};
+
+static uint8_t pattern[PXWIDTH * PXHEIGHT / 8];
+static uint8_t expected[PXWIDTH * PXHEIGHT / 8];
+
+static void pixel(int16_t x, int16_t y, GfxColor color) {
+    if (x < 0 || y < 0 || x >= PXWIDTH || y >= PXHEIGHT) return;
+    setPixel(x, y, color == GFX_INVERT ? !getPixel(x, y) : color == GFX_WHITE);
+}
+
+static void perPixel(const Case_t *c) {
+    int16_t right = c->x + c->w - 1, bottom = c->y + c->h - 1;
+    if (c->shape != SHAPE_OUTLINE) {
+        for (int16_t y = c->y; y <= bottom; y++)
+            for (int16_t x = c->x; x <= right; x++) pixel(x, y, c->color);
+        return;
+    }
+    for (int16_t x = c->x; x <= right; x++) {
+        pixel(x, c->y, c->color);
+        pixel(x, bottom, c->color);
+    }
+    for (int16_t y = c->y + 1; y < bottom; y++) {
+        pixel(c->x, y, c->color);
+        pixel(right, y, c->color);
+    }
+}
+
+static void primitive(const Case_t *c) {
+    switch (c->shape) {
+    case SHAPE_HLINE: gfxHLine(c->x, c->y, c->w, c->color); break;
+    case SHAPE_VLINE: gfxVLine(c->x, c->y, c->h, c->color); break;
+    case SHAPE_FILL: gfxFillRect(c->x, c->y, c->w, c->h, c->color); break;
+    case SHAPE_OUTLINE: gfxRect(c->x, c->y, c->w, c->h, c->color); break;
+    }
+}
+
+/* Lines a flush sends: each is framed as SHARP_LINE_FRAME bytes */
+static uint32_t flushedLines(void) {
+    const HostSpiTrans_t *log;
+    uint32_t bytes = 0;
+    hostSpiClear();
+    renderFlush();
+    for (size_t i = 0, n = hostSpiLog(&log); i < n; i++) bytes += log[i].bytes;
+    return bytes > 2 ? (bytes - 2) / SHARP_LINE_FRAME : 0;
+}
+
+/* Even reps leave the pattern as it was for invert; time both ways */
+static int64_t timed(const Case_t *c, void (*draw)(const Case_t *)) {
+    memcpy(sharpmem_buffer, pattern, sizeof(pattern));
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < REPS; i++) draw(c);
+    return esp_timer_get_time() - t0;
+}
+
+static void gfxMain(void) {
+    for (size_t i = 0; i < sizeof(pattern); i++) pattern[i] = (uint8_t)(i * 37 + (i >> 5));
+    flushedLines();
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const Case_t *c = &cases[i];
+        int16_t y0 = c->y < 0 ? 0 : c->y, y1 = c->y + c->h > PXHEIGHT ? PXHEIGHT : c->y + c->h;
+
+        memcpy(sharpmem_buffer, pattern, sizeof(pattern));
+        perPixel(c);
+        memcpy(expected, sharpmem_buffer, sizeof(expected));
+        memcpy(sharpmem_buffer, pattern, sizeof(pattern));
+        flushedLines();
+        primitive(c);
+        CHECK(memcmp(sharpmem_buffer, expected, sizeof(expected)) == 0, "%s: pixels differ from setPixel()", c->name);
+        uint32_t lines = flushedLines();
+        CHECK(lines == (uint32_t)(y1 - y0), "%s: %u lines flushed, drew on %d", c->name, (unsigned)lines, y1 - y0);
+
+        hostClockCountCpu(true);
+        int64_t pixel_us = timed(c, perPixel), prim_us = timed(c, primitive);
+        hostClockCountCpu(false);
+        memcpy(sharpmem_buffer, pattern, sizeof(pattern));
+        flushedLines();
+        printf("{\"bench\":\"gfx_%s\",\"iters\":%d,\"us\":%lld,\"setpixel_us\":%lld,\"speedup\":%.1f}\n", c->name,
+               REPS, (long long)prim_us, (long long)pixel_us, prim_us ? (double)pixel_us / prim_us : 0.0);
+    }
+}
+
+int main(void) {
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    hostRunMain(gfxMain);
+    return checkDone();
+}
@@ -0,0 +1,163 @@
+/*
+ *  Glyph store (glyphstore.h) with an image built from a synthetic font
+ *  (host/mkpsf.py, tools/mkglyphs.py):
+ *
+ *    test_glyphs glyphs.bin
+ *
+ *  Every glyph of a multilingual text must come out of the cache and onto
+ *  the panel as the image has it, and the counters must add up at each
+ *  cache size: only first uses miss once the text fits, and a smaller
+ *  cache only ever misses more. Codepoints the font lacks draw as '?'.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sharp.h"
+#include "render.h"
+#include "font.h"
+#include "glyphstore.h"
+#include "check.h"
+
+#define REPS 16
+#define GLYPH_BYTES 16
+
+void app_main(void);
+
+static const char text[] =
+    "Καλημέρα κόσμε, ξεσκεπάζω την ψυχοφθόρα βδελυγμία. "
+    "Съешь же ещё этих мягких французских булок, да выпей чаю. "
+    "Ελληνικά και русский: ΑΒΓΔΕΖΗΘ АБВГДЕЖЗ ←↑→↓ ★☆ ♠♣♥♦ ∀∃∈∑√∞ café";
+
+static const char *path;
+static uint8_t image[64 * 1024];
+static size_t image_len;
+
+static const char *utf8Next(const char *s, uint32_t *cp) {
+    uint8_t c = *s++;
+    int more = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : 0;
+    *cp = more ? c & (0x3F >> more) : c;
+    while (more-- && (*s & 0xC0) == 0x80) *cp = (*cp << 6) | (*s++ & 0x3F);
+    return s;
+}
+
+/* The bitmap the image holds for cp, NULL if none */
+static const uint8_t *imageGlyph(uint32_t cp) {
+    uint32_t count;
+    memcpy(&count, image + 8, sizeof(count));
+    const uint8_t *index = image + 16;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t at;
+        memcpy(&at, index + i * 4, sizeof(at));
+        if (at == cp) return index + count * 4 + i * GLYPH_BYTES;
+    }
+    return NULL;
+}
+
+/* Codepoints the store serves (not ASCII) in the text, and how many differ */
+static uint32_t storeCodepoints(uint32_t *distinct) {
+    uint32_t seen[256], nseen = 0, n = 0;
+    for (const char *s = text; *s; ) {
+        uint32_t cp, i;
+        s = utf8Next(s, &cp);
+        if (cp < 0x80) continue;
+        n++;
+        for (i = 0; i < nseen && seen[i] != cp; i++) {}
+        if (i == nseen && nseen < 256) seen[nseen++] = cp;
+    }
+    *distinct = nseen;
+    return n;
+}
+
+static void checkGlyphs(void) {
+    for (const char *s = text; *s; ) {
+        uint32_t cp;
+        s = utf8Next(s, &cp);
+        if (cp < 0x80) continue;
+        const uint8_t *want = imageGlyph(cp), *got = glyphStoreGet(cp);
+        CHECK(want && memcmp(got, want, GLYPH_BYTES) == 0, "U+%04X differs from the image", (unsigned)cp);
+    }
+
+    // On the panel: a glyph in cell (0, 0) is byte 0 of its 16 lines
+    const uint8_t *want = imageGlyph(0x3A9);
+    renderPutCodepoint(0, 0, 0x3A9);
+    renderExecute();
+    for (int y = 0; want && y < GLYPH_BYTES; y++)
+        CHECK(sharpmem_buffer[y * BYTES_PER_LINE] == want[y], "U+03A9 line %d drawn as %02x", y,
+              sharpmem_buffer[y * BYTES_PER_LINE]);
+
+    GlyphStoreStats_t st;
+    glyphStoreResetStats();
+    const uint8_t *missing = glyphStoreGet(0x4E2D);
+    glyphStoreGetStats(&st);
+    CHECK(st.not_found == 1 && memcmp(missing, fontGlyph('?'), GLYPH_BYTES) == 0, "U+4E2D is not drawn as '?'");
+}
+
+static void cacheSizes(void) {
+    static const uint16_t sizes[] = { 256, 128, 64, 32, 16 };
+    uint32_t distinct, per_pass = storeCodepoints(&distinct), last_misses = 0;
+    GlyphStoreStats_t st;
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        uint8_t col = 0, row = 0;
+        glyphStoreSetCacheSize(sizes[k]);
+        glyphStoreResetStats();
+        hostClockCountCpu(true);
+        int64_t t0 = esp_timer_get_time();
+        for (int i = 0; i < REPS; i++) {
+            for (const char *s = text; *s; ) {
+                uint32_t cp;
+                s = utf8Next(s, &cp);
+                renderPutCodepoint(col, row, cp);
+                if (++col == renderCols()) {
+                    col = 0;
+                    if (++row == renderRows()) row = 0;
+                }
+            }
+            renderExecute();
+        }
+        int64_t dt = esp_timer_get_time() - t0;
+        hostClockCountCpu(false);
+        glyphStoreGetStats(&st);
+        printf("{\"bench\":\"glyphs\",\"cache\":%u,\"us\":%lld,\"hits\":%u,\"misses\":%u,\"evictions\":%u}\n",
+               sizes[k], (long long)dt, (unsigned)st.hits, (unsigned)st.misses, (unsigned)st.evictions);
+
+        CHECK(st.not_found == 0, "cache %u: %u not found", sizes[k], (unsigned)st.not_found);
+        CHECK(st.hits + st.misses >= per_pass * REPS, "cache %u: %u lookups for %u glyphs", sizes[k],
+              (unsigned)(st.hits + st.misses), (unsigned)(per_pass * REPS));
+        if (sizes[k] >= distinct)
+            CHECK(st.misses == distinct && st.evictions == 0, "cache %u: %u misses, %u evictions for %u glyphs",
+                  sizes[k], (unsigned)st.misses, (unsigned)st.evictions, (unsigned)distinct);
+        else
+            CHECK(st.evictions > 0, "cache %u holds %u glyphs", sizes[k], (unsigned)distinct);
+        CHECK(st.misses >= last_misses, "cache %u: %u misses, %u with a larger one", sizes[k], (unsigned)st.misses,
+              (unsigned)last_misses);
+        last_misses = st.misses;
+    }
+    glyphStoreSetCacheSize(GLYPH_CACHE_DEFAULT);
+}
+
+static void glyphsMain(void) {
+    checkGlyphs();
+    cacheSizes();
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        printf("usage: %s glyphs.bin\n", argv[0]);
+        return 2;
+    }
+    path = argv[1];
+    FILE *f = fopen(path, "rb");
+    image_len = f ? fread(image, 1, sizeof(image), f) : 0;
+    if (f) fclose(f);
+    if (image_len < 16 || !hostPartitionLoad("glyphs", path)) {
+        printf("cannot load %s\n", path);
+        return 2;
+    }
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    hostRunMain(glyphsMain);
+    return checkDone();
+}
@@ -0,0 +1,150 @@
+/*
+ *  Search as you type (search.h, editor.h).
+ *
+ *  Engine: a query typed a character at a time and backspaced, narrowed
+ *  and widened from the kept match sets, in slices and mid-scan, must end
+ *  up with the same matches as a fresh full search for the same pattern,
+ *  and must never fall back to a rescan on the way.
+ *
+ *  Editor: with the matches on a few rows of the screen, every key of the
+ *  query, backspace and ESC must only send the rows whose highlights
+ *  changed and the prompt's, never the whole panel.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "host.h"
+#include "sharp.h"
+#include "render.h"
+#include "keymap.h"
+#include "keyboard_input.h"
+#include "editor.h"
+#include "console.h"
+#include "stats.h"
+#include "doc.h"
+#include "mem.h"
+#include "search.h"
+#include "check.h"
+
+#define DOC_SIZE (96 * 1024)
+#define MATCHES 4096
+#define SLICE 1000
+
+void app_main(void);
+
+static const char prose[] =
+    "The quick brown fox jumps over the lazy dog. Él dijo que la niña "
+    "comía piña en la époque des maîtres; Œuvre, "
+    "Åse og øl på hytta.\n";
+
+/* Typed left to right, '\b' a backspace */
+static const char typed[] = "the lazx\bY dog\b\b\b\b\b\b\b\b\b\bœUV";
+
+static MemArena_t arena;
+static Doc_t doc;
+static Search_t search, fresh;
+
+static bool sameMatches(const Search_t *a, const Search_t *b) {
+    if (a->count != b->count) return false;
+    for (uint32_t i = 0; i < a->count; i++)
+        if (searchFirstIn(b, a->matches[i], a->matches[i] + 1) != a->matches[i]) return false;
+    return true;
+}
+
+static void engine(void) {
+    uint8_t query[SEARCH_PATTERN_MAX];
+    size_t len = 0, from = docLength(&doc) / 3;
+    uint32_t rescans = 0;
+
+    for (const char *k = typed; *k; k++) {
+        bool grew = *k != '\b';
+        if (grew) query[len++] = *k;
+        else while (len && (query[--len] & 0xC0) == 0x80) {}
+        if ((*k & 0xC0) == 0x80 || (grew && (k[1] & 0xC0) == 0x80)) continue;     // mid codepoint
+        if (!len) continue;
+
+        bool kept = search.len && (grew ? searchNarrow(&search, query, len, true) : searchWiden(&search, len, true));
+        if (!kept) {
+            rescans++;
+            searchStart(&search, &doc, query, len, true, from);
+        }
+        // One slice now, the rest after the next key narrows or widens the scan
+        searchStep(&search, SLICE);
+        if (k[1] && k[1] != '\b') continue;
+
+        while (searchStep(&search, SLICE)) {}
+        searchStart(&fresh, &doc, query, len, true, from);
+        while (searchStep(&fresh, SEARCH_SLICE)) {}
+        CHECK(sameMatches(&search, &fresh), "\"%.*s\": %u matches, a fresh search finds %u", (int)len, query,
+              (unsigned)search.count, (unsigned)fresh.count);
+    }
+    CHECK(rescans == 1, "%u rescans while typing", (unsigned)rescans);
+}
+
+/* Editor side: matches on rows 3 and 9 only, and one far below */
+
+static Editor_t editor;
+static Cursor_t cursor;
+static uint32_t sent[64];
+static size_t nsent;
+
+static void feedKey(char c) {
+    KeyInput_t in;
+    int vk = c == '\033' ? VK_ESC : c == '\b' ? VK_BACKSPACE : c == '\n' ? VK_ENTER : c - ' ' + VKCHAROFFSET;
+    keymapFromVk(vk, &in);
+    uint32_t before = display_stats.lines_sent;
+    editorKey(&editor, &in);
+    editorRedraw(&editor);
+    renderFlush();
+    while (editorBusy(&editor))
+        if (editorBackground(&editor)) {
+            editorRedraw(&editor);
+            renderFlush();
+        }
+    sent[nsent++] = display_stats.lines_sent - before;
+}
+
+static void screen(void *arg) {
+    char line[64];
+    docClear(&editor.doc);
+    for (int i = 0; i < 400; i++) {
+        bool hit = i == 3 || i == 9 || i == 300;
+        int n = snprintf(line, sizeof(line), "%03d 1234 5678 %s 90 -- 1234\n", i, hit ? "qxvz" : "0000");
+        docInsert(&editor.doc, docLength(&editor.doc), (const uint8_t *)line, n, 1);
+    }
+    editor.point = editor.top = 0;
+    feedKey('\033');
+    editorInvalidate(&editor);
+    editorRedraw(&editor);
+    renderFlush();
+    for (const char *k = "/qxv\b\b\bqx\033"; *k; k++) feedKey(*k);
+}
+
+static void isearchMain(void) {
+    size_t mark = memArenaMark(&doc_arena);
+    if (!memArenaInit(&arena, "isearch test", DOC_SIZE + 2 * MATCHES * 4 + 4096, MEM_PSRAM) ||
+        !docInit(&doc, &arena, DOC_SIZE) || !searchInit(&search, &arena, MATCHES) ||
+        !searchInit(&fresh, &arena, MATCHES) || !editorInit(&editor, &cursor, &doc_arena, DOC_SIZE)) {
+        CHECK(false, "no memory");
+        return;
+    }
+    while (docInsert(&doc, docLength(&doc), (const uint8_t *)prose, sizeof(prose) - 1, 1)) {}
+    docInsert(&doc, docLength(&doc) / 2, (const uint8_t *)"", 0, 1);
+    engine();
+
+    keyTaskCall(screen, NULL);
+    printf("lines sent per key:");
+    for (size_t i = 0; i < nsent; i++) printf(" %u", (unsigned)sent[i]);
+    printf("\n");
+    // The prompt's row and the two rows with matches, at most
+    for (size_t i = 1; i < nsent; i++)
+        CHECK(sent[i] <= 3 * PSF_GLYPH_SIZE, "key %zu sent %u lines", i, (unsigned)sent[i]);
+    memArenaRelease(&doc_arena, mark);
+}
+
+int main(void) {
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    hostRunMain(isearchMain);
+    return checkDone();
+}
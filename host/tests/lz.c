@@ -0,0 +1,139 @@
+/*
+ *  Block LZ codec (lz.h) on prose and on the inputs that are hard for it:
+ *
+ *    test_lz prose.txt
+ *
+ *  Every block must come back as it went in, whatever its length, from
+ *  prose, runs and random bytes; random bytes must stay within LZ_BOUND
+ *  and fail cleanly against a smaller cap; packed blocks cut short (but
+ *  for an empty last token) or unpacked to the wrong length must be
+ *  refused. The prose must pack to at most three quarters of its size,
+ *  and the ratio and pack and unpack MB/s are reported (this machine's
+ *  CPU).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "lz.h"
+#include "check.h"
+
+#define TEXT_MAX (64 * 1024)
+#define REPS 64
+#define PROSE_RATIO_PCT 75
+
+static uint8_t text[TEXT_MAX], back[TEXT_MAX];
+static uint8_t packed[TEXT_MAX / LZ_BLOCK + 1][LZ_BOUND(LZ_BLOCK)];
+static size_t sizes[TEXT_MAX / LZ_BLOCK + 1];
+static size_t text_len;
+static Lz_t lz;
+
+static bool roundTrip(const uint8_t *src, size_t n, size_t *size) {
+    static uint8_t out[LZ_BOUND(LZ_BLOCK)], got[LZ_BLOCK];
+    *size = lzPack(&lz, src, n, out, sizeof(out));
+    return *size && *size <= LZ_BOUND(n) && lzUnpack(out, *size, got, n) && memcmp(got, src, n) == 0;
+}
+
+/* Every length of a short block, then a spread up to a full one */
+static void lengths(const uint8_t *src, const char *what) {
+    size_t size;
+    for (size_t n = 0; n <= LZ_BLOCK; n += n < 80 ? 1 : 97)
+        CHECK(roundTrip(src, n, &size), "%s: %zu bytes", what, n);
+    CHECK(roundTrip(src, LZ_BLOCK, &size), "%s: a full block", what);
+}
+
+static void inputs(void) {
+    static uint8_t runs[LZ_BLOCK], noise[LZ_BLOCK], out[LZ_BOUND(LZ_BLOCK)];
+    uint32_t seed = 1;
+    for (size_t i = 0; i < LZ_BLOCK; i++) {
+        seed = seed * 1103515245 + 12345;
+        noise[i] = seed >> 16;
+        runs[i] = i < LZ_BLOCK / 2 ? 'a' : "ab"[(i / 300) & 1];
+    }
+    lengths(text, "prose");
+    lengths(runs, "runs");
+    lengths(noise, "random");
+
+    size_t size;
+    CHECK(roundTrip(runs, LZ_BLOCK, &size) && size < LZ_BLOCK / 50, "runs: %zu bytes packed", size);
+    CHECK(lzPack(&lz, noise, LZ_BLOCK, out, LZ_BLOCK) == 0, "random bytes fit a cap of their own size");
+    CHECK(lzPack(&lz, text, LZ_BLOCK + 1, out, sizeof(out)) == 0, "a block over LZ_BLOCK packed");
+}
+
+/* A packed block cut short, or unpacked to a different length */
+static void corrupt(void) {
+    static uint8_t out[LZ_BOUND(LZ_BLOCK)];
+    size_t size = lzPack(&lz, text, LZ_BLOCK, out, sizeof(out));
+    // Only the empty last token may go: the bytes are all there without it
+    for (size_t n = 0; n < size; n++)
+        CHECK(!lzUnpack(out, n, back, LZ_BLOCK) || (n == size - 1 && out[n] == 0 && memcmp(back, text, LZ_BLOCK) == 0),
+              "packed block cut to %zu of %zu bytes accepted", n, size);
+    CHECK(!lzUnpack(out, size, back, LZ_BLOCK - 1) && !lzUnpack(out, size, back, LZ_BLOCK + 1),
+          "unpacked to the wrong length");
+    out[size / 2] ^= 0xFF;
+    lzUnpack(out, size, back, LZ_BLOCK);        // must not run past back or read past out
+}
+
+static void prose(void) {
+    size_t blocks = (text_len + LZ_BLOCK - 1) / LZ_BLOCK, total = 0;
+    bool ok = true;
+
+    hostClockCountCpu(true);
+    int64_t t0 = esp_timer_get_time();
+    for (int r = 0; r < REPS; r++)
+        for (size_t b = 0; b < blocks; b++) {
+            size_t n = text_len - b * LZ_BLOCK < LZ_BLOCK ? text_len - b * LZ_BLOCK : LZ_BLOCK;
+            sizes[b] = lzPack(&lz, text + b * LZ_BLOCK, n, packed[b], sizeof(packed[b]));
+        }
+    int64_t pack_us = esp_timer_get_time() - t0;
+
+    t0 = esp_timer_get_time();
+    for (int r = 0; r < REPS; r++)
+        for (size_t b = 0; b < blocks; b++) {
+            size_t n = text_len - b * LZ_BLOCK < LZ_BLOCK ? text_len - b * LZ_BLOCK : LZ_BLOCK;
+            ok &= lzUnpack(packed[b], sizes[b], back + b * LZ_BLOCK, n);
+        }
+    int64_t unpack_us = esp_timer_get_time() - t0;
+    hostClockCountCpu(false);
+
+    for (size_t b = 0; b < blocks; b++) total += sizes[b];
+    double mb = (double)text_len * REPS / (1024 * 1024);
+    printf("{\"bench\":\"lz\",\"bytes\":%zu,\"packed\":%zu,\"ratio_pct\":%zu,\"pack_mb_per_s\":%.1f,"
+           "\"unpack_mb_per_s\":%.1f}\n", text_len, total, total * 100 / text_len,
+           mb * 1e6 / (pack_us ? pack_us : 1), mb * 1e6 / (unpack_us ? unpack_us : 1));
+
+    CHECK(ok && memcmp(text, back, text_len) == 0, "prose did not come back");
+    CHECK(total * 100 <= text_len * PROSE_RATIO_PCT, "prose packed to %zu%%", total * 100 / text_len);
+
+    // Any block on its own, as the loader reads them
+    for (size_t b = blocks; b-- > 0; ) {
+        size_t n = text_len - b * LZ_BLOCK < LZ_BLOCK ? text_len - b * LZ_BLOCK : LZ_BLOCK;
+        memset(back, 0, LZ_BLOCK);
+        CHECK(lzUnpack(packed[b], sizes[b], back, n) && memcmp(back, text + b * LZ_BLOCK, n) == 0,
+              "block %zu alone", b);
+    }
+}
+
+static void lzMain(void) {
+    inputs();
+    corrupt();
+    prose();
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        printf("usage: %s prose.txt\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    text_len = f ? fread(text, 1, sizeof(text), f) : 0;
+    if (f) fclose(f);
+    if (text_len < LZ_BLOCK) {
+        printf("cannot read a block of prose from %s\n", argv[1]);
+        return 2;
+    }
+    hostRunMain(lzMain);
+    return checkDone();
+}
@@ -0,0 +1,77 @@
+/*
+ *  Power over a recorded typing trace (power.h): the time awake and the
+ *  light sleep wakeups must stay within what the trace calls for.
+ *
+ *    test_power typing.trace
+ *
+ *  The expected figures come from the trace alone. Between two keys the
+ *  chip wakes for the key, for every cursor blink until the blink times
+ *  out, and once for the resume snapshot after a pause; each wakeup may
+ *  keep it awake for about a row flush. A change that adds wakeups or
+ *  keeps the chip up longer (a poll, a held lock, a timer) fails here.
+ */
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "cursor.h"
+#include "resume.h"
+#include "check.h"
+#include "typist.h"
+
+/* After the last key: past the blink timeout and the snapshot */
+#define TAIL_MS (60 * 1000)
+/* Awake per wakeup: a key with its row flush, or a blink's */
+#define WAKE_AWAKE_US 5000
+/* Slack on the counts: timer phases and shift presses */
+#define WAKE_SLACK 1.1
+
+void app_main(void);
+
+/* Wakeups a pause of ms between keys calls for, the key after it included */
+static uint32_t pauseWakeups(uint32_t ms) {
+    uint32_t blinking = ms < CURSOR_BLINK_TIMEOUT_MS ? ms : CURSOR_BLINK_TIMEOUT_MS;
+    return 1 + blinking / CURSOR_BLINK_MS + (ms > RESUME_IDLE_MS);
+}
+
+int main(int argc, char **argv) {
+    HostPower_t before, after;
+
+    if (argc != 2) {
+        printf("usage: %s typing.trace\n", argv[0]);
+        return 2;
+    }
+    hostRunMain(app_main);
+    hostRunFor(5 * 1000 * 1000);
+    if (!typistLoad(argv[1])) return 2;
+
+    uint32_t keys = 0, expected = pauseWakeups(TAIL_MS) - 1;
+    for (size_t i = 0; i < typistEvents(); i++) {
+        if (i && !typistDelay(i)) continue;
+        keys++;
+        expected += pauseWakeups(typistDelay(i));
+    }
+    int64_t expected_awake = (int64_t)expected * WAKE_AWAKE_US;
+
+    hostPowerGet(&before);
+    int64_t start = esp_timer_get_time();
+    typistStart();
+    while (!typistDone()) hostRunFor(1000 * 1000);
+    hostRunFor(TAIL_MS * 1000LL);
+    int64_t elapsed = esp_timer_get_time() - start;
+    hostPowerGet(&after);
+
+    uint32_t wakeups = after.wakeups - before.wakeups;
+    int64_t awake = elapsed - (after.sleep_us - before.sleep_us);
+    printf("%u keys in %lld ms: awake %lld us (%.2f%%), %u wakeups; expected at most %lld us (%.2f%%), %u wakeups\n",
+           (unsigned)keys, (long long)(elapsed / 1000), (long long)awake, 100.0 * awake / elapsed, (unsigned)wakeups,
+           (long long)expected_awake, 100.0 * expected_awake / elapsed, (unsigned)expected);
+
+    CHECK(typistSent() == typistEvents(), "%u of %u key events sent", (unsigned)typistSent(),
+          (unsigned)typistEvents());
+    CHECK(wakeups <= expected * WAKE_SLACK, "%u wakeups, expected %u", (unsigned)wakeups, (unsigned)expected);
+    CHECK(wakeups >= keys, "%u wakeups for %u keys: the chip did not sleep between them", (unsigned)wakeups,
+          (unsigned)keys);
+    CHECK(awake <= expected_awake, "awake %lld us, expected %lld", (long long)awake, (long long)expected_awake);
+    return checkDone();
+}
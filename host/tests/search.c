@@ -0,0 +1,201 @@
+/*
+ *  Document search (search.h) against a naive scan of a contiguous copy
+ *  of the text. For patterns on both the memchr and the Horspool path,
+ *  with and without case folding, with the gap moved through every byte of
+ *  a match, from several start positions and in small and large slices:
+ *  the same matches, in the documented order, and searchFind() agrees in
+ *  both directions. Then a multi-megabyte document: the first match near
+ *  the start position is there after the first slice, and the full scan
+ *  rate is reported (this machine's CPU).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "doc.h"
+#include "mem.h"
+#include "search.h"
+#include "check.h"
+
+#define DOC_SIZE (64 * 1024)
+#define BIG_SIZE (3 * 1024 * 1024)
+#define MATCHES 8192
+
+static const char prose[] =
+    "The quick brown fox jumps over the lazy dog. Él dijo que la niña "
+    "comía piña en la époque des maîtres; Œuvre, "
+    "Åse og øl på hytta. aaaa İstanbul ısık. Žena z Łodzi, Ĺ a ĺ, ŽIŽKA.\n";
+
+static const struct {
+    const char *pat;
+    bool fold;
+} patterns[] = {
+    { "o", false }, { "fox", false }, { "aa", false }, { "ña", false }, { "THE", true },
+    { "ÉL", true }, { "époque", true }, { "œUVRE", true }, { "ŽKA.\nThe", false },
+    { "lazy dog. Él dijo", false }, { "ÅSE OG ØL", true }, { "istanbul", true },
+    { "İstanbul", true }, { "ž", true }, { "łodzi", true }, { "ĺ", true }, { "žižka", true }, { "Ž", false },
+    { "zzzz", true },
+};
+
+static MemArena_t arena;
+static Doc_t doc;
+static Search_t search;
+static uint8_t text[DOC_SIZE];
+static uint32_t want[MATCHES];
+
+static uint32_t decode(const uint8_t *p, size_t *len) {
+    uint8_t c = p[0];
+    int more = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : 0;
+    uint32_t cp = more ? c & (0x3F >> more) : c;
+    for (int i = 1; i <= more; i++) cp = (cp << 6) | (p[i] & 0x3F);
+    *len = 1 + more;
+    return cp;
+}
+
+/* Every match start, codepoint by codepoint, ascending */
+static uint32_t naive(const uint8_t *t, size_t n, const char *pat, bool fold) {
+    size_t plen = strlen(pat);
+    uint32_t count = 0;
+    for (size_t at = 0; at + plen <= n; at++) {
+        if ((t[at] & 0xC0) == 0x80) continue;
+        size_t i = at, j = 0;
+        while (j < plen && i < n) {
+            size_t a, b;
+            uint32_t ca = decode(t + i, &a), cb = decode((const uint8_t *)pat + j, &b);
+            if (fold ? searchFoldCp(ca) != searchFoldCp(cb) : ca != cb) break;
+            i += a;
+            j += b;
+        }
+        if (j == plen && count < MATCHES) want[count++] = at;
+    }
+    return count;
+}
+
+/* Matches come ascending from where the scan began, then from 0 after
+ * the wrap (none from 0, or from past the last window) */
+static bool scanOrder(void) {
+    size_t from = search.origin;
+    for (uint32_t i = 0; i < search.count; i++) {
+        bool after_wrap = search.wrapped && i >= search.wrap_index;
+        if (after_wrap ? search.matches[i] >= from : search.matches[i] < from) return false;
+        if (i && i != search.wrap_index && search.matches[i] <= search.matches[i - 1]) return false;
+    }
+    return true;
+}
+
+static bool sameSet(uint32_t n) {
+    if (search.count != n) return false;
+    for (uint32_t i = 0; i < n; i++)
+        if (searchFirstIn(&search, want[i], want[i] + 1) != want[i]) return false;
+    return true;
+}
+
+static void run(const char *pat, bool fold, size_t from, size_t slice) {
+    searchStart(&search, &doc, (const uint8_t *)pat, strlen(pat), fold, from);
+    while (searchStep(&search, slice)) {}
+}
+
+/* The pairs the naive scan relies on searchFoldCp() for */
+static void folds(void) {
+    static const uint32_t pairs[][2] = { { 'A', 'a' }, { 0xC9, 0xE9 }, { 0xC5, 0xE5 }, { 0xD8, 0xF8 },
+                                         { 0x152, 0x153 }, { 0x160, 0x161 }, { 0x11E, 0x11F }, { 0x178, 0xFF },
+                                         { 0x17D, 0x17E }, { 0x141, 0x142 }, { 0x139, 0x13A } };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+        CHECK(searchFoldCp(pairs[i][0]) == searchFoldCp(pairs[i][1]), "U+%04X and U+%04X fold apart",
+              (unsigned)pairs[i][0], (unsigned)pairs[i][1]);
+    CHECK(searchFoldCp(0x130) != searchFoldCp('i') && searchFoldCp(0x131) != searchFoldCp('I'), "Turkish i folded");
+    CHECK(searchFoldCp(0xD7) != searchFoldCp(0xF7), "U+00D7 and U+00F7 fold together");
+}
+
+static void proseDoc(size_t copies) {
+    docClear(&doc);
+    docInsert(&doc, 0, (const uint8_t *)prose, sizeof(prose) - 1, copies);
+}
+
+static void matches(void) {
+    proseDoc(DOC_SIZE / sizeof(prose) - 1);
+    size_t n = docLength(&doc);
+    docCopy(&doc, 0, n, text);
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        const char *pat = patterns[p].pat;
+        bool fold = patterns[p].fold;
+        uint32_t count = naive(text, n, pat, fold);
+        static const size_t starts[] = { 0, 1, DOC_SIZE / 3, DOC_SIZE - 1 };
+
+        for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++) {
+            size_t from = starts[s] < n ? starts[s] : n - 1;
+            for (size_t slice = 97; slice <= SEARCH_SLICE; slice *= 337) {
+                docInsert(&doc, (from * 7 + slice) % n, (const uint8_t *)"", 0, 1);     // the gap somewhere
+                run(pat, fold, from, slice);
+                CHECK(sameSet(count), "\"%s\" fold %d from %zu, slices of %zu: %u matches, %u expected", pat, fold,
+                      from, slice, (unsigned)search.count, (unsigned)count);
+                CHECK(scanOrder(), "\"%s\" from %zu: out of order", pat, from);
+            }
+        }
+
+        // The gap inside a match, at each of its bytes
+        for (size_t k = 0; count && k <= strlen(pat); k++) {
+            docInsert(&doc, want[count / 2] + k, (const uint8_t *)"", 0, 1);
+            run(pat, fold, 0, SEARCH_SLICE);
+            CHECK(sameSet(count), "\"%s\" with the gap %zu bytes into a match", pat, k);
+        }
+
+        // searchFind() from every position of one copy of the prose, both ways
+        for (size_t pos = 0; count && pos < sizeof(prose); pos++) {
+            size_t next = SEARCH_NONE, prev = SEARCH_NONE;
+            for (uint32_t i = 0; i < count && next == SEARCH_NONE; i++)
+                if (want[i] >= pos) next = want[i];
+            for (uint32_t i = count; i-- > 0 && prev == SEARCH_NONE; )
+                if (want[i] < pos) prev = want[i];
+            if (next == SEARCH_NONE) next = want[0];
+            if (prev == SEARCH_NONE) prev = want[count - 1];
+            CHECK(searchFind(&search, pos, true) == next, "\"%s\" forward from %zu", pat, pos);
+            CHECK(searchFind(&search, pos, false) == prev, "\"%s\" back from %zu", pat, pos);
+        }
+    }
+}
+
+/* A manuscript of a few MB, searched from the middle */
+static void manuscript(void) {
+    Doc_t big;
+    size_t mark = memArenaMark(&arena);
+    CHECK(docInit(&big, &arena, BIG_SIZE), "no room for %d bytes", BIG_SIZE);
+    while (docInsert(&big, docLength(&big), (const uint8_t *)prose, sizeof(prose) - 1, 1)) {}
+    docInsert(&big, docLength(&big) / 2, (const uint8_t *)"", 0, 1);
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        size_t from = docLength(&big) / 3;
+        hostClockCountCpu(true);
+        int64_t t0 = esp_timer_get_time();
+        searchStart(&search, &big, (const uint8_t *)patterns[p].pat, strlen(patterns[p].pat), patterns[p].fold, from);
+        searchStep(&search, SEARCH_SLICE);
+        uint32_t first = search.count;
+        while (searchStep(&search, SEARCH_SLICE)) {}
+        int64_t dt = esp_timer_get_time() - t0;
+        hostClockCountCpu(false);
+        printf("{\"bench\":\"search\",\"len\":%zu,\"fold\":%d,\"bytes\":%zu,\"us\":%lld,\"matches\":%u}\n",
+               strlen(patterns[p].pat), patterns[p].fold, docLength(&big), (long long)dt, (unsigned)search.count);
+        CHECK(!search.count || first, "\"%s\": nothing after the first slice", patterns[p].pat);
+        CHECK(!search.count || search.matches[0] >= from, "\"%s\": first match before the start", patterns[p].pat);
+    }
+    memArenaRelease(&arena, mark);
+}
+
+static void searchMain(void) {
+    if (!memArenaInit(&arena, "search test", DOC_SIZE + BIG_SIZE + MATCHES * 8 + 4096, MEM_PSRAM) ||
+        !docInit(&doc, &arena, DOC_SIZE) || !searchInit(&search, &arena, MATCHES)) {
+        CHECK(false, "no memory");
+        return;
+    }
+    folds();
+    matches();
+    manuscript();
+}
+
+int main(void) {
+    hostRunMain(searchMain);
+    return checkDone();
+}
@@ -0,0 +1,206 @@
+/*
+ *  Spelling dictionaries (spell.h) from word lists compiled by
+ *  tools/mkdict.py at build time:
+ *
+ *    test_spell dict.bin en:words_en.txt es:words_es.txt ...
+ *
+ *  For each language, every listed word must be known as listed,
+ *  Capitalized and in capitals, and the same words with letters added must
+ *  not be; the completions of every one and two letter prefix must be the
+ *  most frequent listed words, ranked as the counts have them. Then the
+ *  lookup rate, straight from flash and through the cache, for known and
+ *  unknown words (this machine's CPU).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "spell.h"
+#include "check.h"
+
+#define WORDS 1024
+#define REPS 64
+
+void app_main(void);
+
+typedef struct {
+    char text[SPELL_WORD_MAX + 1];
+    uint32_t count;
+} Word_t;
+
+typedef struct {
+    char code[4];
+    const char *path;
+    Word_t words[WORDS];
+    size_t n;
+} List_t;
+
+static List_t lists[4];
+static size_t nlists;
+
+static bool readList(List_t *l) {
+    char line[128];
+    FILE *f = fopen(l->path, "r");
+    if (!f) return false;
+    while (fgets(line, sizeof(line), f) && l->n < WORDS) {
+        Word_t *w = &l->words[l->n];
+        if (line[0] == '#' || sscanf(line, "%32s %u", w->text, &w->count) != 2) continue;
+        l->n++;
+    }
+    fclose(f);
+    return l->n > 0;
+}
+
+static bool listed(const List_t *l, const char *word) {
+    for (size_t i = 0; i < l->n; i++)
+        if (strcmp(l->words[i].text, word) == 0) return true;
+    return false;
+}
+
+static bool lookup(const char *word) {
+    return spellLookup((const uint8_t *)word, strlen(word));
+}
+
+static bool ascii(const char *s) {
+    for (; *s; s++)
+        if (*s & 0x80) return false;
+    return true;
+}
+
+static void words(const List_t *l) {
+    char buf[SPELL_WORD_MAX + 8];
+    for (size_t i = 0; i < l->n; i++) {
+        const char *w = l->words[i].text;
+        CHECK(lookup(w), "%s: \"%s\" unknown", l->code, w);
+        if (ascii(w) && isalpha((unsigned char)w[0])) {
+            strcpy(buf, w);
+            buf[0] = toupper((unsigned char)buf[0]);
+            CHECK(lookup(buf), "%s: \"%s\" unknown", l->code, buf);
+            for (char *p = buf; *p; p++) *p = toupper((unsigned char)*p);
+            CHECK(lookup(buf), "%s: \"%s\" unknown", l->code, buf);
+        }
+        static const char *const tails[] = { "zq", "x", "qq" };
+        for (size_t t = 0; t < sizeof(tails) / sizeof(tails[0]); t++) {
+            snprintf(buf, sizeof(buf), "%s%s", w, tails[t]);
+            if (!listed(l, buf)) CHECK(!lookup(buf), "%s: \"%s\" known", l->code, buf);
+        }
+    }
+    CHECK(!lookup("qqqq") && !lookup("zzzzzzzz"), "%s: nonsense known", l->code);
+}
+
+/* Listed words starting with prefix, most frequent first, ties in byte
+ * order as tools/mkdict.py ranks them */
+static size_t expected(const List_t *l, const char *prefix, const Word_t **out) {
+    size_t n = 0, plen = strlen(prefix);
+    for (size_t i = 0; i < l->n; i++) {
+        const Word_t *w = &l->words[i];
+        if (strncmp(w->text, prefix, plen) != 0) continue;
+        size_t k = n < SPELL_COMPLETE_TOP ? n++ : SPELL_COMPLETE_TOP;
+        while (k > 0 && (out[k - 1]->count < w->count ||
+                         (out[k - 1]->count == w->count && strcmp(out[k - 1]->text, w->text) > 0))) {
+            if (k < SPELL_COMPLETE_TOP) out[k] = out[k - 1];
+            k--;
+        }
+        if (k < SPELL_COMPLETE_TOP) out[k] = w;
+    }
+    return n;
+}
+
+static void completions(const List_t *l) {
+    SpellWord_t got[SPELL_COMPLETE_TOP];
+    const Word_t *want[SPELL_COMPLETE_TOP];
+    char prefix[8];
+
+    for (size_t i = 0; i < l->n; i++) {
+        const char *w = l->words[i].text;
+        for (size_t plen = 1; plen <= 2 && w[plen - 1]; plen++) {
+            if ((w[plen] & 0xC0) == 0x80) continue;         // mid codepoint
+            memcpy(prefix, w, plen);
+            prefix[plen] = 0;
+            size_t n = spellComplete((const uint8_t *)prefix, plen, got, SPELL_COMPLETE_TOP);
+            size_t m = expected(l, prefix, want);
+            bool same = n == m;
+            for (size_t k = 0; same && k < n; k++)
+                same = got[k].len == strlen(want[k]->text) && memcmp(got[k].text, want[k]->text, got[k].len) == 0;
+            CHECK(same, "%s: %zu completions of \"%s\", %zu expected, first \"%.*s\" for \"%s\"", l->code, n, prefix, m,
+                  n ? got[0].len : 0, n ? (const char *)got[0].text : "", m ? want[0]->text : "");
+        }
+    }
+}
+
+static int64_t timed(const List_t *l, const char *tail, bool cached) {
+    char buf[SPELL_WORD_MAX + 8];
+    int64_t t0 = esp_timer_get_time();
+    for (int r = 0; r < REPS; r++)
+        for (size_t i = 0; i < l->n; i++) {
+            size_t len = snprintf(buf, sizeof(buf), "%s%s", l->words[i].text, tail);
+            if (cached) spellCheck((const uint8_t *)buf, len);
+            else spellLookup((const uint8_t *)buf, len);
+        }
+    return esp_timer_get_time() - t0;
+}
+
+static void throughput(const List_t *l) {
+    hostClockCountCpu(true);
+    int64_t known = timed(l, "", false), unknown = timed(l, "zq", false);
+    int64_t cached = timed(l, "", true);
+    hostClockCountCpu(false);
+    uint32_t n = REPS * l->n;
+    printf("{\"bench\":\"spell\",\"lang\":\"%s\",\"words\":%zu,\"lookups\":%u,\"known_per_s\":%lld,"
+           "\"unknown_per_s\":%lld,\"cached_per_s\":%lld}\n", l->code, l->n, (unsigned)n,
+           (long long)(n * 1000000LL / (known ? known : 1)), (long long)(n * 1000000LL / (unknown ? unknown : 1)),
+           (long long)(n * 1000000LL / (cached ? cached : 1)));
+
+    // The cache answers for every word checked, until the language changes
+    const uint8_t *w = (const uint8_t *)l->words[0].text;
+    size_t len = strlen(l->words[0].text);
+    CHECK(spellCached(w, len) == SPELL_OK, "%s: \"%s\" not cached", l->code, l->words[0].text);
+    spellSetLanguage(l->code);
+    CHECK(spellCached(w, len) == SPELL_UNKNOWN, "%s: cache kept across a language change", l->code);
+}
+
+static void spellMain(void) {
+    CHECK(strcmp(spellLanguage(), lists[0].code) == 0, "\"%s\" selected at boot, not %s", spellLanguage(),
+          lists[0].code);
+    for (size_t i = 0; i < nlists; i++) {
+        const List_t *l = &lists[i];
+        if (!spellSetLanguage(l->code)) {
+            CHECK(false, "no %s dictionary", l->code);
+            continue;
+        }
+        words(l);
+        completions(l);
+        throughput(l);
+    }
+    CHECK(!spellSetLanguage("xx") && strcmp(spellLanguage(), lists[nlists - 1].code) == 0,
+          "selecting a missing language changed it");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3 || (size_t)argc - 2 > sizeof(lists) / sizeof(lists[0])) {
+        printf("usage: %s dict.bin lang:words.txt...\n", argv[0]);
+        return 2;
+    }
+    for (int i = 2; i < argc; i++) {
+        List_t *l = &lists[nlists++];
+        const char *colon = strchr(argv[i], ':');
+        if (!colon || colon - argv[i] >= (int)sizeof(l->code)) {
+            printf("expected lang:file, got %s\n", argv[i]);
+            return 2;
+        }
+        memcpy(l->code, argv[i], colon - argv[i]);
+        l->path = colon + 1;
+        if (!readList(l)) {
+            printf("cannot read %s\n", l->path);
+            return 2;
+        }
+    }
+    if (!hostPartitionLoad("dict", argv[1])) return 2;
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    hostRunMain(spellMain);
+    return checkDone();
+}
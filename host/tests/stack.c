@@ -0,0 +1,47 @@
+/*
+ *  Key task stack (tasks.h): its deepest paths are a document save with
+ *  the resume snapshot after it, and a search. Type, let both run, search,
+ *  and check the high-water mark leaves the headroom the task table's
+ *  comment promises.
+ */
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "sharp.h"
+#include "console.h"
+#include "resume.h"
+#include "check.h"
+#include "typist.h"
+
+/* Free at the high-water mark, for what the host cannot show: the
+ * interrupts that land on the task's stack on the device */
+#define STACK_HEADROOM 1024
+
+void app_main(void);
+
+static TaskHandle_t key_task;
+
+static void whoAmI(void *arg) {
+    key_task = xTaskGetCurrentTaskHandle();
+}
+
+static void findKeyTask(void) {
+    keyTaskCall(whoAmI, NULL);
+}
+
+int main(void) {
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    typistText(0, 120, "iThe quick brown fox jumps over the lazy dog.\nPack my box with five dozen liquor jugs.\033");
+    typistText((RESUME_IDLE_MS + 3000), 150, "?box\nn/dog\nN");
+    typistStart();
+    while (!typistDone()) hostRunFor(1000 * 1000);
+    hostRunFor((RESUME_IDLE_MS + 3000) * 1000LL);
+
+    hostRunMain(findKeyTask);
+    unsigned free = uxTaskGetStackHighWaterMark(key_task);
+    printf("key task: %u bytes free at the high-water mark\n", free);
+    CHECK(free >= STACK_HEADROOM, "%u bytes free", free);
+    return checkDone();
+}
@@ -0,0 +1,153 @@
+/*
+ *  Scripted typing for the host tests. See typist.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "keyboard_input.h"
+#include "keymap.h"
+#include "host.h"
+#include "typist.h"
+
+#define SHIFT_DOWN (KEYDOWN_MASK | MOD_MASK | 0x01)
+#define SHIFT_UP (MOD_MASK | 0x01)
+
+extern QueueHandle_t keyboard;
+
+typedef struct {
+    uint32_t delay_ms;      /* before sending */
+    uint8_t event;
+} Stroke_t;
+
+static Stroke_t *script;
+static size_t nscript, capacity, next;
+static int64_t length_us;
+static volatile bool done;
+
+/* Key code and shift for every codepoint the layout types */
+static struct {
+    uint32_t cp;
+    uint8_t key;
+    bool shift;
+} layout[2 * (KEY_MASK + 1)];
+static size_t nlayout;
+
+static void learnLayout(void) {
+    KeyInput_t in;
+    for (int shift = 0; shift < 2; shift++) {
+        if (shift) keymapTranslate(SHIFT_DOWN, &in);
+        for (uint8_t k = 1; k <= KEY_MASK; k++) {
+            if (!keymapTranslate(KEYDOWN_MASK | k, &in)) continue;
+            uint32_t cp = in.printable ? in.codepoint
+                        : in.vk == VK_ENTER ? '\n' : in.vk == VK_BACKSPACE ? '\b'
+                        : in.vk == VK_TAB ? '\t' : in.vk == VK_ESC ? '\033' : 0;
+            bool known = false;
+            for (size_t i = 0; i < nlayout; i++) known |= layout[i].cp == cp;
+            if (cp && !known) layout[nlayout++] = (typeof(layout[0])){ cp, k, shift };
+        }
+        if (shift) keymapTranslate(SHIFT_UP, &in);
+    }
+}
+
+static bool add(uint32_t delay_ms, uint8_t event) {
+    if (nscript == capacity) {
+        capacity = capacity ? capacity * 2 : 256;
+        script = realloc(script, capacity * sizeof(*script));
+        if (!script) abort();
+    }
+    script[nscript++] = (Stroke_t){ delay_ms, event };
+    length_us += delay_ms * 1000LL;
+    return true;
+}
+
+static bool type(uint32_t delay_ms, uint32_t cp) {
+    for (size_t i = 0; i < nlayout; i++) {
+        if (layout[i].cp != cp) continue;
+        if (!layout[i].shift) return add(delay_ms, KEYDOWN_MASK | layout[i].key);
+        return add(delay_ms, SHIFT_DOWN) && add(0, KEYDOWN_MASK | layout[i].key) && add(0, SHIFT_UP);
+    }
+    printf("typist: U+%04X is not on the keyboard\n", (unsigned)cp);
+    return false;
+}
+
+bool typistText(uint32_t pause_ms, uint32_t ms_per_key, const char *text) {
+    if (!nlayout) learnLayout();
+    for (const uint8_t *s = (const uint8_t *)text; *s; s++) {
+        uint32_t cp = *s;
+        // Two-byte UTF-8, for the accented letters the layout has
+        if ((cp & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) cp = ((cp & 0x1F) << 6) | (*++s & 0x3F);
+        if (!type(s == (const uint8_t *)text ? pause_ms : ms_per_key, cp)) return false;
+    }
+    return true;
+}
+
+bool typistLoad(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[1024], text[1024];
+    unsigned pause, per_key;
+    bool ok = f != NULL;
+
+    while (ok && fgets(line, sizeof(line), f)) {
+        int at = 0;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "%u %u %n", &pause, &per_key, &at) != 2) {
+            ok = false;
+            break;
+        }
+        size_t n = 0;
+        for (const char *s = line + at; *s && *s != '\n'; s++) {
+            if (*s == '\\' && s[1]) {
+                s++;
+                text[n++] = *s == 'n' ? '\n' : *s == 'b' ? '\b' : *s == 't' ? '\t' : *s == 'e' ? '\033' : *s;
+            } else {
+                text[n++] = *s;
+            }
+        }
+        text[n] = 0;
+        ok = typistText(pause, per_key, text);
+    }
+    if (f) fclose(f);
+    if (!ok) printf("typist: cannot read %s\n", path);
+    return ok;
+}
+
+static void typistTask(void *arg) {
+    for (; next < nscript; next++) {
+        if (script[next].delay_ms) vTaskDelay(pdMS_TO_TICKS(script[next].delay_ms));
+        xQueueSend(keyboard, &script[next].event, portMAX_DELAY);
+    }
+    done = true;
+    vTaskDelete(NULL);
+}
+
+void typistStart(void) {
+    TaskHandle_t task;
+    done = false;
+    next = 0;
+    // Above the key task, as the keyboard interrupt would be
+    xTaskCreate(typistTask, "typist", 2048, NULL, configMAX_PRIORITIES - 1, &task);
+    hostTaskExternal(task);
+}
+
+bool typistDone(void) {
+    return done;
+}
+
+int64_t typistLength(void) {
+    return length_us;
+}
+
+uint32_t typistSent(void) {
+    return next;
+}
+
+size_t typistEvents(void) {
+    return nscript;
+}
+
+uint32_t typistDelay(size_t i) {
+    return i < nscript ? script[i].delay_ms : 0;
+}
@@ -0,0 +1,33 @@
+/*
+ *  Typing for the host tests: a script of keystrokes with pauses, sent to
+ *  the keyboard queue by a task that stands for the keyboard interrupt
+ *  (hostTaskExternal()), so the chip does not know when the next key comes.
+ *
+ *  Text is typed a character at a time; uppercase and shifted symbols get
+ *  a shift press and release around them. '\n' is ENTER, '\b' BACKSPACE,
+ *  '\t' TAB and '\033' ESC.
+ *
+ *  A trace file has one burst per line, "<pause ms> <ms per key> <text>",
+ *  with \n, \b, \t and \e escapes in the text; '#' starts a comment.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Queue text, a key every ms_per_key, after pause_ms */
+bool typistText(uint32_t pause_ms, uint32_t ms_per_key, const char *text);
+/* Queue the bursts of a trace file */
+bool typistLoad(const char *path);
+/* Start sending; call after app_main() created the queue */
+void typistStart(void);
+bool typistDone(void);
+/* Simulated time the whole script takes, us */
+int64_t typistLength(void);
+/* Keys sent so far */
+uint32_t typistSent(void);
+/* Key events in the script, and the pause before each, ms: 0 for the
+ * shift events around a key */
+size_t typistEvents(void);
+uint32_t typistDelay(size_t i);
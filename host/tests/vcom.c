@@ -0,0 +1,128 @@
+/*
+ *  VCOM inversion over long idle and typing (vcom.h), in the mode the
+ *  build selects. The panel needs its VCOM inverted at least once a second
+ *  whatever the rest of the firmware is doing:
+ *
+ *    LEDC      the channel's output, sampled on the host clock, must be a
+ *              square wave within that bound, kept running in light sleep,
+ *              and no command byte may carry a VCOM bit
+ *    software  the polarity the command bytes on the wire carry must flip
+ *              within the bound, by flush or by maintain command, and the
+ *              maintain commands must only fill in for missing flushes
+ */
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "sharp.h"
+#include "vcom.h"
+#include "check.h"
+#include "typist.h"
+
+#define PANEL_VCOM_MAX_GAP_US (1000 * 1000)
+#define SAMPLE_US (5 * 1000)
+#define SHARPMEM_BIT_VCOM 0x02
+
+void app_main(void);
+
+/* Bursts of typing with a ten minute and a half hour pause */
+static void session(void) {
+    typistText(0, 150, "iThe quick brown fox jumps over the lazy dog.\n");
+    typistText(2000, 120, "Pack my box with five dozen liquor jugs.\n");
+    typistText(10 * 60 * 1000, 150, "Sphinx of black quartz, judge my vow.\n");
+    typistText(30 * 60 * 1000, 90, "How vexingly quick daft zebras jump!\033");
+}
+
+#if VCOM_MODE == VCOM_MODE_LEDC
+/* Longest stretch without a change of the channel's level */
+static int64_t ledcLongestHalf(int64_t from, int64_t to, int64_t *shortest) {
+    int level = hostLedcLevel(0, from);
+    int64_t changed = from, longest = 0;
+    *shortest = INT64_MAX;
+    for (int64_t t = from + SAMPLE_US; t <= to; t += SAMPLE_US) {
+        int now = hostLedcLevel(0, t);
+        if (now == level) continue;
+        if (changed != from && t - changed < *shortest) *shortest = t - changed;
+        if (t - changed > longest) longest = t - changed;
+        level = now;
+        changed = t;
+    }
+    return to - changed > longest ? to - changed : longest;
+}
+#endif
+
+int main(void) {
+    const HostSpiTrans_t *log;
+    HostPower_t before, after;
+
+    hostRunMain(app_main);
+    hostRunFor(5 * 1000 * 1000);
+    hostSpiClear();
+    hostPowerGet(&before);
+    int64_t start = esp_timer_get_time();
+
+    session();
+    typistStart();
+    while (!typistDone()) hostRunFor(1000 * 1000);
+    hostRunFor(60 * 1000 * 1000);
+    int64_t end = esp_timer_get_time();
+    hostPowerGet(&after);
+    CHECK(end - start > 40 * 60 * 1000 * 1000LL, "ran %lld us", (long long)(end - start));
+    CHECK(after.sleep_us - before.sleep_us > (end - start) / 2, "slept %lld of %lld us",
+          (long long)(after.sleep_us - before.sleep_us), (long long)(end - start));
+
+    size_t n = hostSpiLog(&log);
+    uint32_t windows = 0, maintains = 0, flips = 0, carried = 0;
+    int64_t last_flip = start, longest = 0;
+    int polarity = -1;
+    for (size_t i = 0; i < n; i++) {
+        if (i && log[i].window == log[i - 1].window) continue;
+        windows++;
+        int bit = (log[i].first & SHARPMEM_BIT_VCOM) != 0;
+        if (log[i].bytes == 2 && (log[i].first & ~SHARPMEM_BIT_VCOM) == 0) maintains++;
+        if (VCOM_MODE == VCOM_MODE_LEDC) {
+            CHECK(!bit, "window %u at %lld us carries a VCOM bit", (unsigned)windows, (long long)log[i].start_us);
+            continue;
+        }
+        if (bit == polarity) continue;
+        if (polarity >= 0) {
+            flips++;
+            carried += log[i].bytes > 2;
+            if (log[i].start_us - last_flip > longest) longest = log[i].start_us - last_flip;
+        }
+        polarity = bit;
+        last_flip = log[i].start_us;
+    }
+    printf("%u windows, %u maintain commands, %u flips, %u by flushes\n", (unsigned)windows, (unsigned)maintains,
+           (unsigned)flips, (unsigned)carried);
+    CHECK(windows > 20, "%u windows", (unsigned)windows);
+
+#if VCOM_MODE == VCOM_MODE_LEDC
+    const ledc_timer_config_t *timer = hostLedcTimer(0);
+    const ledc_channel_config_t *channel = hostLedcChannel(0);
+    CHECK(timer && channel, "VCOM channel not configured");
+    if (timer && channel) {
+        CHECK(channel->gpio_num == 33, "VCOM on pin %d", channel->gpio_num);
+        CHECK(channel->sleep_mode == LEDC_SLEEP_MODE_KEEP_ALIVE, "VCOM stops in light sleep");
+        CHECK(timer->clk_cfg == LEDC_USE_RC_FAST_CLK, "VCOM clock stops in light sleep");
+        CHECK(channel->duty == 1u << (timer->duty_resolution - 1), "duty %u", (unsigned)channel->duty);
+        CHECK(maintains == 0, "%u maintain commands", (unsigned)maintains);
+        int64_t shortest, half = ledcLongestHalf(start, end, &shortest);
+        printf("LEDC half periods %lld..%lld us\n", (long long)shortest, (long long)half);
+        CHECK(half <= PANEL_VCOM_MAX_GAP_US, "VCOM held %lld us", (long long)half);
+        CHECK(half - shortest <= 2 * SAMPLE_US, "uneven square wave, %lld..%lld us", (long long)shortest,
+              (long long)half);
+    }
+#else
+    if (end - last_flip > longest) longest = end - last_flip;
+    CHECK(longest <= PANEL_VCOM_MAX_GAP_US, "VCOM held %lld us", (long long)longest);
+    CHECK(flips >= (end - start) / PANEL_VCOM_MAX_GAP_US, "%u flips", (unsigned)flips);
+    // Flushes carry the flips while typing, maintain commands only the rest
+    uint32_t halves = (end - start) / VCOM_HALF_PERIOD_US;
+    CHECK(carried > 0, "no flush carried a flip");
+    CHECK(maintains + carried == flips, "%u maintain commands, %u flips", (unsigned)maintains, (unsigned)flips);
+    CHECK(maintains < halves, "%u maintain commands for %u half periods", (unsigned)maintains, (unsigned)halves);
+    CHECK(flips <= 2 * halves + 1, "%u flips for %u half periods", (unsigned)flips, (unsigned)halves);
+#endif
+    return checkDone();
+}
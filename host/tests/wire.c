@@ -0,0 +1,58 @@
+/*
+ *  Flush timing model (wire.h) against the simulated bus: record the
+ *  flushes of a typing session in the trace, calibrate, and every recorded
+ *  flush must take what the model predicts for it, at the clock the build
+ *  runs the panel at.
+ */
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "host.h"
+#include "console.h"
+#include "wire.h"
+#include "check.h"
+#include "typist.h"
+
+/* Model against measurement, per flush */
+#define WIRE_TOLERANCE_PERCENT 2
+
+void app_main(void);
+
+static WireFlush_t flushes[WIRE_MAX_FLUSHES];
+static size_t nflushes;
+static WireParams_t calibrated;
+
+static void calibrate(void *arg) {
+    nflushes = wireCollect(flushes, WIRE_MAX_FLUSHES);
+    calibrated = wire_params;
+    wireCalibrate(&calibrated);
+}
+
+static void wireMain(void) {
+    keyTaskCall(calibrate, NULL);
+}
+
+int main(void) {
+    hostRunMain(app_main);
+    hostRunFor(1000 * 1000);
+    typistText(0, 120, "iA line of text,\nanother one\b\b\bline,\n\n\nand a last.\033");
+    typistStart();
+    while (!typistDone()) hostRunFor(1000 * 1000);
+    hostRunFor(1000 * 1000);
+    hostRunMain(wireMain);
+
+    printf("%u flushes at %u Hz, %u ns per transaction calibrated, %u simulated\n", (unsigned)nflushes,
+           (unsigned)calibrated.clock_hz, (unsigned)calibrated.trans_ns, (unsigned)HOST_SPI_TRANS_NS);
+    CHECK(nflushes >= 10, "%u flushes recorded", (unsigned)nflushes);
+    CHECK(calibrated.trans_ns * 100 >= HOST_SPI_TRANS_NS * (100 - WIRE_TOLERANCE_PERCENT) &&
+          calibrated.trans_ns * 100 <= HOST_SPI_TRANS_NS * (100 + WIRE_TOLERANCE_PERCENT),
+          "calibrated %u ns per transaction", (unsigned)calibrated.trans_ns);
+
+    for (size_t i = 0; i < nflushes; i++) {
+        uint32_t predicted = wireModelFlush(&calibrated, &flushes[i]) / 1000, measured = flushes[i].measured_us;
+        CHECK(predicted * 100 >= measured * (100 - WIRE_TOLERANCE_PERCENT) &&
+              predicted * 100 <= measured * (100 + WIRE_TOLERANCE_PERCENT),
+              "flush %u of %u lines: measured %u us, predicted %u", (unsigned)i, flushes[i].lines,
+              (unsigned)measured, (unsigned)predicted);
+    }
+    return checkDone();
+}
@@ -0,0 +1,38 @@
+/*
+ *  On-device benchmarks for the input and render pipeline.
+ *
+ *  Each case runs the real code paths on the target and prints one JSON
+ *  object per line tagged with the app version, so results can be collected
+ *  from the console log and compared between builds:
+ *    keys    key events through keymapTranslate -> render -> framebuffer
+ *    frame   framing a full frame, CPU time and modeled wire time
+ *    row     framing one text row (PSF_GLYPH_SIZE lines), same figures
+ *    blit    glyph rasterization throughput over the whole text grid
+ *    styles  blit with inverse, bold+underline and dim glyphs
+ *    scaled  2x and 3x glyphs over the whole grid
+ *    glyphs  multilingual text through the glyph store at several cache sizes
+ *    fbops   invert, XOR and line diff kernels against byte loops
+ *    rect    gfxFillRect() against the same rectangles drawn with setPixel()
+ *    rotate  blit at 0/90/180/270 degrees, with the font rotation time
+ *    editor  counted commands (10dd, 5w, 3p, 20j) against replaying them
+ *            one step per redraw and flush
+ *    search  exact and case-folded search throughput, and time to the
+ *            first match
+ *    isearch a pattern typed and erased a character at a time, narrowing
+ *            and widening match sets against rescanning for each prefix
+ *    spell   dictionary lookups per second over the prose sample's words,
+ *            and the first, cold pass over them
+ *    complete completions of every prefix of the same words, typed words
+ *            and dictionary together
+ *    lz      the saved document's block codec over prose: packed size,
+ *            pack and unpack throughput, one block unpacked on its own
+ *
+ *  Cases draw over the screen and use the editor's arena, so the console
+ *  runs them on the key task (console.h). The framebuffer, overlay layers,
+ *  rotation and glyph cache size are saved before and restored after, and
+ *  the whole panel is sent again.
+ */
+#pragma once
+
+/* Run one case by name, or all of them for NULL. Returns -1 for an unknown name. */
+int benchRun(const char *name);
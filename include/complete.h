@@ -0,0 +1,53 @@
+/*
+ *  Word completion from the words typed so far, those of the document
+ *  loaded at boot, and the dictionary.
+ *
+ *  Words go into a trie of nodes carved from an arena. Besides its
+ *  children, every node keeps the COMPLETE_TOP words below it (itself
+ *  included) typed most often. completeAdd() moves the word up those lists
+ *  along its own path, the only nodes whose ranking can change since counts
+ *  only grow. So a prefix's best words are read off the node it ends on:
+ *  one walk down, no search of the subtree, a few microseconds per key.
+ *
+ *  completeLookup() offers typed words first, most typed first, then the
+ *  dictionary's most frequent ones (spellComplete), without repeats. A
+ *  capitalized prefix also finds the dictionary's lowercase words, offered
+ *  capitalized.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "mem.h"
+#include "spell.h"
+
+/* Most nodes a trie gets, about 2000 words of prose */
+#define COMPLETE_NODES 8192
+#define COMPLETE_TOP 4
+/* Suggestions shown at a time */
+#define COMPLETE_SHOW 3
+
+typedef struct {
+    uint16_t child, sibling, parent;    /* node indices, 0 for none (0 is the root) */
+    uint16_t count;                     /* times the word ending here was typed */
+    uint16_t top[COMPLETE_TOP];         /* most typed words below, 0 for none */
+    uint8_t label;
+} CompleteNode_t;
+
+typedef struct {
+    uint8_t text[SPELL_WORD_MAX];
+    uint8_t len;
+} Completion_t;
+
+typedef struct {
+    CompleteNode_t *nodes;      /* nodes[0] is the root */
+    uint16_t used;
+    uint16_t size;
+} Complete_t;
+
+bool completeInit(Complete_t *c, MemArena_t *arena, uint16_t nodes);
+/* Count one more use of word; ignored once the trie is full */
+void completeAdd(Complete_t *c, const uint8_t *word, size_t len);
+/* Up to max words longer than prefix that start with it, best first */
+size_t completeLookup(const Complete_t *c, const uint8_t *prefix, size_t len, Completion_t *out, size_t max);
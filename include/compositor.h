@@ -0,0 +1,66 @@
+/*
+ *  Layer compositor: overlays above the document, combined at flush time.
+ *
+ *  The document is sharpmem_buffer, rendered by render.h as before. Overlay
+ *  layers (status bar, system menu) keep their own bitmaps and are laid
+ *  over it, in LayerId order, only when a scanline is framed for the panel
+ *  (compLine() is the LineSource of updateLines()). Nothing is written into
+ *  the document, so closing an overlay brings back what was underneath
+ *  without re-rendering it.
+ *
+ *  Placing, showing, hiding or drawing into a layer marks just the
+ *  scanlines it covers for the next renderFlush().
+ *
+ *  Layers are placed in panel coordinates, x and width in bytes (8 pixel
+ *  columns). compPutText() draws upright (landscape) cells.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sharp.h"
+#include "font.h"
+
+typedef enum {
+    LAYER_CURSOR,       /* text cursor, XOR, see cursor.h */
+    LAYER_STATUS,       /* status bar */
+    LAYER_MENU,         /* modal system menu, topmost */
+    LAYER_COUNT,
+} LayerId;
+
+typedef enum {
+    BLEND_COPY,         /* opaque */
+    BLEND_XOR,          /* ink in the layer inverts what is below */
+} LayerBlend;
+
+#define LAYER_CURSOR_BYTES FONT_GLYPH_BYTES
+#define LAYER_STATUS_BYTES (BYTES_PER_LINE * PSF_GLYPH_SIZE)
+#define LAYER_MENU_BYTES (BYTES_PER_LINE * PXHEIGHT / 2)
+
+typedef struct {
+    uint8_t *bits;      /* h lines of w bytes */
+    uint16_t capacity;
+    uint8_t x, w;       /* bytes */
+    uint16_t y, h;      /* scanlines */
+    uint8_t blend;
+    bool visible;
+} Layer_t;
+
+void compInit(void);
+/* Returns false if the layer does not fit its buffer or the panel. The
+ * menu's buffer is allocated by its first placing, so it costs no RAM
+ * until the menu is used. */
+bool compPlace(LayerId id, uint8_t x, uint16_t y, uint8_t w, uint16_t h, LayerBlend blend);
+void compShow(LayerId id, bool visible);
+bool compVisible(LayerId id);
+/* Fill the layer with background (white for COPY, clear for XOR) */
+void compClear(LayerId id);
+/* Text on the layer's own cell grid; returns the cells written */
+int compPutText(LayerId id, uint8_t col, uint8_t row, const char *s, uint16_t styles);
+/* Layer lines [y, y + h) changed */
+void compDamage(LayerId id, uint16_t y, uint16_t h);
+const Layer_t *compLayer(LayerId id);
+/* Layer bitmap to draw into directly, NULL until placed; follow with compDamage() */
+uint8_t *compBits(LayerId id);
+
+void compLine(uint16_t y, uint8_t *dst);
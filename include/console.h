@@ -0,0 +1,26 @@
+/*
+ *  Diagnostics console (REPL on the IDF console port).
+ *
+ *  Commands print the reports of the other modules on demand:
+ *    tasks   stack, queue and heap budget (tasks.h)
+ *    mem     arenas and static buffers (mem.h)
+ *    stats   display and input counters, "stats reset" (stats.h)
+ *    trace   event ring as Chrome trace JSON, "trace clear" (trace.h)
+ *    power   input bursts and the share of uptime at full clock (power.h)
+ *    glyphs  glyph store cache hits and misses, "glyphs reset" (glyphstore.h)
+ *    invert  display polarity, "invert on|off" (sharp.h)
+ *    wire    flush timing model and calibration (wire.h)
+ *    bench   pipeline benchmarks as JSON lines, "bench <case>" (bench.h)
+ *
+ *  The REPL runs on its own task. Commands that draw or use the editor's
+ *  state (bench, invert, wire cal, spell lookups) are handed to the key
+ *  task with keyTaskCall(), so they run between keys instead of racing it.
+ */
+#pragma once
+
+void consoleInit(void);
+/* Run fn(arg) on the key task between two keys and return once it has;
+ * the key task redraws and flushes after it. Runs fn right away before
+ * the key task starts, or from the key task itself. In sharp.c, with the
+ * key task. */
+void keyTaskCall(void (*fn)(void *arg), void *arg);
@@ -0,0 +1,29 @@
+/*
+ *  Text cursor on its own XOR layer (compositor.h).
+ *
+ *  The shape follows the mode: block in NORMAL, bar in INSERT, underline in
+ *  REPLACE, nothing when HIDDEN. The layer covers only the scanlines the
+ *  shape has ink on, so a blink sends 2 lines for an underline and the
+ *  document underneath is never redrawn.
+ *
+ *  Blinking is driven by the key task: it sleeps until cursorNextBlinkMs(),
+ *  calls cursorTick() and flushes. Typing keeps the cursor solid, and it
+ *  stops blinking (solid on) after CURSOR_BLINK_TIMEOUT_MS idle so the chip
+ *  can stay asleep. Blinks are counted in the display stats.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "sharp.h"
+
+#define CURSOR_BLINK_MS 530
+#define CURSOR_BLINK_TIMEOUT_MS (30 * 1000)
+
+/* Put the cursor at cur's cell in cur's mode */
+void cursorMove(const Cursor_t *cur);
+/* Input happened: cursor on, blink restarts after a pause */
+void cursorActivity(void);
+/* Toggle if a blink is due; true if the layer changed */
+bool cursorTick(void);
+/* Milliseconds until the next blink, 0 for none */
+uint32_t cursorNextBlinkMs(void);
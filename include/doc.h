@@ -0,0 +1,55 @@
+/*
+ *  Document text: UTF-8 in a gap buffer carved from an arena (mem.h).
+ *
+ *  Edits happen at the gap, so typing and deleting around one spot cost
+ *  nothing beyond the bytes themselves; moving the edit point copies the
+ *  bytes between the old and new positions once. The text is two
+ *  contiguous segments, before and after the gap, and readers that can
+ *  work on spans (search, save) should use docSegments() instead of
+ *  docByte(). Positions are byte offsets into the text.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "mem.h"
+
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t gap;         /* first byte of the gap */
+    size_t gap_end;     /* first byte after it */
+    uint32_t version;   /* bumped by every edit, so offsets held elsewhere can tell they are stale */
+} Doc_t;
+
+bool docInit(Doc_t *doc, MemArena_t *arena, size_t size);
+void docClear(Doc_t *doc);
+
+static inline size_t docLength(const Doc_t *doc) {
+    return doc->size - (doc->gap_end - doc->gap);
+}
+
+static inline uint8_t docByte(const Doc_t *doc, size_t pos) {
+    return doc->buf[pos < doc->gap ? pos : pos + (doc->gap_end - doc->gap)];
+}
+
+/* The text is a followed by b; either may be empty */
+void docSegments(const Doc_t *doc, const uint8_t **a, size_t *alen, const uint8_t **b, size_t *blen);
+
+/* Insert count copies of len bytes at pos. False if they do not fit. */
+bool docInsert(Doc_t *doc, size_t pos, const uint8_t *src, size_t len, uint32_t count);
+void docDelete(Doc_t *doc, size_t pos, size_t len);
+/* Copy up to len bytes from pos, returns the number copied */
+size_t docCopy(const Doc_t *doc, size_t pos, size_t len, uint8_t *dst);
+
+/* UTF-8 stepping: decode the codepoint at pos (0 at the end of the text),
+ * and the positions of the next and previous codepoints */
+uint32_t docCodepoint(const Doc_t *doc, size_t pos);
+size_t docNext(const Doc_t *doc, size_t pos);
+size_t docPrev(const Doc_t *doc, size_t pos);
+/* Start of the line holding pos, and the position of its '\n' (or the end) */
+size_t docLineStart(const Doc_t *doc, size_t pos);
+size_t docLineEnd(const Doc_t *doc, size_t pos);
+/* UTF-8 encode cp into out, returns the length */
+size_t docEncode(uint32_t cp, uint8_t out[4]);
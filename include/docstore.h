@@ -0,0 +1,64 @@
+/*
+ *  The document in flash, packed with the block codec (lz.h).
+ *
+ *  The "docs" partition is two slots, written in turn, so the last good
+ *  save survives one cut short by a reset or power loss. A slot is:
+ *
+ *    sector 0  header: magic "TWDS", version, sequence number, text length,
+ *              block count, edit point and top of screen, CRCs of the
+ *              header and index and of the data
+ *              index: blocks + 1 data offsets, bit 31 set for a block kept
+ *              as is because it did not pack
+ *    data      the blocks, from the second sector on
+ *
+ *  Every block but the last holds LZ_BLOCK bytes of text, and the valid
+ *  slot with the highest sequence number is the document. Loading unpacks
+ *  all of it into the gap buffer, since editing needs the whole text in
+ *  RAM anyway. Random access by block is deliberately left out of the
+ *  interface: the index would allow it (the block of any position is
+ *  pos / LZ_BLOCK, and each unpacks on its own), but with no paged loader
+ *  nothing would call it.
+ *
+ *  Saving goes a block at a time from docStoreStep(), between keys: pack,
+ *  erase the sectors it needs (only those, the packed size, not the
+ *  slot), write. The header is erased first and written last, so a slot
+ *  is valid only once all of it is. An edit during a save drops it, the
+ *  next idle time starts over. Packing cuts the flash written and erased
+ *  per save, and the time it takes, by about a third.
+ *
+ *  Everything is called from the task that owns the document, the key
+ *  task.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "doc.h"
+
+/* At most one autosave started per interval */
+#define DOCSTORE_INTERVAL_US (60 * 1000 * 1000LL)
+/* Blocks a slot's index has room for, 4 MB of text */
+#define DOCSTORE_BLOCKS_MAX 1000
+
+/* Find the partition and the current slot. Returns false (and saves
+ * nothing) without a "docs" partition. */
+bool docStoreInit(void);
+/* Replace doc with the saved document and return where editing was.
+ * False, and doc left empty, if there is none. */
+bool docStoreLoad(Doc_t *doc, size_t *point, size_t *top);
+/* Start saving doc if it changed since the last save and the interval
+ * allows. Returns 0 if started or nothing to do, else the ms after which
+ * to call again. */
+uint32_t docStoreAutosave(const Doc_t *doc, size_t point, size_t top);
+/* Tag for screen snapshots (resume.h): which save doc is a copy of. The
+ * save's sequence number, 0 without a "docs" partition or for an empty
+ * document with nothing saved, DOCSTORE_UNSAVED if doc differs from the
+ * last save. */
+#define DOCSTORE_UNSAVED 0xFFFFFFFFu
+uint32_t docStoreStamp(const Doc_t *doc);
+/* A save is in progress */
+bool docStoreBusy(void);
+/* Write the next block of it */
+void docStoreStep(const Doc_t *doc);
+void docStoreReport(void);
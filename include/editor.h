@@ -0,0 +1,136 @@
+/*
+ *  Modal text editor over a Doc_t, vi style.
+ *
+ *  INSERT types into the document, REPLACE overtypes, NORMAL runs commands:
+ *    h l j k w b e 0 $ G and the arrow/HOME/END keys move,
+ *    d y c take a motion or are doubled for whole lines (dd yy cc),
+ *    x D C p P i a I A o O R, ESC cancels a pending count or operator,
+ *    / and ? search forward and back, n N repeat it (search.h).
+ *  Commands are looked up in a table indexed by Virtual_Key (keymap.h), so
+ *  rebinding is an edit to that table.
+ *
+ *  A count runs as one document operation: 10dd is one delete of ten
+ *  lines, 3p one insert of three copies, 5w one walk of five words, and
+ *  3ifoo<ESC> inserts the repeats in one go. Nothing is drawn per key:
+ *  editorRedraw() lays out the screen from the document once per input
+ *  burst and diffs it against what is on the panel, so only changed cells
+ *  become render commands.
+ *
+ *  A search is typed on the status layer and runs as it is typed. It
+ *  ignores case unless the pattern has a capital, and scans in slices from
+ *  editorBackground(), so the cursor jumps to the first match, and visible
+ *  matches are highlighted, as soon as they are found rather than when the
+ *  whole document is scanned. Each typed character narrows the matches
+ *  already found and a backspace goes back to the previous set
+ *  (searchNarrow/searchWiden), so neither rescans the document; the shadow
+ *  diff then redraws only the cells whose highlight changed.
+ *
+ *  Words on screen are spell checked (spell.h) from editorBackground() once
+ *  the keys stop, a slice of words at a time, and misspelled ones drawn
+ *  underlined; the shadow diff sends only the cells whose underline
+ *  changed. A redraw only asks the cache, so a word is looked up once
+ *  however often it is drawn. The word being typed is left alone.
+ *
+ *  While typing, completions of the word before the cursor (complete.h)
+ *  are offered on the status layer and TAB takes the first. They are
+ *  looked up from editorBackground() too, after the burst's glyphs are on
+ *  the panel, and only the status rows are sent. Every correctly spelled
+ *  word typed is counted for the ranking; words the spelling cache does
+ *  not know yet wait for editorBackground() as well, so typing never
+ *  walks the dictionary in flash. A document loaded from flash is counted
+ *  too, a slice at a time once nothing else is waiting (editorSeeding()).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sharp.h"
+#include "doc.h"
+#include "keymap.h"
+#include "render.h"
+#include "search.h"
+#include "spell.h"
+#include "complete.h"
+
+#define EDITOR_MAX_COLS (PXWIDTH / 8)
+/* The document takes most of the arena; the rest is the editor's buffers
+ * and scratch for benchmarks */
+#define EDITOR_DOC_SIZE (DOC_ARENA_SIZE - 512 * 1024)
+#define EDITOR_YANK_MAX (64 * 1024)
+/* Longest insert that a count repeats */
+#define EDITOR_REPEAT_MAX 1024
+#define EDITOR_MATCHES_MAX 8192
+/* Words looked up per editorBackground() slice */
+#define EDITOR_SPELL_SLICE 16
+/* Typed words waiting to be checked and counted; more in one burst are not counted */
+#define EDITOR_LEARN_MAX 16
+/* Bytes of a loaded document counted for completion per editorBackground() slice */
+#define EDITOR_SEED_SLICE 4096
+/* Shadow cell not known to match the panel */
+#define EDITOR_UNKNOWN 0xFFFFFFFFu
+/* Shadow cell flags: drawn highlighted, drawn underlined as misspelled */
+#define EDITOR_MARK 0x80000000u
+#define EDITOR_BAD  0x40000000u
+#define EDITOR_FLAGS (EDITOR_MARK | EDITOR_BAD)
+
+typedef struct EdCommand EdCommand_t;
+
+typedef struct {
+    Doc_t doc;
+    Cursor_t *cur;          /* screen position and mode */
+    size_t point;           /* edit position, byte offset */
+    size_t top;             /* first byte on screen, start of a screen row */
+    uint32_t count;         /* count typed so far, 0 for none */
+    const EdCommand_t *op;  /* pending operator */
+    uint32_t op_count;
+    size_t insert_start;    /* text typed since entering INSERT, for counts */
+    uint8_t insert_tail;    /* bytes after point that belong to it (O) */
+    uint32_t insert_count;
+    uint8_t *yank;
+    size_t yank_len;
+    bool yank_lines;
+    uint8_t *repeat;
+    Search_t search;
+    uint8_t query[SEARCH_PATTERN_MAX];
+    uint8_t query_len;
+    bool prompt;            /* typing a search pattern */
+    size_t prompt_from;     /* point when the prompt opened */
+    bool forward;           /* direction of the last search */
+    bool highlight;
+    bool jump_pending;      /* move to the match nearest jump_from once found */
+    size_t jump_from;
+    size_t bottom;          /* first byte below the screen at the last layout */
+    bool spell_pending;     /* words on screen not checked yet */
+    /* Screen the last spelling pass finished, so it is not run again */
+    uint32_t spelled_version;
+    size_t spelled_top;
+    size_t spelled_typing;
+    uint16_t spelled_generation;
+    Complete_t complete;
+    Completion_t suggestion[COMPLETE_SHOW];
+    uint8_t suggestions;    /* on the status layer now */
+    uint8_t suggested;      /* bytes of the word they complete */
+    bool complete_pending;
+    uint8_t learn_text[EDITOR_LEARN_MAX][SPELL_WORD_MAX];
+    uint8_t learn_len[EDITOR_LEARN_MAX];
+    uint8_t learn_count;
+    size_t seeded;          /* the loaded text before this is counted for completion */
+    bool seeding;
+    uint32_t shadow[TEXT_MAX_ROWS][EDITOR_MAX_COLS];   /* codepoints on the panel */
+} Editor_t;
+
+/* Document and buffers come from arena. Starts in INSERT mode. */
+bool editorInit(Editor_t *ed, Cursor_t *cur, MemArena_t *arena, size_t doc_size);
+/* Put the edit point and screen back where they were, after loading a saved document */
+void editorRestore(Editor_t *ed, size_t point, size_t top);
+void editorKey(Editor_t *ed, const KeyInput_t *in);
+/* Lay out and queue the changed cells; the caller flushes. Updates ed->cur. */
+void editorRedraw(Editor_t *ed);
+/* Forget what is on the panel, the next redraw repaints every cell */
+void editorInvalidate(Editor_t *ed);
+/* Work left over from keys, like a search still scanning */
+bool editorBusy(const Editor_t *ed);
+/* Do a slice of it; true if the screen needs a redraw */
+bool editorBackground(Editor_t *ed);
+/* All that is left is counting a loaded document's words, which can wait a tick */
+bool editorSeeding(const Editor_t *ed);
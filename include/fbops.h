@@ -0,0 +1,29 @@
+/*
+ *  Whole-buffer kernels on packed framebuffer data.
+ *
+ *  Word-at-a-time C, and on the ESP32-S3 optionally the 128-bit PIE vector
+ *  unit for 16-byte aligned runs (the framebuffer is aligned for it). Both
+ *  paths are meant to give identical results; "bench fbops" checks them
+ *  against plain byte loops. The PIE path is off until that has been run on
+ *  hardware: define FBOPS_USE_PIE 1 on an S3 to build it.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "sharp.h"
+
+#ifndef FBOPS_USE_PIE
+#define FBOPS_USE_PIE 0
+#endif
+
+#define FBOPS_ALIGN 16
+
+/* dst = ~dst */
+void fbInvert(uint8_t *dst, size_t n);
+/* dst ^= src */
+void fbXor(uint8_t *dst, const uint8_t *src, size_t n);
+/* Set the bit of every scanline that differs between two full frames */
+void fbDiffLines(const uint8_t *a, const uint8_t *b, LineMask_t out);
+bool fbLineEqual(const uint8_t *a, const uint8_t *b);
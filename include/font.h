@@ -0,0 +1,68 @@
+/*
+ *  The text font in panel orientation.
+ *
+ *  Glyphs are 8x16 and stored as the panel will receive them, 16 bytes per
+ *  glyph: 16 lines of 1 byte for ROTATE_0/180, 8 lines of 2 bytes for
+ *  ROTATE_90/270. fontLoad() rotates the whole font once, so drawing a
+ *  rotated glyph is the same byte copy as an upright one.
+ *
+ *  Styles ride in the high byte of a glyph index (FONT_BOLD etc. OR'ed onto
+ *  the character) and are built on first use into a small cache of styled
+ *  glyphs, already rotated, so a styled glyph costs the same copy as a
+ *  plain one once drawn.
+ *
+ *  Scaled text works the same way: a 2x or 3x glyph covers scale x scale
+ *  cells and each cell is one tile of it, FONT_TILE(scale, tx, ty). Tiles
+ *  are expanded row by row through bit-doubling/tripling tables on a cache
+ *  miss.
+ *
+ *  Rotations are clockwise and turn the logical screen on the panel:
+ *  ROTATE_90 and ROTATE_270 give a 240x320 portrait screen.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef enum {
+    ROTATE_0,
+    ROTATE_90,
+    ROTATE_180,
+    ROTATE_270,
+} Rotation;
+
+#define FONT_GLYPHS 256
+#define FONT_GLYPH_BYTES 16
+
+/* Applied in this order, inverse last */
+#define FONT_BOLD       0x0100  /* ink smeared one pixel right */
+#define FONT_DIM        0x0200  /* ink masked with a checkerboard */
+#define FONT_UNDERLINE  0x0400  /* ink across the second-last row */
+#define FONT_INVERSE    0x0800
+#define FONT_STYLES     0x0F00
+
+#define FONT_MAX_SCALE  3
+#define FONT_TILE(scale, tx, ty) ((uint32_t)((scale) - 1) << 12 | (uint32_t)(tx) << 14 | (uint32_t)(ty) << 16)
+#define FONT_TILES      0x3F000
+/* Any Unicode codepoint, paged in from the glyph store (glyphstore.h) */
+#define FONT_CODEPOINT  0x80000000u
+#define FONT_CP_MASK    0x001FFFFF
+#define FONT_VARIANTS   (FONT_STYLES | FONT_TILES | FONT_CODEPOINT)
+
+#define FONT_STYLE_CACHE 64     /* styled glyphs and tiles, direct mapped */
+
+extern const uint8_t *font_glyphs;
+
+void fontLoad(Rotation rot);
+Rotation fontRotation(void);
+const uint8_t *fontStyled(uint32_t index);
+static inline const uint8_t *fontGlyph(uint32_t index) {
+    if (index & FONT_VARIANTS) return fontStyled(index);
+    return font_glyphs + (index & (FONT_GLYPHS - 1)) * FONT_GLYPH_BYTES;
+}
+
+/* Built-in glyph with styles, upright whatever the rotation */
+void fontUpright(uint16_t index, uint8_t *dst);
+/* Rotate one upright 8x16 bitmap (also used for cursor shapes) */
+void fontRotateGlyph(const uint8_t *src, uint8_t *dst, Rotation rot);
+/* 8x8 bit matrix, byte i = row i, LSB = column 0: returns the transpose */
+uint64_t fontTranspose8(uint64_t x);
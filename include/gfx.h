@@ -0,0 +1,30 @@
+/*
+ *  2D primitives on the packed framebuffer.
+ *
+ *  Spans are filled a byte at a time with edge masks for the partial bytes
+ *  at either end, so a rectangle costs about one memset per scanline rather
+ *  than a read-modify-write per pixel as with setPixel(). Everything is
+ *  clipped to the clip rectangle (the whole panel by default) and marks the
+ *  scanlines it touches for the next renderFlush().
+ *
+ *  These draw straight into sharpmem_buffer: call renderExecute() first if
+ *  glyphs queued before must end up underneath.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef enum {
+    GFX_BLACK,
+    GFX_WHITE,
+    GFX_INVERT,         /* XOR */
+} GfxColor;
+
+void gfxSetClip(int16_t x, int16_t y, int16_t w, int16_t h);
+void gfxResetClip(void);
+
+void gfxHLine(int16_t x, int16_t y, int16_t w, GfxColor color);
+void gfxVLine(int16_t x, int16_t y, int16_t h, GfxColor color);
+void gfxFillRect(int16_t x, int16_t y, int16_t w, int16_t h, GfxColor color);
+/* One pixel outline; with GFX_INVERT the corners are flipped once */
+void gfxRect(int16_t x, int16_t y, int16_t w, int16_t h, GfxColor color);
@@ -0,0 +1,42 @@
+/*
+ *  Paged glyph store for fonts too large to keep in RAM.
+ *
+ *  The "glyphs" flash partition holds an image built by tools/mkglyphs.py:
+ *
+ *    header    magic "TWGF", version, bytes per glyph (16), glyph count
+ *    index     count x uint32 codepoints, ascending
+ *    bitmaps   count x 16 bytes, 8x16 in the framebuffer format
+ *              (LSB first, 0 = ink), same as the built-in font
+ *
+ *  The partition is memory mapped; lookups binary search the index in
+ *  flash and copy the bitmap, rotated for the panel, into an LRU cache in
+ *  internal SRAM keyed by codepoint. Codepoints missing from the store
+ *  draw as '?'. Drawn through renderPutCodepoint(); styles and scaling only
+ *  apply to the built-in font.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GLYPH_CACHE_MAX 256
+#define GLYPH_CACHE_DEFAULT 128
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t not_found;
+} GlyphStoreStats_t;
+
+/* Map the partition. Returns false (and draws '?') if there is no valid image. */
+bool glyphStoreInit(void);
+const uint8_t *glyphStoreGet(uint32_t cp);
+/* Empty the cache, after a rotation change */
+void glyphStoreFlush(void);
+/* Cache capacity in glyphs, up to GLYPH_CACHE_MAX; flushes */
+void glyphStoreSetCacheSize(uint16_t n);
+uint16_t glyphStoreCacheSize(void);
+void glyphStoreGetStats(GlyphStoreStats_t *out);
+void glyphStoreResetStats(void);
+void glyphStoreReport(void);
@@ -0,0 +1,25 @@
+/*
+ *  Key event translation: raw key events from the queue to virtual keys and
+ *  font glyphs, tracking the modifier byte. Platform independent, the
+ *  keyboard tables themselves live in keymap.c.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    int vk;             /* Virtual_Key */
+    uint8_t glyph;      /* font index, printable keys only */
+    bool printable;
+    uint32_t codepoint; /* Unicode, printable keys only */
+} KeyInput_t;
+
+/* Returns true for a non-modifier key press, filling *in. Modifier events
+ * only update the modifier state; key releases are ignored. */
+bool keymapTranslate(uint8_t event, KeyInput_t *in);
+uint8_t keymapModifiers(void);
+/* Fill *in for a virtual key, as if it had been typed */
+void keymapFromVk(int vk, KeyInput_t *in);
+/* Built-in font index for a codepoint, -1 if the font lacks it */
+int keymapGlyph(uint32_t cp);
@@ -0,0 +1,42 @@
+/*
+ *  Block LZ codec for text kept in flash (docstore.h).
+ *
+ *  Text is cut into LZ_BLOCK byte blocks and each is packed on its own,
+ *  so any block can be unpacked without the ones before it and the RAM
+ *  needed is one block plus the match table, whatever the text's length.
+ *  The format is LZ4-style: a token byte with the literal count in its
+ *  high nibble and the match length - LZ_MIN_MATCH in its low one (15
+ *  means more length bytes follow, each adding up to 255), the literals,
+ *  then a 2-byte little-endian offset back into the block. The block's
+ *  last sequence has literals only. Unlike LZ4's block format, matches may
+ *  run to the very end of the block (LZ4 wants the last 5 bytes literal
+ *  and the last match 12 bytes before the end), so that last sequence can
+ *  be a lone token with no literals; a stock LZ4 decoder may refuse these
+ *  blocks, and lzUnpack() is what reads them.
+ *
+ *  Packing is greedy, one hash probe per position, and skips ahead faster
+ *  through bytes that do not match (numbers, tables), so it costs little
+ *  more than a copy. With the window only a block long, English prose
+ *  comes out at about three quarters of its size (host/data/prose.txt).
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LZ_BLOCK 4096
+#define LZ_MIN_MATCH 4
+#define LZ_HASH_BITS 11
+/* Largest packed block: all literals, plus the token and length bytes */
+#define LZ_BOUND(n) ((n) + (n) / 255 + 16)
+
+/* Match table, the only state; reset for every block */
+typedef struct {
+    uint16_t table[1 << LZ_HASH_BITS];  /* position + 1 of the last 4 bytes hashed here, 0 for none */
+} Lz_t;
+
+/* Pack n <= LZ_BLOCK bytes. Returns the packed size, 0 if it exceeds cap. */
+size_t lzPack(Lz_t *lz, const uint8_t *src, size_t n, uint8_t *dst, size_t cap);
+/* Unpack a block to exactly out bytes. False if src is corrupt. */
+bool lzUnpack(const uint8_t *src, size_t n, uint8_t *dst, size_t out);
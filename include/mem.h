@@ -0,0 +1,54 @@
+/*
+ *  Memory placement for display and editor data.
+ *
+ *  Long-lived memory is grabbed once at boot and carved up here, so nothing
+ *  on the hot paths calls malloc and multi-day sessions do not fragment the
+ *  heap:
+ *   - framebuffer and SPI line staging are static, DMA-capable internal SRAM
+ *     (see sharp.c), registered here only for the report,
+ *   - arenas are bump allocators over one block, in PSRAM for the document
+ *     and the editor's buffers (internal RAM if the board has no PSRAM).
+ *  Every arena tracks usage and its high-water mark for memReport().
+ *  Each arena has a single owning task; there is no locking.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    MEM_DMA,        /* internal, DMA-capable */
+    MEM_INTERNAL,   /* internal, CPU only */
+    MEM_PSRAM,      /* external RAM, falls back to internal */
+} MemPlacement;
+
+typedef struct {
+    const char *name;
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t high;
+    MemPlacement placement;
+} MemArena_t;
+
+#define MEM_MAX_REGIONS 16
+#define DOC_ARENA_SIZE (2 * 1024 * 1024)
+
+extern MemArena_t doc_arena;
+
+void memInit(void);
+
+bool memArenaInit(MemArena_t *arena, const char *name, size_t size, MemPlacement placement);
+void *memArenaAlloc(MemArena_t *arena, size_t size, size_t align);
+/* Arenas free in stack order: take a mark, release everything after it */
+size_t memArenaMark(const MemArena_t *arena);
+void memArenaRelease(MemArena_t *arena, size_t mark);
+
+/* Account for a statically placed buffer in the report */
+void memRegisterStatic(const char *name, size_t size, MemPlacement placement);
+/* A block kept for good, allocated when first needed and reported like the
+ * static ones. NULL if there is no room. */
+void *memPlace(const char *name, size_t size, MemPlacement placement);
+
+void memReport(void);
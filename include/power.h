@@ -0,0 +1,35 @@
+/*
+ *  Power manager tied to input activity.
+ *
+ *  The memory LCD keeps its image without refresh and VCOM runs from LEDC,
+ *  so between keystrokes nothing needs the CPU. With CONFIG_PM_ENABLE and
+ *  tickless idle the system drops to the minimum clock and enters automatic
+ *  light sleep whenever all tasks block. A key burst holds the CPU at full
+ *  clock from the first event until the render flush that follows the last
+ *  one. Wake sources are the timers already armed (VCOM maintenance in
+ *  software mode, cursor blink); the keyboard matrix scanner, once there is
+ *  one, adds its row lines with powerRegisterWakeGpio().
+ */
+#pragma once
+
+#include <stdint.h>
+#include "driver/gpio.h"
+
+typedef struct {
+    uint32_t bursts;        /* input bursts since boot */
+    uint64_t active_us;     /* time spent inside bursts */
+    uint64_t uptime_us;
+} PowerStats_t;
+
+void powerInit(void);
+
+/* Bracket a burst of input processing */
+void powerInputActive(void);
+void powerInputIdle(void);
+
+/* Let a keyboard line wake the chip from light sleep at the given level */
+void powerRegisterWakeGpio(gpio_num_t pin, int level);
+
+void powerGetStats(PowerStats_t *stats);
+/* Bursts, time in them against uptime, and the wake lines, for the console */
+void powerReport(void);
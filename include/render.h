@@ -0,0 +1,82 @@
+/*
+ *  Render command stream between the editor and the display.
+ *
+ *  The editor does not write into sharpmem_buffer directly. It emits compact
+ *  commands on the text cell grid (renderCols() x renderRows()) and the renderer
+ *  merges them before touching the framebuffer:
+ *   - commands fully overwritten by later ones (a glyph retyped, a clear
+ *     followed by a redraw) are dropped,
+ *   - glyph puts on the same text row are rasterized together,
+ *   - all scanlines touched since the last flush go out in one SPI burst.
+ *
+ *  Nothing reaches the panel until renderFlush().
+ *
+ *  The grid can be rotated (font.h): TEXT_COLS x TEXT_ROWS in landscape,
+ *  30 x 20 cells in portrait.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "sharp.h"
+#include "font.h"
+
+typedef enum {
+    RC_PUT_GLYPH,       /* glyph at (col,row) */
+    RC_CLEAR_SPAN,      /* len cells from (col,row) to background */
+    RC_INVERT_SPAN,     /* XOR len cells from (col,row) */
+    RC_SCROLL,          /* whole grid up by len text rows, bottom cleared */
+    RC_DRAW_CURSOR,     /* XOR cursor shape (arg) at (col,row) */
+    RC_DROPPED,         /* merged away, internal */
+} RenderOp;
+
+typedef enum {
+    CURSOR_BLOCK,
+    CURSOR_BAR,
+    CURSOR_UNDERLINE,
+} CursorShape;
+
+typedef struct {
+    uint8_t op;
+    uint8_t col;
+    uint8_t row;
+    uint8_t len;
+    uint32_t arg;       /* glyph index (font.h) or cursor shape */
+} RenderCmd_t;
+
+#define RENDER_QUEUE_LENGTH 128
+#define TEXT_MAX_ROWS (PXWIDTH / PSF_GLYPH_SIZE)   /* portrait */
+
+#ifndef RENDER_ROTATION
+#define RENDER_ROTATION ROTATE_0
+#endif
+
+void renderPutGlyph(uint8_t col, uint8_t row, uint16_t glyph);
+/* Unicode codepoint: ASCII from the built-in font, the rest from the glyph store */
+void renderPutCodepoint(uint8_t col, uint8_t row, uint32_t cp);
+/* Glyph at 2x or 3x, covering scale x scale cells from (col,row) down and
+ * right, clipped to the grid */
+void renderPutScaled(uint8_t col, uint8_t row, uint16_t glyph, uint8_t scale);
+void renderClearSpan(uint8_t col, uint8_t row, uint8_t len);
+void renderInvertSpan(uint8_t col, uint8_t row, uint8_t len);
+void renderScroll(uint8_t rows);
+void renderDrawCursor(uint8_t col, uint8_t row, CursorShape shape);
+/* Merge the queue and apply it to the framebuffer, accumulating dirty
+ * lines for the next renderFlush() */
+void renderExecute(void);
+void renderFlush(void);
+/* Scanlines drawn outside the command stream (gfx.h), sent by the next flush */
+void renderMarkLines(uint16_t y, uint16_t h);
+
+/* Switch the grid orientation. Drops queued commands and rotates the font;
+ * the framebuffer is left alone, clear or redraw it afterwards. */
+void renderSetRotation(Rotation rot);
+/* Where a cell lands on the panel: byte column x, first scanline y, w bytes
+ * by h scanlines */
+void renderCellGeometry(uint8_t col, uint8_t row, uint8_t *x, uint16_t *y, uint8_t *w, uint8_t *h);
+/* XOR mask for a cursor shape, h lines of w bytes as above */
+const uint8_t *renderCursorMask(CursorShape shape);
+uint8_t renderCols(void);
+uint8_t renderRows(void);
+
+/* Legacy single-glyph path: put + flush */
+void displayChar(uint8_t index, Cursor_t *cur);
@@ -0,0 +1,43 @@
+/*
+ *  Fast resume: put the last screen and cursor back before anything else.
+ *
+ *  A copy of the framebuffer, packed with the document's block codec
+ *  (lz.h), and the cursor position is kept in RTC memory (survives resets, panics and deep sleep) and,
+ *  less often, in an NVS blob (survives power loss). At boot:
+ *   - after a warm reset the panel is still powered and still shows the
+ *     frame, so it is left untouched and only the framebuffer is restored,
+ *   - after a cold boot the flash copy is decompressed and sent once,
+ *   - otherwise the panel is cleared as before.
+ *  NVS is only initialized when it is first needed.
+ *
+ *  A snapshot carries the docStoreStamp() of the document on screen. The
+ *  picture goes up before the document is loaded, and if the loaded one
+ *  has another stamp (edits after the last save were lost) the screen is
+ *  drawn again from it.
+ */
+#pragma once
+
+#include "sharp.h"
+
+typedef enum {
+    RESUME_NONE,        /* nothing to restore, panel must be cleared */
+    RESUME_WARM,        /* panel kept its image, framebuffer restored */
+    RESUME_FLASH,       /* framebuffer restored, panel needs a full refresh */
+} ResumeSource;
+
+/* Snapshot after this much input idle time */
+#define RESUME_IDLE_MS 2000
+/* At most one flash write per interval */
+#define RESUME_FLASH_INTERVAL_US (60 * 1000 * 1000LL)
+/* Largest packed frame kept. A screen full of text packs to about 4 KB
+ * (10 rows about 2.9 KB), so this leaves room for overlays and inverse
+ * text; the snapshot still fits the 8 KB of RTC slow memory. A frame that
+ * does not fit (pictures, noise) is not kept. */
+#define RESUME_MAX_PACKED 6656
+
+ResumeSource resumeBoot(Cursor_t *cur);
+/* docStoreStamp() of the document in the snapshot resumeBoot() restored */
+uint32_t resumeDocStamp(void);
+/* Refresh the RTC copy, and the flash copy if the interval allows. Returns 0
+ * when both are current, else the ms after which to call again. */
+uint32_t resumeSnapshot(const Cursor_t *cur, uint32_t doc_stamp);
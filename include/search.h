@@ -0,0 +1,99 @@
+/*
+ *  Text search over a Doc_t, in place on the two gap buffer segments.
+ *
+ *  Patterns of up to SEARCH_MEMCHR_MAX bytes are found with memchr() on
+ *  their first byte plus a compare; longer ones with Boyer-Moore-Horspool,
+ *  which skips up to the pattern length per step. Matches straddling the
+ *  gap are checked in a small stitched window, nothing else is copied.
+ *
+ *  Case-insensitive search folds ASCII and the accented Latin letters the
+ *  keyboard produces (Latin-1 and the Latin Extended-A pairs like Œ/œ, Š/š,
+ *  Ğ/ğ, Ł/ł, Ž/ž, plus Ÿ/ÿ). Bytes are folded through a table that can only merge more
+ *  than the real folding, and every hit is confirmed codepoint by codepoint.
+ *  Turkish İ and ı are matched as themselves.
+ *
+ *  The scan is incremental: searchStart() begins at a position, each
+ *  searchStep() scans a budget of bytes and appends what it finds, wrapping
+ *  once around the end. Matches before the wrap are ascending from the
+ *  start position, those after it ascending from 0, so the match nearest
+ *  the cursor is known after the first slice.
+ *
+ *  For search-as-you-type, searchNarrow() extends the pattern by filtering
+ *  the matches already found: every match of "abc" is a match of "ab" at
+ *  the same offset, so only those offsets are rechecked, and a scan still
+ *  in progress carries on with the longer pattern. The previous match set
+ *  stays below it on a stack in the same buffer, so searchWiden() (a
+ *  backspace) restores it, unfinished scan position included, without
+ *  touching the document. Going from ignoring case to not narrows too;
+ *  anything else starts over.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "doc.h"
+#include "mem.h"
+
+#define SEARCH_PATTERN_MAX 64
+#define SEARCH_MEMCHR_MAX 3
+/* Bytes scanned per searchStep() from the key task */
+#define SEARCH_SLICE (32 * 1024)
+#define SEARCH_NONE SIZE_MAX
+
+/* A match set kept below the current one */
+typedef struct {
+    uint8_t len;
+    bool fold;
+    bool wrapped;
+    bool running;
+    bool overflow;
+    size_t scan;
+    uint32_t count;
+    uint32_t wrap_index;
+} SearchLevel_t;
+
+typedef struct {
+    const Doc_t *doc;
+    uint32_t version;           /* doc->version the matches belong to */
+    uint8_t pat[SEARCH_PATTERN_MAX];
+    uint8_t folded[SEARCH_PATTERN_MAX];
+    uint8_t len;
+    bool fold;
+    uint8_t shift[256];         /* Horspool skip per (folded) byte */
+    size_t origin;              /* first window scanned */
+    size_t scan;                /* next window start */
+    bool wrapped;
+    bool running;
+    uint32_t *matches;          /* offsets in scan order, see above */
+    uint32_t count;
+    uint32_t wrap_index;        /* matches[wrap_index..] come after the wrap */
+    uint32_t capacity;
+    bool overflow;              /* more matches than capacity, the rest dropped */
+    uint32_t *stack;            /* the buffer matches sits at the top of */
+    uint32_t stack_size;
+    SearchLevel_t levels[SEARCH_PATTERN_MAX];
+    uint8_t depth;
+} Search_t;
+
+bool searchInit(Search_t *s, MemArena_t *arena, uint32_t capacity);
+/* Start a search for len bytes of UTF-8 from pos. False if the pattern is
+ * empty or longer than SEARCH_PATTERN_MAX. */
+bool searchStart(Search_t *s, const Doc_t *doc, const uint8_t *pat, size_t len, bool fold, size_t pos);
+/* Scan up to budget more bytes. Returns true while there is more to do. */
+bool searchStep(Search_t *s, size_t budget);
+void searchStop(Search_t *s);
+/* Extend the pattern to pat, which must start with the current one. False
+ * if the current matches cannot be narrowed; searchStart() instead. */
+bool searchNarrow(Search_t *s, const uint8_t *pat, size_t len, bool fold);
+/* Back to the kept match set for the first len bytes, false if there is none */
+bool searchWiden(Search_t *s, size_t len, bool fold);
+/* The matches still describe the document */
+bool searchValid(const Search_t *s);
+/* First match starting at or after pos (before pos if !forward, wrapping
+ * around), SEARCH_NONE if there is none so far */
+size_t searchFind(const Search_t *s, size_t pos, bool forward);
+/* First match starting in [from, to), SEARCH_NONE if none */
+size_t searchFirstIn(const Search_t *s, size_t from, size_t to);
+/* Case-fold one codepoint as described above */
+uint32_t searchFoldCp(uint32_t cp);
@@ -0,0 +1,82 @@
+/*
+ *  Sharp memory LCD driver (LS027B7DH01, 400x240 driven as 320x240).
+ *
+ *  The framebuffer is packed 8 pixels per byte, LSB first (the bus is
+ *  configured with SPI_DEVICE_TXBIT_LSBFIRST), 1 = white, 0 = black.
+ *  Scanlines are numbered from 0 here; the panel address sent on the wire
+ *  is scanline + 1.
+ *
+ *  Polarity is applied on the way out: with displaySetInverted() every line
+ *  is complemented as it is framed, so the framebuffer and the font stay
+ *  dark-on-light and switching costs one full refresh.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PXWIDTH 320
+#define PXHEIGHT 240
+#define BYTES_PER_LINE (PXWIDTH / 8)
+
+#define PSF_GLYPH_SIZE 16
+#define TEXT_COLS (PXWIDTH / 8)
+#define TEXT_ROWS (PXHEIGHT / PSF_GLYPH_SIZE)
+
+/* One bit per scanline, used to request partial refreshes */
+#define DIRTY_WORDS ((PXHEIGHT + 31) / 32)
+typedef uint32_t LineMask_t[DIRTY_WORDS];
+
+#define LINEMASK_SET(m, y)  ((m)[(y) >> 5] |= (1u << ((y) & 31)))
+#define LINEMASK_TEST(m, y) ((m)[(y) >> 5] & (1u << ((y) & 31)))
+
+typedef struct {
+    enum Mode {
+	HIDDEN,
+        NORMAL,
+	INSERT,
+	REPLACE
+    } mode;
+    uint8_t x;
+    uint8_t y;
+} Cursor_t;
+
+/* SPI clock for the panel */
+#ifndef SHARP_SPI_CLOCK_HZ
+#define SHARP_SPI_CLOCK_HZ (2 * 1000 * 1000)
+#endif
+/* CS is driven by hand: high this long before the first clock, low this
+ * long after the last (tsSCS / thSCS in the datasheet, with margin) */
+#define SHARP_CS_SETUP_US 6
+#define SHARP_CS_HOLD_US 2
+
+/* A line on the wire: [addr][BYTES_PER_LINE data][0x00] */
+#define SHARP_LINE_FRAME (BYTES_PER_LINE + 2)
+
+extern uint8_t *sharpmem_buffer;
+
+void displayInit(void);
+void clearDisplay(void);
+void clearDisplayBuffer(void);
+void refreshDisplay(void);
+void updateRow(uint8_t row);
+void updateLines(const LineMask_t dirty);
+void displayMaintainVcom(void);
+/* Light-on-dark when on; refreshes the whole panel on a change */
+void displaySetInverted(bool on);
+bool displayInverted(void);
+
+void setPixel(int16_t x, int16_t y, uint16_t color);
+uint8_t getPixel(uint16_t x, uint16_t y);
+
+/* Produces scanline y (BYTES_PER_LINE bytes) into dst */
+typedef void (*LineSource)(uint16_t y, uint8_t *dst);
+
+/* Frame the dirty lines from scanline *y on into dst, as many as fit in cap
+ * bytes, complemented if invert. Advances *y past the last line framed (to
+ * PXHEIGHT when done) and returns the bytes written. Command byte and
+ * trailer are up to the caller. Platform independent, see sharp_frame.c. */
+size_t sharpFrameLines(uint8_t *dst, size_t cap, LineSource line, const LineMask_t dirty, uint16_t *y, bool invert);
+/* LineSource for sharpmem_buffer alone */
+void sharpFramebufferLine(uint16_t y, uint8_t *dst);
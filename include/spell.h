@@ -0,0 +1,82 @@
+/*
+ *  Spell checking against dictionaries in flash.
+ *
+ *  The "dict" partition holds an image built by tools/mkdict.py:
+ *
+ *    header     magic "TWSD", version, language count, image size
+ *    directory  count x { code "en", root edge, edge offset, edges, words,
+ *                         ranked words, their trie and text offsets }
+ *    edges      per language, a minimal DAWG as uint32 edges
+ *    ranked     per language, optional: the most frequent words, a plain
+ *               trie of them and their text, for spellComplete()
+ *
+ *  An edge is its UTF-8 byte label (bits 0-7), a last-sibling flag, an
+ *  end-of-word flag and the index of its child's edge list (0 for none).
+ *  Sibling lists are sorted by label and shared between all words with the
+ *  same endings, which is what keeps a language to a few hundred KB. The
+ *  partition is memory mapped and walked in place, nothing is copied to
+ *  RAM: a lookup is one flash read per byte of the word plus the siblings
+ *  skipped on the way.
+ *
+ *  The ranked trie is coded like the DAWG, but every edge also carries the
+ *  ranks of the SPELL_COMPLETE_TOP most frequent words below it, so the
+ *  best completions of a prefix are read off the edge it ends on.
+ *
+ *  A word is known as written, with its first letter lowercased, or when
+ *  written in capitals as Capitalized or lowercase (PARIS, THE).
+ *  spellCheck() keeps results in a small cache keyed by a hash of the word,
+ *  so redraws ask spellCached() and only words never seen go to flash.
+ *  Without an image every word is known.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Longest word looked up, in bytes; longer ones count as known */
+#define SPELL_WORD_MAX 32
+/* Cached results, in sets of SPELL_CACHE_WAYS so the words of a screen
+ * rarely push each other out */
+#define SPELL_CACHE_SIZE 2048
+#define SPELL_CACHE_WAYS 4
+/* Completions kept per ranked trie edge, as in tools/mkdict.py */
+#define SPELL_COMPLETE_TOP 4
+
+enum { SPELL_UNKNOWN, SPELL_OK, SPELL_BAD };
+
+/* A dictionary word in flash */
+typedef struct {
+    const uint8_t *text;
+    uint8_t len;
+    uint16_t rank;      /* 0 is the most frequent */
+} SpellWord_t;
+
+typedef struct {
+    uint32_t lookups;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t bad;
+} SpellStats_t;
+
+/* Map the partition and select the first language. Returns false (and
+ * knows every word) if there is no valid image. */
+bool spellInit(void);
+/* Select a language by code ("en"); clears the cache. False if the image
+ * lacks it, the language stays as it was. */
+bool spellSetLanguage(const char *code);
+/* The selected code, "" for none */
+const char *spellLanguage(void);
+/* Changes whenever cached results are dropped */
+uint16_t spellGeneration(void);
+/* Walk the dictionary, no cache */
+bool spellLookup(const uint8_t *word, size_t len);
+/* Up to max of the most frequent words starting with prefix, best first,
+ * exactly as stored (prefix included). Returns how many. */
+size_t spellComplete(const uint8_t *prefix, size_t len, SpellWord_t *out, size_t max);
+/* SPELL_OK or SPELL_BAD, through the cache */
+int spellCheck(const uint8_t *word, size_t len);
+/* The cached result, SPELL_UNKNOWN if the word has not been checked */
+int spellCached(const uint8_t *word, size_t len);
+void spellReport(void);
+void spellResetStats(void);
@@ -0,0 +1,48 @@
+/*
+ *  Always-on performance counters for the display and input paths.
+ *
+ *  Plain increments on counters owned by one writer each (the flush path or
+ *  the key task), so keeping them costs a load/add/store. Read them with the
+ *  "stats" console command or the SYS key overlay; "stats reset" zeroes
+ *  them. Define STATS_ENABLED 0 to compile all of it out.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifndef STATS_ENABLED
+#define STATS_ENABLED 1
+#endif
+
+typedef struct {
+    uint32_t spi_bytes;
+    uint32_t spi_transactions;
+    uint32_t full_refreshes;
+    uint32_t partial_refreshes;
+    uint32_t lines_sent;
+    uint32_t lines_skipped;
+    uint32_t flush_us;          /* total time in updateLines() */
+    uint32_t flush_us_max;
+    uint32_t keys_received;
+    uint32_t keys_dropped;
+    uint32_t glyphs;            /* glyphs rasterized */
+    uint32_t raster_us;         /* time applying render commands (the old displayChar work) */
+    uint32_t blinks;            /* cursor blink toggles */
+    uint32_t blink_lines;       /* scanlines those toggles sent */
+} DisplayStats_t;
+
+extern DisplayStats_t display_stats;
+
+#if STATS_ENABLED
+#define STAT_ADD(field, n) (display_stats.field += (n))
+#define STAT_MAX(field, v) do { if ((v) > display_stats.field) display_stats.field = (v); } while (0)
+#else
+#define STAT_ADD(field, n) ((void)0)
+#define STAT_MAX(field, v) ((void)0)
+#endif
+#define STAT_INC(field) STAT_ADD(field, 1)
+
+void statsReset(void);
+void statsPrint(void);
+/* One status line of at most TEXT_COLS characters for the SYS overlay */
+int statsFormatLine(char *buf, int size);
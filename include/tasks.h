@@ -0,0 +1,62 @@
+/*
+ *  Static task and queue table with a memory budget report.
+ *
+ *  Every runtime task gets its stack and TCB from static storage declared
+ *  with TASK_STATIC() and is started from one table with tasksStart(). Queues
+ *  are registered so their fill level can be reported. tasksReport() prints
+ *  per-task stack high-water marks, per-queue high-water marks and free heap
+ *  per capability class, so stack sizes can be set from measured data.
+ *
+ *  Table tasks all run on TASKS_CORE. They are the ones that trace (trace.h),
+ *  and the cycle counter the trace is stamped with is per core, so events
+ *  from one task must not come from two counters.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+typedef struct {
+    const char *name;
+    TaskFunction_t fn;
+    uint32_t stack_size;        /* bytes */
+    UBaseType_t priority;
+    void *arg;
+    StackType_t *stack;
+    StaticTask_t *tcb;
+    TaskHandle_t handle;        /* NULL before start and after tasksExit() */
+} TaskSlot_t;
+
+typedef struct {
+    const char *name;
+    QueueHandle_t handle;
+    uint16_t length;
+    volatile uint16_t high;
+} QueueSlot_t;
+
+#define TASK_STATIC(var, stack_bytes) \
+    static StackType_t var##_stack[stack_bytes]; \
+    static StaticTask_t var##_tcb
+
+#define TASK_ENTRY(var, fn_, name_, prio_, arg_) \
+    { .name = name_, .fn = fn_, .stack_size = sizeof(var##_stack), .priority = prio_, \
+      .arg = arg_, .stack = var##_stack, .tcb = &var##_tcb }
+
+#define MAX_QUEUE_SLOTS 8
+/* The app core; core 0 keeps the WiFi/BT, esp_timer and console work */
+#define TASKS_CORE 1
+
+void tasksStart(TaskSlot_t *table, size_t n);
+void tasksRegisterQueue(QueueSlot_t *queue);
+/* Replaces vTaskDelete(NULL) for tasks in the table */
+void tasksExit(void);
+void tasksReport(void);
+
+/* Call after sending to keep the queue high-water mark */
+static inline void queueNoteDepth(QueueSlot_t *q) {
+    UBaseType_t n = uxQueueMessagesWaiting(q->handle);
+    if (n > q->high) q->high = n;
+}
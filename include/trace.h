@@ -0,0 +1,87 @@
+/*
+ *  Low-overhead event trace.
+ *
+ *  A fixed ring of 12-byte binary events stamped with the CPU cycle counter.
+ *  Recording is one atomic increment and three stores, so it can stay on
+ *  the key, render and SPI paths where printf used to be. "trace" on the
+ *  console dumps the ring as Chrome/Perfetto trace JSON (load it in
+ *  ui.perfetto.dev or chrome://tracing).
+ *
+ *  The cycle counter stops in light sleep and changes rate with DFS, so a
+ *  TRACE_SYNC event carrying esp_timer microseconds is recorded at the start
+ *  of every input burst; the CPU is at full clock inside bursts. Each core
+ *  has its own counter, so the tasks that trace run on TASKS_CORE
+ *  (tasks.h), and console commands that draw are run by the key task
+ *  (console.h). Task switches are not visible to application code on
+ *  ESP-IDF; tasks mark when they start and stop working instead
+ *  (TRACE_TASK_RUN/WAIT).
+ *
+ *  The Linux target (the host build, host/) stamps events with the
+ *  simulator's esp_timer clock in nanoseconds, so traces follow virtual time.
+ *  Define TRACE_ENABLED 0 to compile every trace point out.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#define TRACE_EVENTS 1024       /* power of two */
+
+typedef enum {
+    TRACE_SYNC,         /* arg32 = esp_timer time, us */
+    TRACE_TASK_RUN,     /* arg8 = task id */
+    TRACE_TASK_WAIT,    /* arg8 = task id */
+    TRACE_KEY,          /* arg8 = key event */
+    TRACE_RENDER,       /* arg8 = RenderOp, arg16 = row << 8 | col */
+    TRACE_FLUSH_BEGIN,  /* arg16 = dirty lines */
+    TRACE_FLUSH_END,
+    TRACE_SPI_BEGIN,    /* arg32 = bytes */
+    TRACE_SPI_END,
+} TraceType;
+
+enum { TRACE_TASK_KEYBOARD, TRACE_TASK_KEYSIMU };
+
+typedef struct {
+    uint32_t cycles;
+    uint32_t arg32;
+    uint8_t type;
+    uint8_t arg8;
+    uint16_t arg16;
+} TraceEvent_t;
+
+extern TraceEvent_t trace_ring[TRACE_EVENTS];
+extern uint32_t trace_head;
+
+#if CONFIG_IDF_TARGET_LINUX
+#include "esp_timer.h"
+static inline uint32_t traceNow(void) {
+    return (uint32_t)(esp_timer_get_time() * 1000);
+}
+#define TRACE_TICKS_PER_US 1000
+#else
+#include "esp_cpu.h"
+static inline uint32_t traceNow(void) {
+    return esp_cpu_get_cycle_count();
+}
+#define TRACE_TICKS_PER_US CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#endif
+
+static inline void trace(TraceType type, uint8_t arg8, uint16_t arg16, uint32_t arg32) {
+#if TRACE_ENABLED
+    TraceEvent_t *e = &trace_ring[__atomic_fetch_add(&trace_head, 1, __ATOMIC_RELAXED) & (TRACE_EVENTS - 1)];
+    e->cycles = traceNow();
+    e->arg32 = arg32;
+    e->type = type;
+    e->arg8 = arg8;
+    e->arg16 = arg16;
+#endif
+}
+
+void traceSync(void);
+void traceClear(void);
+/* Print the ring, oldest first, as Chrome trace JSON */
+void traceDumpJson(void);
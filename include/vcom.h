@@ -0,0 +1,40 @@
+/*
+ *  VCOM (panel common voltage) inversion for the Sharp memory LCD.
+ *
+ *  The panel needs its VCOM polarity inverted periodically or the liquid
+ *  crystal takes a DC bias. Two ways to do it, chosen at build time:
+ *
+ *  VCOM_MODE_LEDC      EXTCOMIN driven by an LEDC channel (EXTMODE tied high).
+ *                      A 50% square wave at VCOM_FREQ_HZ, kept alive in light
+ *                      sleep, costs no task, no stack and no wakeups.
+ *  VCOM_MODE_SOFTWARE  The VCOM bit travels in the command byte of every
+ *                      transfer (EXTMODE tied low). It flips with the first
+ *                      transfer half a half period or more after the last
+ *                      flip, so flushes carry it for free; an esp_timer
+ *                      checks every half period and only sends a 2-byte
+ *                      maintain command if a full one went by without a
+ *                      flip. Flips come half to two half periods apart.
+ */
+#pragma once
+
+#include <stdbool.h>
+
+#define VCOM_MODE_LEDC 0
+#define VCOM_MODE_SOFTWARE 1
+
+#ifndef VCOM_MODE
+#define VCOM_MODE VCOM_MODE_LEDC
+#endif
+
+/* LEDC on RC_FAST cannot divide down to 1 Hz with 14 bits of resolution;
+ * 2 Hz is well within the panel's EXTCOMIN range */
+#define VCOM_FREQ_HZ 2
+#define VCOM_HALF_PERIOD_US (1000000 / (2 * VCOM_FREQ_HZ))
+
+void vcomInit(void);
+
+/* Polarity to put in the next command byte, flipped if due (software mode,
+ * always false with LEDC). Call under the display lock, as the byte goes out. */
+bool vcomPhase(void);
+/* A half period went by without a flip: the timer sends one */
+bool vcomDue(void);
@@ -0,0 +1,49 @@
+/*
+ *  Timing model of the Sharp panel transport.
+ *
+ *  Predicts how long a flush holds the panel from what goes on the wire:
+ *  CS setup and hold delays, bytes at the SPI clock, and a fixed driver
+ *  cost per SPI transaction that overlaps the previous transfer when more
+ *  than one transaction can be queued. The flush stream is read back from
+ *  the trace ring (TRACE_FLUSH_* and TRACE_SPI_BEGIN events), so any
+ *  recorded session can be replayed against other clocks and queue depths.
+ *
+ *  Calibration replays the same stream through updateLines() on the
+ *  device, measures it and fits the per-transaction cost. Console:
+ *    wire                  recorded flushes, measured vs predicted
+ *    wire <hz> [depth]     predict the recorded stream at another setting
+ *    wire cal              replay, measure and fit
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define WIRE_MAX_TRANS 16       /* a full frame is 10 transactions */
+#define WIRE_MAX_FLUSHES 32
+
+typedef struct {
+    uint32_t clock_hz;
+    uint16_t cs_setup_us;
+    uint16_t cs_hold_us;
+    uint16_t trans_ns;          /* driver cost per transaction, calibrated */
+    uint8_t queue_depth;        /* 1 = spi_device_transmit() */
+} WireParams_t;
+
+typedef struct {
+    uint16_t lines;
+    uint8_t ntrans;
+    uint16_t bytes[WIRE_MAX_TRANS];
+    uint32_t measured_us;       /* from the trace or a replay, 0 if unknown */
+} WireFlush_t;
+
+extern WireParams_t wire_params;
+
+/* Predicted duration of one flush, CS edge to CS edge, in nanoseconds */
+uint32_t wireModelFlush(const WireParams_t *p, const WireFlush_t *f);
+/* Flushes recorded in the trace ring, oldest first */
+size_t wireCollect(WireFlush_t *out, size_t max);
+/* Print recorded flushes against the model with p */
+void wireReport(const WireParams_t *p);
+/* Replay the recorded stream (or standard shapes if none), fit trans_ns */
+void wireCalibrate(WireParams_t *p);
@@ -1,4 +1,4 @@
-unsigned char zap_vga16_psf[] = {
+const unsigned char zap_vga16_psf[] = {
   0xff, 0xff, 0x81, 0x3c, 0x66, 0x66, 0x30, 0x18, 0x18, 0x00, 0x18, 0x18,
   0x81, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x98, 0x99,
   0x99, 0x99, 0x99, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9f,
@@ -342,4 +342,4 @@ unsigned char zap_vga16_psf[] = {
   0xff, 0xff, 0xc9, 0xc9, 0xff, 0x9c, 0x9c, 0x9c, 0x9c, 0x9c, 0x9c, 0x81,
   0x9f, 0xcf, 0xe0, 0xff
 };
-unsigned int zap_vga16_psf_len = 4096;
+const unsigned int zap_vga16_psf_len = 4096;
@@ -0,0 +1,695 @@
+/*
+ *  On-device benchmarks. See bench.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_timer.h"
+#include "esp_app_desc.h"
+#include "sharp.h"
+#include "render.h"
+#include "keymap.h"
+#include "gfx.h"
+#include "glyphstore.h"
+#include "fbops.h"
+#include "compositor.h"
+#include "editor.h"
+#include "spell.h"
+#include "complete.h"
+#include "lz.h"
+#include "stats.h"
+#include "mem.h"
+#include "esp_heap_caps.h"
+#include "keyboard_input.h"
+
+#define BENCH_KEYS 4096
+#define BENCH_FRAMES 64
+#define BENCH_BLITS 16
+#define BENCH_RECTS 64
+#define BENCH_EDIT_LINES 400
+#define BENCH_EDIT_DOC (32 * 1024)
+#define BENCH_SEARCH_DOC (96 * 1024)
+#define BENCH_SEARCH_MATCHES 4096
+#define BENCH_SPELL 20000
+#define BENCH_COMPLETE 20000
+#define BENCH_LZ_TEXT (96 * 1024)
+#define BENCH_LZ_BLOCKS 256
+
+typedef struct {
+    const char *name;
+    void (*fn)(const char *name);
+} BenchCase_t;
+
+static void report(const char *name, uint32_t iters, int64_t us, const char *unit, uint32_t rate, const char *extra) {
+    printf("{\"bench\":\"%s\",\"version\":\"%s\",\"iters\":%" PRIu32 ",\"us\":%" PRId64 ",\"%s\":%" PRIu32 "%s}\n",
+           name, esp_app_get_description()->version, iters, us, unit, rate, extra ? extra : "");
+}
+
+static uint32_t perSecond(uint64_t n, int64_t us) {
+    return us > 0 ? (uint32_t)(n * 1000000 / us) : 0;
+}
+
+static void benchKeys(const char *name) {
+    uint8_t events[KEY_MASK + 1];
+    size_t nevents = 0;
+    KeyInput_t in;
+    uint8_t col = 0, row = 0;
+
+    /* Every key code that produces a glyph without modifiers */
+    for (uint8_t k = 0; k <= KEY_MASK; k++)
+        if (keymapTranslate(KEYDOWN_MASK | k, &in) && in.printable) events[nevents++] = KEYDOWN_MASK | k;
+    if (!nevents) return;
+
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_KEYS; i++) {
+        if (keymapTranslate(events[i % nevents], &in) && in.printable) {
+            renderPutGlyph(col, row, in.glyph);
+            if (++col == renderCols()) {
+                col = 0;
+                if (++row == renderRows()) row = 0;
+            }
+        }
+    }
+    renderExecute();
+    int64_t dt = esp_timer_get_time() - t0;
+    report(name, BENCH_KEYS, dt, "keys_per_s", perSecond(BENCH_KEYS, dt), NULL);
+}
+
+/* Framing only: the wire time is what the bytes take at SHARP_SPI_CLOCK_HZ */
+static void benchFraming(const char *name, const LineMask_t lines) {
+    const size_t cap = PXHEIGHT * SHARP_LINE_FRAME;
+    uint8_t *stage = malloc(cap);
+    size_t bytes = 0;
+    char extra[64];
+
+    if (!stage) return;
+
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        uint16_t y = 0;
+        bytes = 1 + sharpFrameLines(stage, cap, compLine, lines, &y, displayInverted()) + 1;
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+    free(stage);
+    uint32_t wire_us = (uint32_t)((uint64_t)bytes * 8 * 1000000 / SHARP_SPI_CLOCK_HZ);
+    snprintf(extra, sizeof(extra), ",\"bytes\":%u,\"cpu_us\":%" PRIu32 ",\"wire_us\":%" PRIu32,
+             (unsigned)bytes, (uint32_t)(dt / BENCH_FRAMES), wire_us);
+    report(name, BENCH_FRAMES, dt, "per_s", perSecond(BENCH_FRAMES, dt), extra);
+}
+
+static void benchFrame(const char *name) {
+    LineMask_t all;
+    memset(all, 0xff, sizeof(all));
+    benchFraming(name, all);
+}
+
+static void benchRow(const char *name) {
+    LineMask_t rows = {0};
+    for (uint8_t i = 0; i < PSF_GLYPH_SIZE; i++) LINEMASK_SET(rows, i);
+    benchFraming(name, rows);
+}
+
+static void blit(const char *name, const char *extra_in, uint16_t styles) {
+    const uint32_t glyphs = BENCH_BLITS * renderCols() * renderRows();
+    char extra[64];
+
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_BLITS; i++) {
+        for (uint8_t row = 0; row < renderRows(); row++)
+            for (uint8_t col = 0; col < renderCols(); col++)
+                renderPutGlyph(col, row, ((i + row * renderCols() + col) & 0xff) | styles);
+        renderExecute();
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+    snprintf(extra, sizeof(extra), "%s,\"kbytes_per_s\":%" PRIu32, extra_in,
+             perSecond((uint64_t)glyphs * PSF_GLYPH_SIZE, dt) / 1024);
+    report(name, glyphs, dt, "glyphs_per_s", perSecond(glyphs, dt), extra);
+}
+
+static void benchBlit(const char *name) {
+    blit(name, "", 0);
+}
+
+/* The first pass of each style fills the style cache */
+static void benchStyles(const char *name) {
+    static const uint16_t styles[] = { FONT_INVERSE, FONT_BOLD | FONT_UNDERLINE, FONT_DIM };
+    char extra[32];
+
+    for (size_t i = 0; i < sizeof(styles) / sizeof(styles[0]); i++) {
+        snprintf(extra, sizeof(extra), ",\"styles\":%u", styles[i] >> 8);
+        blit(name, extra, styles[i]);
+    }
+}
+
+/* The same blit at every rotation, including the one-off font rotation */
+static void benchRotate(const char *name) {
+    Rotation was = fontRotation();
+    char extra[32];
+
+    for (int rot = ROTATE_0; rot <= ROTATE_270; rot++) {
+        int64_t t0 = esp_timer_get_time();
+        renderSetRotation(rot);
+        snprintf(extra, sizeof(extra), ",\"degrees\":%d,\"load_us\":%" PRId64, rot * 90, esp_timer_get_time() - t0);
+        blit(name, extra, 0);
+    }
+    renderSetRotation(was);
+}
+
+/* Whole grid in 2x and 3x glyphs; every tile misses the style cache */
+static void benchScaled(const char *name) {
+    char extra[48];
+
+    for (uint8_t scale = 2; scale <= FONT_MAX_SCALE; scale++) {
+        uint32_t glyphs = 0;
+        int64_t t0 = esp_timer_get_time();
+        for (uint32_t i = 0; i < BENCH_BLITS; i++) {
+            for (uint8_t row = 0; row + scale <= renderRows(); row += scale)
+                for (uint8_t col = 0; col + scale <= renderCols(); col += scale, glyphs++)
+                    renderPutScaled(col, row, (i + row * renderCols() + col) & 0xff, scale);
+            renderExecute();
+        }
+        int64_t dt = esp_timer_get_time() - t0;
+        snprintf(extra, sizeof(extra), ",\"scale\":%u,\"tiles_per_s\":%" PRIu32, scale,
+                 perSecond((uint64_t)glyphs * scale * scale, dt));
+        report(name, glyphs, dt, "glyphs_per_s", perSecond(glyphs, dt), extra);
+    }
+}
+
+/* Mixed-script text, more distinct glyphs than the smaller cache sizes hold */
+static const char multilingual[] =
+    "Καλημέρα κόσμε, ξεσκεπάζω την ψυχοφθόρα βδελυγμία. "
+    "Съешь же ещё этих мягких французских булок, да выпей чаю. "
+    "Ελληνικά και русский: ΑΒΓΔΕΖΗΘ АБВГДЕЖЗ ←↑→↓ ★☆ ♠♣♥♦ ∀∃∈∑√∞ ";
+
+static const char *utf8Next(const char *s, uint32_t *cp) {
+    uint8_t c = *s++;
+    int more = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : 0;
+    *cp = more ? c & (0x3F >> more) : c;
+    while (more-- && (*s & 0xC0) == 0x80) *cp = (*cp << 6) | (*s++ & 0x3F);
+    return s;
+}
+
+static void benchGlyphs(const char *name) {
+    static const uint16_t sizes[] = { 16, 32, 64, 128, 256 };
+    GlyphStoreStats_t st;
+    char extra[96];
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        uint32_t glyphs = 0;
+        uint8_t col = 0, row = 0;
+        glyphStoreSetCacheSize(sizes[k]);
+        glyphStoreResetStats();
+        int64_t t0 = esp_timer_get_time();
+        for (uint32_t i = 0; i < BENCH_BLITS; i++) {
+            for (const char *s = multilingual; *s; glyphs++) {
+                uint32_t cp;
+                s = utf8Next(s, &cp);
+                renderPutCodepoint(col, row, cp);
+                if (++col == renderCols()) {
+                    col = 0;
+                    if (++row == renderRows()) row = 0;
+                }
+            }
+            renderExecute();
+        }
+        int64_t dt = esp_timer_get_time() - t0;
+        glyphStoreGetStats(&st);
+        snprintf(extra, sizeof(extra), ",\"cache\":%u,\"hits\":%" PRIu32 ",\"misses\":%" PRIu32 ",\"not_found\":%" PRIu32,
+                 sizes[k], st.hits, st.misses, st.not_found);
+        report(name, glyphs, dt, "glyphs_per_s", perSecond(glyphs, dt), extra);
+    }
+}
+
+/* Each kernel against a plain byte loop on a copy of the frame; "same"
+ * says whether both left identical bytes */
+static void benchFbops(const char *name) {
+    const size_t n = PXWIDTH * PXHEIGHT / 8;
+    uint8_t *a = heap_caps_aligned_alloc(FBOPS_ALIGN, n, MALLOC_CAP_INTERNAL);
+    uint8_t *b = heap_caps_aligned_alloc(FBOPS_ALIGN, n, MALLOC_CAP_INTERNAL);
+    uint8_t *ref = heap_caps_aligned_alloc(FBOPS_ALIGN, n, MALLOC_CAP_INTERNAL);
+    char extra[64];
+    LineMask_t diff;
+
+    if (!a || !b || !ref) {
+        heap_caps_free(a);
+        heap_caps_free(b);
+        heap_caps_free(ref);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) b[i] = sharpmem_buffer[i] ^ (uint8_t)(i * 131);
+
+    for (int k = 0; k < 3; k++) {
+        static const char *const kernels[] = { "invert", "xor", "diff" };
+        memcpy(a, sharpmem_buffer, n);
+        memcpy(ref, sharpmem_buffer, n);
+        bool same = true;
+
+        int64_t t0 = esp_timer_get_time();
+        for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+            if (k == 0) fbInvert(a, n);
+            else if (k == 1) fbXor(a, b, n);
+            else fbDiffLines(a, b, diff);
+        }
+        int64_t dt = esp_timer_get_time() - t0;
+
+        int64_t t1 = esp_timer_get_time();
+        for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+            if (k == 0) for (size_t j = 0; j < n; j++) ref[j] = ~ref[j];
+            else if (k == 1) for (size_t j = 0; j < n; j++) ref[j] ^= b[j];
+            else for (uint16_t y = 0; y < PXHEIGHT; y++)
+                if ((memcmp(ref + y * BYTES_PER_LINE, b + y * BYTES_PER_LINE, BYTES_PER_LINE) != 0) != !!LINEMASK_TEST(diff, y))
+                    same = false;
+        }
+        int64_t dt_byte = esp_timer_get_time() - t1;
+
+        if (k < 2) same = memcmp(a, ref, n) == 0;
+        snprintf(extra, sizeof(extra), ",\"kernel\":\"%s\",\"byte_us\":%" PRId64 ",\"same\":%s",
+                 kernels[k], dt_byte, same ? "true" : "false");
+        report(name, BENCH_FRAMES, dt, "frames_per_s", perSecond(BENCH_FRAMES, dt), extra);
+    }
+    heap_caps_free(a);
+    heap_caps_free(b);
+    heap_caps_free(ref);
+}
+
+/* Filled rectangles through gfx against the same pixels with setPixel() */
+static void benchRect(const char *name) {
+    const int16_t w = 123, h = 45;
+    char extra[64];
+
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_RECTS; i++) gfxFillRect(i % 64 + 3, i % 32 + 5, w, h, i & 1);
+    int64_t dt = esp_timer_get_time() - t0;
+
+    int64_t t1 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_RECTS; i++)
+        for (int16_t y = i % 32 + 5; y < i % 32 + 5 + h; y++)
+            for (int16_t x = i % 64 + 3; x < i % 64 + 3 + w; x++) setPixel(x, y, i & 1);
+    int64_t dt_pixel = esp_timer_get_time() - t1;
+
+    snprintf(extra, sizeof(extra), ",\"setpixel_us\":%" PRId64 ",\"mpixels_per_s\":%" PRIu32,
+             dt_pixel, perSecond((uint64_t)BENCH_RECTS * w * h, dt) / 1000000);
+    report(name, BENCH_RECTS, dt, "rects_per_s", perSecond(BENCH_RECTS, dt), extra);
+}
+
+/* A counted command against the same work typed one step at a time, each
+ * step laid out and flushed as the key task would */
+typedef struct {
+    const char *setup;      /* untimed, from NORMAL mode */
+    const char *counted;
+    const char *step;
+    uint8_t steps;
+} EditCase_t;
+
+static const EditCase_t edit_cases[] = {
+    { "1G", "10dd", "dd", 10 },
+    { "1G", "5w", "w", 5 },
+    { "1Gyy", "3p", "p", 3 },
+    { "1G", "20j", "j", 20 },
+};
+
+/* ASCII keys, with ESC as \033 */
+static void feed(Editor_t *ed, const char *keys) {
+    KeyInput_t in;
+    for (; *keys; keys++) {
+        keymapFromVk(*keys == '\033' ? VK_ESC : *keys - ' ' + VKCHAROFFSET, &in);
+        editorKey(ed, &in);
+    }
+}
+
+static void editReset(Editor_t *ed, const char *setup) {
+    char line[48];
+    docClear(&ed->doc);
+    for (uint32_t i = 0; i < BENCH_EDIT_LINES; i++) {
+        int n = snprintf(line, sizeof(line), "line %03" PRIu32 ": the quick brown fox jumps\n", i);
+        docInsert(&ed->doc, docLength(&ed->doc), (const uint8_t *)line, n, 1);
+    }
+    ed->point = ed->top = 0;
+    feed(ed, "\033");
+    feed(ed, setup);
+    editorRedraw(ed);
+    renderFlush();
+}
+
+/* Time the keys plus redraw and flush; *lines gets the scanlines sent */
+static int64_t editRun(Editor_t *ed, const char *keys, uint8_t times, uint32_t *lines) {
+    uint32_t sent = display_stats.lines_sent;
+    int64_t t0 = esp_timer_get_time();
+    for (uint8_t i = 0; i < times; i++) {
+        feed(ed, keys);
+        editorRedraw(ed);
+        renderFlush();
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+    *lines = display_stats.lines_sent - sent;
+    return dt;
+}
+
+static void benchEditor(const char *name) {
+    size_t mark = memArenaMark(&doc_arena);
+    Editor_t *ed = malloc(sizeof(Editor_t));
+    Cursor_t cur = { 0 };
+    char extra[96];
+
+    if (!ed || !editorInit(ed, &cur, &doc_arena, BENCH_EDIT_DOC)) {
+        free(ed);
+        memArenaRelease(&doc_arena, mark);
+        return;
+    }
+    for (size_t i = 0; i < sizeof(edit_cases) / sizeof(edit_cases[0]); i++) {
+        const EditCase_t *c = &edit_cases[i];
+        uint32_t lines, replay_lines;
+        editReset(ed, c->setup);
+        int64_t dt = editRun(ed, c->counted, 1, &lines);
+        editReset(ed, c->setup);
+        int64_t dt_replay = editRun(ed, c->step, c->steps, &replay_lines);
+        snprintf(extra, sizeof(extra), ",\"cmd\":\"%s\",\"lines\":%" PRIu32 ",\"replay_lines\":%" PRIu32,
+                 c->counted, lines, replay_lines);
+        report(name, c->steps, dt, "replay_us", (uint32_t)dt_replay, extra);
+    }
+    free(ed);
+    memArenaRelease(&doc_arena, mark);
+}
+
+static const char prose[] =
+    "The quick brown fox jumps over the lazy dog. \u00c9l dijo que la ni\u00f1a "
+    "com\u00eda pi\u00f1a en la \u00e9poque des ma\u00eetres; \u0152uvre, "
+    "\u00c5se og \u00f8l p\u00e5 hytta.\n";
+
+/* The prose document for the search cases, gap in the middle */
+static bool proseDoc(Doc_t *doc, Search_t *search) {
+    if (!docInit(doc, &doc_arena, BENCH_SEARCH_DOC) || !searchInit(search, &doc_arena, BENCH_SEARCH_MATCHES))
+        return false;
+    while (docInsert(doc, docLength(doc), (const uint8_t *)prose, sizeof(prose) - 1, 1));
+    docInsert(doc, docLength(doc) / 2, (const uint8_t *)"", 0, 1);
+    return true;
+}
+
+/* Throughput over prose, and how soon the first match from mid-document
+ * turns up */
+static void benchSearch(const char *name) {
+    static const struct { const char *pat; bool fold; } pats[] = {
+        { "fox", false }, { "hytta.\nThe", false }, { "lazy dog. \u00c9l dijo", false },
+        { "\u00e9poque", true }, { "\u0153UVRE", true }, { "zzzz", true },
+    };
+    size_t mark = memArenaMark(&doc_arena);
+    Doc_t doc;
+    Search_t search;
+    char extra[96];
+
+    if (!proseDoc(&doc, &search)) {
+        memArenaRelease(&doc_arena, mark);
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(pats) / sizeof(pats[0]); i++) {
+        size_t len = strlen(pats[i].pat);
+        int64_t first_us = -1;
+        int64_t t0 = esp_timer_get_time();
+        searchStart(&search, &doc, (const uint8_t *)pats[i].pat, len, pats[i].fold, docLength(&doc) / 3);
+        while (searchStep(&search, SEARCH_SLICE))
+            if (first_us < 0 && search.count) first_us = esp_timer_get_time() - t0;
+        int64_t dt = esp_timer_get_time() - t0;
+        if (first_us < 0 && search.count) first_us = dt;
+        snprintf(extra, sizeof(extra), ",\"len\":%u,\"fold\":%d,\"matches\":%" PRIu32 ",\"first_us\":%" PRId64,
+                 (unsigned)len, pats[i].fold, search.count, first_us);
+        report(name, docLength(&doc), dt, "kbytes_per_s", perSecond(docLength(&doc), dt) / 1024, extra);
+    }
+    memArenaRelease(&doc_arena, mark);
+}
+
+/* Search-as-you-type: a pattern typed a character at a time and erased
+ * again, narrowing and widening the kept match sets against rescanning the
+ * document for every prefix */
+static void benchIsearch(const char *name) {
+    static const char typed[] = "the lazy dog";
+    const size_t n = sizeof(typed) - 1;
+    size_t mark = memArenaMark(&doc_arena);
+    size_t from;
+    Doc_t doc;
+    Search_t search;
+    char extra[96];
+
+    if (!proseDoc(&doc, &search)) {
+        memArenaRelease(&doc_arena, mark);
+        return;
+    }
+    from = docLength(&doc) / 3;
+
+    int64_t t0 = esp_timer_get_time();
+    for (size_t len = 1; len <= n; len++) {
+        searchStart(&search, &doc, (const uint8_t *)typed, len, true, from);
+        while (searchStep(&search, SEARCH_SLICE));
+    }
+    for (size_t len = n - 1; len >= 1; len--) {
+        searchStart(&search, &doc, (const uint8_t *)typed, len, true, from);
+        while (searchStep(&search, SEARCH_SLICE));
+    }
+    int64_t dt_rescan = esp_timer_get_time() - t0;
+
+    t0 = esp_timer_get_time();
+    searchStart(&search, &doc, (const uint8_t *)typed, 1, true, from);
+    while (searchStep(&search, SEARCH_SLICE));
+    int64_t dt_first = esp_timer_get_time() - t0;
+    for (size_t len = 2; len <= n; len++) {
+        if (!searchNarrow(&search, (const uint8_t *)typed, len, true))
+            searchStart(&search, &doc, (const uint8_t *)typed, len, true, from);
+        while (searchStep(&search, SEARCH_SLICE));
+    }
+    int64_t dt_narrow = esp_timer_get_time() - t0;
+    for (size_t len = n - 1; len >= 1; len--) {
+        if (!searchWiden(&search, len, true))
+            searchStart(&search, &doc, (const uint8_t *)typed, len, true, from);
+        while (searchStep(&search, SEARCH_SLICE));
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+
+    snprintf(extra, sizeof(extra), ",\"first_us\":%" PRId64 ",\"narrow_us\":%" PRId64 ",\"widen_us\":%" PRId64,
+             dt_first, dt_narrow - dt_first, dt - dt_narrow);
+    report(name, 2 * n - 1, dt, "rescan_us", (uint32_t)dt_rescan, extra);
+    memArenaRelease(&doc_arena, mark);
+}
+
+/* The words of the prose sample */
+static uint32_t proseWords(const uint8_t **words, uint8_t *lens, uint32_t max) {
+    uint32_t n = 0;
+    for (const char *p = prose; *p && n < max;) {
+        size_t len = strcspn(p, " .,;\n");
+        if (len) {
+            words[n] = (const uint8_t *)p;
+            lens[n++] = len;
+        }
+        p += len ? len : 1;
+    }
+    return n;
+}
+
+/* Dictionary lookups of the words of the prose sample, straight from flash
+ * without the cache, cold for the first pass over them */
+static void benchSpell(const char *name) {
+    const uint8_t *words[64];
+    uint8_t lens[64];
+    uint32_t n = proseWords(words, lens, 64), unknown = 0, bytes = 0;
+    char extra[96];
+
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < n; i++) unknown += !spellLookup(words[i], lens[i]);
+    int64_t dt_first = esp_timer_get_time() - t0;
+
+    t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_SPELL; i++) {
+        spellLookup(words[i % n], lens[i % n]);
+        bytes += lens[i % n];
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+
+    snprintf(extra, sizeof(extra), ",\"lang\":\"%s\",\"words\":%" PRIu32 ",\"unknown\":%" PRIu32 ",\"first_us\":%" PRId64 ",\"bytes\":%" PRIu32,
+             spellLanguage(), n, unknown, dt_first, bytes);
+    report(name, BENCH_SPELL, dt, "lookups_per_s", perSecond(BENCH_SPELL, dt), extra);
+}
+
+/* Completions per keystroke: every prefix of the prose words against a trie
+ * that has seen each of them typed, plus the dictionary's */
+static void benchComplete(const char *name) {
+    const uint8_t *words[64];
+    uint8_t lens[64];
+    uint32_t n = proseWords(words, lens, 64), offered = 0, lookups = 0;
+    size_t mark = memArenaMark(&doc_arena);
+    Complete_t trie;
+    Completion_t out[COMPLETE_SHOW];
+    char extra[96];
+
+    if (!completeInit(&trie, &doc_arena, COMPLETE_NODES)) {
+        memArenaRelease(&doc_arena, mark);
+        return;
+    }
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < n; i++) completeAdd(&trie, words[i], lens[i]);
+    int64_t dt_add = esp_timer_get_time() - t0;
+
+    t0 = esp_timer_get_time();
+    while (lookups < BENCH_COMPLETE) {
+        for (uint32_t i = 0; i < n; i++)
+            for (uint8_t len = 1; len <= lens[i]; len++, lookups++)
+                offered += completeLookup(&trie, words[i], len, out, COMPLETE_SHOW);
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+
+    snprintf(extra, sizeof(extra), ",\"words\":%" PRIu32 ",\"nodes\":%u,\"add_us\":%" PRId64 ",\"offered\":%" PRIu32,
+             n, trie.used, dt_add, offered);
+    report(name, lookups, dt, "lookups_per_s", perSecond(lookups, dt), extra);
+    memArenaRelease(&doc_arena, mark);
+}
+
+/* Prose of the sample's words in random order, so it does not simply
+ * repeat, with sentences and lines */
+static void proseText(uint8_t *text, size_t size) {
+    const uint8_t *words[64];
+    uint8_t lens[64];
+    uint32_t n = proseWords(words, lens, 64), seed = 2463534242u;
+    size_t len = 0;
+    while (len < size) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        uint32_t w = seed % n;
+        const char *sep = (seed >> 24) < 6 ? ".\n" : (seed >> 24) < 30 ? ". " : " ";
+        for (size_t i = 0; i < lens[w] && len < size; i++) text[len++] = words[w][i];
+        for (; *sep && len < size; sep++) text[len++] = *sep;
+    }
+}
+
+/* The document codec over prose: packed size, pack and unpack throughput,
+ * and unpacking one block from the middle on its own, as loading a
+ * document or a resume snapshot does block by block */
+static void benchLz(const char *name) {
+    const size_t blocks = BENCH_LZ_TEXT / LZ_BLOCK;
+    // The editor's document fills most of doc_arena: borrow PSRAM for the run
+    uint8_t *text = heap_caps_malloc(BENCH_LZ_TEXT, MALLOC_CAP_SPIRAM);
+    uint8_t *back = heap_caps_malloc(BENCH_LZ_TEXT, MALLOC_CAP_SPIRAM);
+    uint8_t *packed = heap_caps_malloc(blocks * LZ_BOUND(LZ_BLOCK), MALLOC_CAP_SPIRAM);
+    Lz_t *lz = heap_caps_malloc(sizeof(Lz_t), MALLOC_CAP_SPIRAM);
+    uint16_t sizes[BENCH_LZ_TEXT / LZ_BLOCK];
+    size_t total = 0;
+    bool ok = true;
+    char extra[160];
+
+    if (!text || !back || !packed || !lz) {
+        printf("Error: no memory for the lz benchmark\n");
+        heap_caps_free(text);
+        heap_caps_free(back);
+        heap_caps_free(packed);
+        heap_caps_free(lz);
+        return;
+    }
+    proseText(text, BENCH_LZ_TEXT);
+
+    int64_t t0 = esp_timer_get_time();
+    for (size_t b = 0; b < blocks; b++) {
+        sizes[b] = lzPack(lz, text + b * LZ_BLOCK, LZ_BLOCK, packed + b * LZ_BOUND(LZ_BLOCK), LZ_BOUND(LZ_BLOCK));
+        total += sizes[b];
+    }
+    int64_t dt_pack = esp_timer_get_time() - t0;
+
+    t0 = esp_timer_get_time();
+    for (size_t b = 0; b < blocks; b++)
+        ok &= lzUnpack(packed + b * LZ_BOUND(LZ_BLOCK), sizes[b], back + b * LZ_BLOCK, LZ_BLOCK);
+    int64_t dt_unpack = esp_timer_get_time() - t0;
+    ok &= memcmp(text, back, BENCH_LZ_TEXT) == 0;
+
+    const size_t mid = blocks / 2;
+    t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_LZ_BLOCKS; i++)
+        lzUnpack(packed + mid * LZ_BOUND(LZ_BLOCK), sizes[mid], back, LZ_BLOCK);
+    int64_t dt_block = esp_timer_get_time() - t0;
+
+    snprintf(extra, sizeof(extra),
+             ",\"packed\":%u,\"ratio_pct\":%u,\"unpack_kbytes_per_s\":%" PRIu32 ",\"block_us\":%" PRId64 ",\"ok\":%d",
+             (unsigned)total, (unsigned)(total * 100 / BENCH_LZ_TEXT), perSecond(BENCH_LZ_TEXT, dt_unpack) / 1024,
+             dt_block / BENCH_LZ_BLOCKS, ok);
+    report(name, BENCH_LZ_TEXT, dt_pack, "pack_kbytes_per_s", perSecond(BENCH_LZ_TEXT, dt_pack) / 1024, extra);
+    heap_caps_free(text);
+    heap_caps_free(back);
+    heap_caps_free(packed);
+    heap_caps_free(lz);
+}
+
+static const BenchCase_t cases[] = {
+    { "keys", benchKeys },
+    { "frame", benchFrame },
+    { "row", benchRow },
+    { "blit", benchBlit },
+    { "styles", benchStyles },
+    { "scaled", benchScaled },
+    { "glyphs", benchGlyphs },
+    { "fbops", benchFbops },
+    { "rect", benchRect },
+    { "rotate", benchRotate },
+    { "editor", benchEditor },
+    { "search", benchSearch },
+    { "isearch", benchIsearch },
+    { "spell", benchSpell },
+    { "complete", benchComplete },
+    { "lz", benchLz },
+};
+
+/* Everything a case may change on screen, put back after it */
+typedef struct {
+    uint8_t fb[PXWIDTH * PXHEIGHT / 8];
+    Layer_t layers[LAYER_COUNT];
+    uint8_t bits[LAYER_CURSOR_BYTES + LAYER_STATUS_BYTES + LAYER_MENU_BYTES];
+    Rotation rotation;
+    uint16_t glyph_cache;
+} Screen_t;
+
+static void screenSave(Screen_t *s) {
+    uint8_t *bits = s->bits;
+    memcpy(s->fb, sharpmem_buffer, sizeof(s->fb));
+    for (LayerId id = 0; id < LAYER_COUNT; id++) {
+        s->layers[id] = *compLayer(id);
+        if (s->layers[id].bits) memcpy(bits, s->layers[id].bits, s->layers[id].w * s->layers[id].h);
+        bits += s->layers[id].capacity;
+    }
+    s->rotation = fontRotation();
+    s->glyph_cache = glyphStoreCacheSize();
+}
+
+/* Setting the rotation again drops whatever a case left queued and
+ * rebuilds the font and cursor masks; the whole panel is sent after */
+static void screenRestore(const Screen_t *s) {
+    const uint8_t *bits = s->bits;
+    renderSetRotation(s->rotation);
+    glyphStoreSetCacheSize(s->glyph_cache);
+    memcpy(sharpmem_buffer, s->fb, sizeof(s->fb));
+    for (LayerId id = 0; id < LAYER_COUNT; id++) {
+        const Layer_t *l = &s->layers[id];
+        if (l->bits && compPlace(id, l->x, l->y, l->w, l->h, l->blend))
+            memcpy(compBits(id), bits, l->w * l->h);
+        compShow(id, l->visible);
+        bits += l->capacity;
+    }
+    renderMarkLines(0, PXHEIGHT);
+    renderFlush();
+}
+
+int benchRun(const char *name) {
+    const size_t ncases = sizeof(cases) / sizeof(cases[0]);
+    size_t i;
+
+    for (i = 0; name && i < ncases; i++)
+        if (strcmp(cases[i].name, name) == 0) break;
+    if (i == ncases) return -1;
+
+    Screen_t *saved = malloc(sizeof(Screen_t));
+    if (!saved) {
+        printf("Error: no memory to save the screen\n");
+        return 0;
+    }
+    screenSave(saved);
+    for (size_t c = 0; c < ncases; c++)
+        if (!name || c == i) cases[c].fn(cases[c].name);
+    screenRestore(saved);
+    free(saved);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *  Word completion. See complete.h.
+ */
+#include <string.h>
+#include "complete.h"
+#include "search.h"
+#include "doc.h"
+
+static CompleteNode_t *node(const Complete_t *c, uint16_t i) {
+    return &c->nodes[i];
+}
+
+static uint16_t child(const Complete_t *c, uint16_t at, uint8_t label) {
+    uint16_t k = node(c, at)->child;
+    while (k && node(c, k)->label != label) k = node(c, k)->sibling;
+    return k;
+}
+
+bool completeInit(Complete_t *c, MemArena_t *arena, uint16_t nodes) {
+    c->nodes = memArenaAlloc(arena, (size_t)nodes * sizeof(CompleteNode_t), 4);
+    c->size = c->nodes ? nodes : 0;
+    c->used = 1;
+    if (c->nodes) memset(&c->nodes[0], 0, sizeof(CompleteNode_t));
+    return c->nodes != NULL;
+}
+
+/* Put word where its count ranks it in n's list, if it makes the list */
+static void promote(const Complete_t *c, CompleteNode_t *n, uint16_t word) {
+    uint16_t count = node(c, word)->count;
+    int i = 0;
+    while (i < COMPLETE_TOP - 1 && n->top[i] && n->top[i] != word) i++;
+    if (n->top[i] != word) {
+        if (n->top[i] && node(c, n->top[i])->count >= count) return;
+        n->top[i] = word;
+    }
+    for (; i > 0 && node(c, n->top[i - 1])->count < count; i--) {
+        n->top[i] = n->top[i - 1];
+        n->top[i - 1] = word;
+    }
+}
+
+void completeAdd(Complete_t *c, const uint8_t *word, size_t len) {
+    uint16_t at = 0;
+    if (!c->nodes || len == 0 || len > SPELL_WORD_MAX) return;
+    for (size_t i = 0; i < len; i++) {
+        uint16_t k = child(c, at, word[i]);
+        if (!k) {
+            if (c->used == c->size) return;
+            k = c->used++;
+            *node(c, k) = (CompleteNode_t){ .label = word[i], .parent = at, .sibling = node(c, at)->child };
+            node(c, at)->child = k;
+        }
+        at = k;
+    }
+    CompleteNode_t *w = node(c, at);
+    if (w->count < UINT16_MAX) w->count++;
+    for (uint16_t p = at;; p = node(c, p)->parent) {
+        promote(c, node(c, p), at);
+        if (p == 0) break;
+    }
+}
+
+/* The word ending at node i */
+static void spellOut(const Complete_t *c, uint16_t i, Completion_t *out) {
+    uint8_t len = 0;
+    for (uint16_t k = i; k; k = node(c, k)->parent) len++;
+    out->len = len;
+    for (uint16_t k = i; k; k = node(c, k)->parent) out->text[--len] = node(c, k)->label;
+}
+
+static bool offered(const Completion_t *out, size_t n, const uint8_t *text, size_t len) {
+    for (size_t i = 0; i < n; i++)
+        if (out[i].len == len && memcmp(out[i].text, text, len) == 0) return true;
+    return false;
+}
+
+/* Dictionary words for prefix after the n already in out; first is the
+ * prefix's own first codepoint when the dictionary was asked in lowercase */
+static size_t fromDictionary(const uint8_t *prefix, size_t len, const uint8_t *first, size_t first_len,
+                             Completion_t *out, size_t n, size_t max) {
+    SpellWord_t words[SPELL_COMPLETE_TOP];
+    size_t m = spellComplete(prefix, len, words, SPELL_COMPLETE_TOP);
+    for (size_t j = 0; j < m && n < max; j++) {
+        if (words[j].len <= len || words[j].len > SPELL_WORD_MAX) continue;
+        memcpy(out[n].text, words[j].text, words[j].len);
+        memcpy(out[n].text, first, first_len);
+        out[n].len = words[j].len;
+        if (!offered(out, n, out[n].text, out[n].len)) n++;
+    }
+    return n;
+}
+
+size_t completeLookup(const Complete_t *c, const uint8_t *prefix, size_t len, Completion_t *out, size_t max) {
+    size_t n = 0;
+    uint16_t at = 0;
+
+    if (len == 0 || len > SPELL_WORD_MAX) return 0;
+    for (size_t i = 0; c->nodes && i < len; i++)
+        if (!(at = child(c, at, prefix[i]))) break;
+    for (int i = 0; at && i < COMPLETE_TOP && n < max && node(c, at)->top[i]; i++)
+        if (node(c, at)->top[i] != at) spellOut(c, node(c, at)->top[i], &out[n++]);
+
+    n = fromDictionary(prefix, len, prefix, 0, out, n, max);
+
+    // A capital first letter: ask for the lowercase word, keep the capital
+    uint32_t cp = prefix[0];
+    size_t first = 1;
+    if (cp >= 0xC0) {
+        int more = cp >= 0xF0 ? 3 : cp >= 0xE0 ? 2 : 1;
+        cp &= 0x3F >> more;
+        for (; more && first < len; more--) cp = (cp << 6) | (prefix[first++] & 0x3F);
+    }
+    if (searchFoldCp(cp) != cp && n < max) {
+        uint8_t lower[SPELL_WORD_MAX];
+        memcpy(lower, prefix, len);
+        docEncode(searchFoldCp(cp), lower);     // folding keeps the length
+        n = fromDictionary(lower, len, prefix, first, out, n, max);
+    }
+    return n;
+}
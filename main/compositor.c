@@ -0,0 +1,102 @@
+/*
+ *  Overlay layers composed per scanline at flush time. See compositor.h.
+ */
+#include <string.h>
+#include "compositor.h"
+#include "render.h"
+#include "font.h"
+#include "fbops.h"
+#include "mem.h"
+
+static uint8_t cursor_bits[LAYER_CURSOR_BYTES];
+static uint8_t status_bits[LAYER_STATUS_BYTES];
+
+static Layer_t layers[LAYER_COUNT] = {
+    [LAYER_CURSOR] = { .bits = cursor_bits, .capacity = sizeof(cursor_bits) },
+    [LAYER_STATUS] = { .bits = status_bits, .capacity = sizeof(status_bits) },
+    [LAYER_MENU] = { .capacity = LAYER_MENU_BYTES },     // bits allocated when first placed
+};
+
+void compInit(void) {
+    memRegisterStatic("status layer", sizeof(status_bits), MEM_INTERNAL);
+}
+
+static void damageAll(const Layer_t *l) {
+    if (l->visible) renderMarkLines(l->y, l->h);
+}
+
+bool compPlace(LayerId id, uint8_t x, uint16_t y, uint8_t w, uint16_t h, LayerBlend blend) {
+    Layer_t *l = &layers[id];
+    if ((uint32_t)w * h > l->capacity || x + w > BYTES_PER_LINE || y + h > PXHEIGHT) return false;
+    if (!l->bits && !(l->bits = memPlace("menu layer", l->capacity, MEM_INTERNAL))) return false;
+    damageAll(l);
+    l->x = x;
+    l->y = y;
+    l->w = w;
+    l->h = h;
+    l->blend = blend;
+    damageAll(l);
+    return true;
+}
+
+void compShow(LayerId id, bool visible) {
+    Layer_t *l = &layers[id];
+    if (l->visible == visible) return;
+    l->visible = true;
+    damageAll(l);
+    l->visible = visible;
+}
+
+bool compVisible(LayerId id) {
+    return layers[id].visible;
+}
+
+void compClear(LayerId id) {
+    Layer_t *l = &layers[id];
+    if (!l->bits) return;
+    memset(l->bits, l->blend == BLEND_XOR ? 0x00 : 0xFF, l->w * l->h);
+    damageAll(l);
+}
+
+/* The font is stored with 0 = ink; XOR layers want 1 = ink */
+int compPutText(LayerId id, uint8_t col, uint8_t row, const char *s, uint16_t styles) {
+    Layer_t *l = &layers[id];
+    uint8_t flip = l->blend == BLEND_XOR ? 0xFF : 0x00;
+    int n = 0;
+
+    if ((row + 1) * PSF_GLYPH_SIZE > l->h) return 0;
+    for (; *s && col < l->w; s++, col++, n++) {
+        uint8_t glyph[FONT_GLYPH_BYTES];
+        uint8_t *dst = l->bits + row * PSF_GLYPH_SIZE * l->w + col;
+        fontUpright((uint8_t)*s | styles, glyph);
+        for (int m = 0; m < PSF_GLYPH_SIZE; m++, dst += l->w) *dst = glyph[m] ^ flip;
+    }
+    compDamage(id, row * PSF_GLYPH_SIZE, PSF_GLYPH_SIZE);
+    return n;
+}
+
+void compDamage(LayerId id, uint16_t y, uint16_t h) {
+    const Layer_t *l = &layers[id];
+    if (!l->visible || y >= l->h) return;
+    if (y + h > l->h) h = l->h - y;
+    renderMarkLines(l->y + y, h);
+}
+
+const Layer_t *compLayer(LayerId id) {
+    return &layers[id];
+}
+
+uint8_t *compBits(LayerId id) {
+    return layers[id].bits;
+}
+
+void compLine(uint16_t y, uint8_t *dst) {
+    memcpy(dst, sharpmem_buffer + y * BYTES_PER_LINE, BYTES_PER_LINE);
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        const Layer_t *l = &layers[i];
+        if (!l->visible || y < l->y || y >= l->y + l->h) continue;
+        const uint8_t *src = l->bits + (y - l->y) * l->w;
+        if (l->blend == BLEND_XOR) fbXor(dst + l->x, src, l->w);
+        else memcpy(dst + l->x, src, l->w);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ *  Diagnostics console. See console.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_console.h"
+#include "console.h"
+#include "tasks.h"
+#include "mem.h"
+#include "trace.h"
+#include "stats.h"
+#include "bench.h"
+#include "wire.h"
+#include "glyphstore.h"
+#include "spell.h"
+#include "docstore.h"
+#include "sharp.h"
+#include "power.h"
+
+static int cmdTasks(int argc, char **argv) {
+    tasksReport();
+    return 0;
+}
+
+static int cmdMem(int argc, char **argv) {
+    memReport();
+    return 0;
+}
+
+static int cmdTrace(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "clear") == 0) traceClear();
+    else traceDumpJson();
+    return 0;
+}
+
+static int cmdStats(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) statsReset();
+    else statsPrint();
+    return 0;
+}
+
+typedef struct {
+    const char *name;
+    int result;
+} BenchCall_t;
+
+static void benchCall(void *arg) {
+    BenchCall_t *call = arg;
+    call->result = benchRun(call->name);
+}
+
+static int cmdBench(int argc, char **argv) {
+    BenchCall_t call = { .name = argc > 1 ? argv[1] : NULL };
+    keyTaskCall(benchCall, &call);
+    if (call.result < 0) {
+        printf("Unknown benchmark: %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
+
+static int cmdGlyphs(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) glyphStoreResetStats();
+    else glyphStoreReport();
+    return 0;
+}
+
+typedef struct {
+    int argc;
+    char **argv;
+} Args_t;
+
+/* "spell word...": look each word up */
+static void spellCall(void *arg) {
+    Args_t *args = arg;
+    for (int i = 1; i < args->argc; i++)
+        printf("%-20s %s\n", args->argv[i], spellLookup((const uint8_t *)args->argv[i], strlen(args->argv[i])) ? "ok" : "unknown");
+}
+
+static int cmdSpell(int argc, char **argv) {
+    if (argc == 1) spellReport();
+    else if (strcmp(argv[1], "reset") == 0) spellResetStats();
+    else {
+        Args_t args = { argc, argv };
+        keyTaskCall(spellCall, &args);
+    }
+    return 0;
+}
+
+static int cmdPower(int argc, char **argv) {
+    powerReport();
+    return 0;
+}
+
+static int cmdDocs(int argc, char **argv) {
+    docStoreReport();
+    return 0;
+}
+
+static void invertCall(void *arg) {
+    displaySetInverted(*(bool *)arg);
+}
+
+static int cmdInvert(int argc, char **argv) {
+    bool on = argc > 1 && strcmp(argv[1], "on") == 0;
+    if (argc > 1) keyTaskCall(invertCall, &on);
+    printf("Display %s\n", displayInverted() ? "light on dark" : "dark on light");
+    return 0;
+}
+
+static void calibrateCall(void *arg) {
+    wireCalibrate(&wire_params);
+}
+
+static int cmdWire(int argc, char **argv) {
+    WireParams_t p = wire_params;
+
+    if (argc > 1 && strcmp(argv[1], "cal") == 0) {
+        keyTaskCall(calibrateCall, NULL);
+        return 0;
+    }
+    if (argc > 1) p.clock_hz = strtoul(argv[1], NULL, 0);
+    if (argc > 2) p.queue_depth = strtoul(argv[2], NULL, 0);
+    if (!p.clock_hz) {
+        printf("Bad clock: %s\n", argv[1]);
+        return 1;
+    }
+    wireReport(&p);
+    return 0;
+}
+
+static const esp_console_cmd_t commands[] = {
+    { .command = "tasks", .help = "Task stacks, queue and heap high-water marks", .func = cmdTasks },
+    { .command = "mem", .help = "Arena and static buffer usage", .func = cmdMem },
+    { .command = "stats", .help = "Display and input counters, or 'stats reset'", .func = cmdStats },
+    { .command = "trace", .help = "Dump the event trace as Chrome trace JSON, or 'trace clear'", .func = cmdTrace },
+    { .command = "glyphs", .help = "Glyph store cache counters, or 'glyphs reset'", .func = cmdGlyphs },
+    { .command = "spell", .help = "Dictionaries and check counters, 'spell reset', or 'spell word...' to look words up", .func = cmdSpell },
+    { .command = "power", .help = "Input bursts and time at full clock against uptime", .func = cmdPower },
+    { .command = "docs", .help = "Saved document and autosave counters", .func = cmdDocs },
+    { .command = "invert", .help = "Display polarity: 'invert on|off'", .func = cmdInvert },
+    { .command = "wire", .help = "Flush timing model: 'wire [hz [depth]]' or 'wire cal'", .func = cmdWire },
+    { .command = "bench", .help = "Run all benchmarks, or one of keys frame row blit styles scaled glyphs fbops rect rotate editor search isearch spell complete lz", .func = cmdBench },
+};
+
+void consoleInit(void) {
+    esp_console_repl_t *repl = NULL;
+    esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    repl_config.prompt = "tw>";
+
+#if CONFIG_ESP_CONSOLE_USB_SERIAL_JTAG
+    esp_console_dev_usb_serial_jtag_config_t hw_config = ESP_CONSOLE_DEV_USB_SERIAL_JTAG_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_console_new_repl_usb_serial_jtag(&hw_config, &repl_config, &repl));
+#elif CONFIG_ESP_CONSOLE_USB_CDC
+    esp_console_dev_usb_cdc_config_t hw_config = ESP_CONSOLE_DEV_CDC_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_console_new_repl_usb_cdc(&hw_config, &repl_config, &repl));
+#else
+    esp_console_dev_uart_config_t hw_config = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_console_new_repl_uart(&hw_config, &repl_config, &repl));
+#endif
+
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++)
+        ESP_ERROR_CHECK(esp_console_cmd_register(&commands[i]));
+    ESP_ERROR_CHECK(esp_console_start_repl(repl));
+}
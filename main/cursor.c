@@ -0,0 +1,78 @@
+/*
+ *  Blinking cursor layer. See cursor.h.
+ */
+#include <string.h>
+#include "esp_timer.h"
+#include "cursor.h"
+#include "compositor.h"
+#include "render.h"
+#include "stats.h"
+
+static int64_t next_toggle = 0;     /* us, 0 = not blinking */
+static int64_t blink_until = 0;
+static bool hidden = true;
+static bool shown = false;
+
+static CursorShape shapeFor(enum Mode mode) {
+    switch (mode) {
+    case INSERT:  return CURSOR_BAR;
+    case REPLACE: return CURSOR_UNDERLINE;
+    default:      return CURSOR_BLOCK;
+    }
+}
+
+static bool lineEmpty(const uint8_t *line, uint8_t w) {
+    for (uint8_t i = 0; i < w; i++) if (line[i]) return false;
+    return true;
+}
+
+void cursorMove(const Cursor_t *cur) {
+    uint8_t x, w, h, first, last;
+    uint16_t y;
+
+    hidden = (cur->mode == HIDDEN);
+    if (hidden) {
+        compShow(LAYER_CURSOR, false);
+        shown = false;      // so cursorActivity() shows it again once unhidden
+        next_toggle = 0;
+        return;
+    }
+    renderCellGeometry(cur->x, cur->y, &x, &y, &w, &h);
+    const uint8_t *mask = renderCursorMask(shapeFor(cur->mode));
+
+    // Cover only the scanlines the shape has ink on
+    for (first = 0; first < h && lineEmpty(mask + first * w, w); first++);
+    for (last = h; last > first && lineEmpty(mask + (last - 1) * w, w); last--);
+
+    compPlace(LAYER_CURSOR, x, y + first, w, last - first, BLEND_XOR);
+    memcpy(compBits(LAYER_CURSOR), mask + first * w, (last - first) * w);
+    compDamage(LAYER_CURSOR, 0, last - first);
+}
+
+void cursorActivity(void) {
+    if (hidden) return;
+    int64_t now = esp_timer_get_time();
+    if (!shown) compShow(LAYER_CURSOR, true);
+    shown = true;
+    next_toggle = now + CURSOR_BLINK_MS * 1000LL;
+    blink_until = now + CURSOR_BLINK_TIMEOUT_MS * 1000LL;
+}
+
+bool cursorTick(void) {
+    int64_t now = esp_timer_get_time();
+    if (!next_toggle || now < next_toggle) return false;
+
+    shown = !shown;
+    // Past the timeout, stop on the next "on" phase and leave it solid
+    next_toggle = (shown && now >= blink_until) ? 0 : now + CURSOR_BLINK_MS * 1000LL;
+    compShow(LAYER_CURSOR, shown);
+    STAT_INC(blinks);
+    STAT_ADD(blink_lines, compLayer(LAYER_CURSOR)->h);
+    return true;
+}
+
+uint32_t cursorNextBlinkMs(void) {
+    if (!next_toggle) return 0;
+    int64_t us = next_toggle - esp_timer_get_time();
+    return us > 0 ? us / 1000 + 1 : 1;
+}
@@ -0,0 +1,113 @@
+/*
+ *  Gap buffer. See doc.h.
+ */
+#include <string.h>
+#include "doc.h"
+
+bool docInit(Doc_t *doc, MemArena_t *arena, size_t size) {
+    doc->buf = memArenaAlloc(arena, size, 4);
+    doc->size = doc->buf ? size : 0;
+    docClear(doc);
+    return doc->buf != NULL;
+}
+
+void docClear(Doc_t *doc) {
+    doc->gap = 0;
+    doc->gap_end = doc->size;
+    doc->version++;
+}
+
+void docSegments(const Doc_t *doc, const uint8_t **a, size_t *alen, const uint8_t **b, size_t *blen) {
+    *a = doc->buf;
+    *alen = doc->gap;
+    *b = doc->buf + doc->gap_end;
+    *blen = doc->size - doc->gap_end;
+}
+
+/* Move the gap so it starts at pos */
+static void moveGap(Doc_t *doc, size_t pos) {
+    size_t gap_len = doc->gap_end - doc->gap;
+    if (pos < doc->gap)
+        memmove(doc->buf + pos + gap_len, doc->buf + pos, doc->gap - pos);
+    else if (pos > doc->gap)
+        memmove(doc->buf + doc->gap, doc->buf + doc->gap_end, pos - doc->gap);
+    doc->gap = pos;
+    doc->gap_end = pos + gap_len;
+}
+
+bool docInsert(Doc_t *doc, size_t pos, const uint8_t *src, size_t len, uint32_t count) {
+    // Divide rather than multiply: len * count wraps in 32 bits
+    if ((len && count > (doc->gap_end - doc->gap) / len) || pos > docLength(doc)) return false;
+    moveGap(doc, pos);
+    doc->version++;
+    for (uint32_t i = 0; i < count; i++, doc->gap += len) memcpy(doc->buf + doc->gap, src, len);
+    return true;
+}
+
+void docDelete(Doc_t *doc, size_t pos, size_t len) {
+    size_t end = docLength(doc);
+    if (pos >= end) return;
+    if (len > end - pos) len = end - pos;
+    moveGap(doc, pos);
+    doc->gap_end += len;
+    doc->version++;
+}
+
+size_t docCopy(const Doc_t *doc, size_t pos, size_t len, uint8_t *dst) {
+    size_t end = docLength(doc), n;
+    if (pos >= end) return 0;
+    if (len > end - pos) len = end - pos;
+    if (pos < doc->gap) {
+        n = doc->gap - pos < len ? doc->gap - pos : len;
+        memcpy(dst, doc->buf + pos, n);
+        memcpy(dst + n, doc->buf + doc->gap_end, len - n);
+    }
+    else memcpy(dst, doc->buf + pos + (doc->gap_end - doc->gap), len);
+    return len;
+}
+
+uint32_t docCodepoint(const Doc_t *doc, size_t pos) {
+    size_t end = docLength(doc);
+    if (pos >= end) return 0;
+    uint8_t c = docByte(doc, pos);
+    int n = c < 0x80 ? 0 : c < 0xE0 ? 1 : c < 0xF0 ? 2 : 3;
+    uint32_t cp = n ? c & (0x3F >> n) : c;
+    for (int i = 1; i <= n && pos + i < end; i++) cp = (cp << 6) | (docByte(doc, pos + i) & 0x3F);
+    return cp;
+}
+
+size_t docNext(const Doc_t *doc, size_t pos) {
+    size_t end = docLength(doc);
+    if (pos >= end) return end;
+    for (pos++; pos < end && (docByte(doc, pos) & 0xC0) == 0x80; pos++);
+    return pos;
+}
+
+size_t docPrev(const Doc_t *doc, size_t pos) {
+    if (pos == 0) return 0;
+    for (pos--; pos > 0 && (docByte(doc, pos) & 0xC0) == 0x80; pos--);
+    return pos;
+}
+
+size_t docLineStart(const Doc_t *doc, size_t pos) {
+    while (pos > 0 && docByte(doc, pos - 1) != '\n') pos--;
+    return pos;
+}
+
+size_t docLineEnd(const Doc_t *doc, size_t pos) {
+    size_t end = docLength(doc);
+    while (pos < end && docByte(doc, pos) != '\n') pos++;
+    return pos;
+}
+
+size_t docEncode(uint32_t cp, uint8_t out[4]) {
+    if (cp < 0x80) { out[0] = cp; return 1; }
+    if (cp < 0x800) { out[0] = 0xC0 | (cp >> 6); out[1] = 0x80 | (cp & 0x3F); return 2; }
+    if (cp < 0x10000) {
+        out[0] = 0xE0 | (cp >> 12); out[1] = 0x80 | ((cp >> 6) & 0x3F); out[2] = 0x80 | (cp & 0x3F);
+        return 3;
+    }
+    out[0] = 0xF0 | (cp >> 18); out[1] = 0x80 | ((cp >> 12) & 0x3F);
+    out[2] = 0x80 | ((cp >> 6) & 0x3F); out[3] = 0x80 | (cp & 0x3F);
+    return 4;
+}
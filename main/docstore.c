@@ -0,0 +1,307 @@
+/*
+ *  Packed document slots in flash. See docstore.h.
+ */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "docstore.h"
+#include "lz.h"
+#include "mem.h"
+
+#define DOCSTORE_MAGIC 0x53445754   /* "TWDS" */
+#define DOCSTORE_VERSION 1
+#define SECTOR 4096
+/* Index flag: the block is stored as is */
+#define RAW_BLOCK 0x80000000u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t crc;           /* over the rest of the header and the index */
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t seq;
+    uint32_t length;        /* bytes of text */
+    uint32_t blocks;
+    uint32_t point;
+    uint32_t top;
+    uint32_t data_crc;      /* over the blocks as stored */
+} DocHeader_t;
+
+#define CRC_START offsetof(DocHeader_t, version)
+
+_Static_assert(sizeof(DocHeader_t) + (DOCSTORE_BLOCKS_MAX + 1) * 4 <= SECTOR, "slot index must fit its sector");
+
+static const esp_partition_t *part = NULL;
+static uint32_t slot_size;
+static int current = -1;            /* slot holding the document, -1 for none */
+static DocHeader_t header;          /* its header */
+
+/* The save in progress */
+static struct {
+    bool running;
+    int slot;
+    const Doc_t *doc;
+    uint32_t version;
+    uint32_t length, blocks, block;
+    uint32_t point, top;
+    uint32_t written;       /* data bytes written */
+    uint32_t erased;        /* data bytes erased */
+    uint32_t crc;
+    int64_t us;
+} save;
+
+static const Doc_t *saved_doc = NULL;
+static uint32_t saved_version;
+/* The document and version the current slot holds */
+static const Doc_t *slot_doc = NULL;
+static uint32_t slot_version;
+static int64_t last_save = 0;
+
+static struct {
+    uint32_t saves;
+    uint32_t dropped;       /* saves given up because the text changed */
+    uint32_t failed;
+    uint32_t length;        /* text and packed bytes of the last save */
+    uint32_t packed;
+    int64_t save_us;        /* time inside docStoreStep() for it */
+} stats;
+
+/* Buffers, all used from the key task only */
+static Lz_t lz;
+static uint32_t slot_index[DOCSTORE_BLOCKS_MAX + 1];
+static uint8_t raw[LZ_BLOCK];
+static uint8_t packed[LZ_BOUND(LZ_BLOCK)];
+
+static uint32_t slotBase(int slot) {
+    return slot * slot_size;
+}
+
+static uint32_t blockLength(const DocHeader_t *h, uint32_t i) {
+    uint32_t left = h->length - i * LZ_BLOCK;
+    return left < LZ_BLOCK ? left : LZ_BLOCK;
+}
+
+/* Read a slot's header and index and check them */
+static bool readHeader(int slot, DocHeader_t *h) {
+    uint32_t base = slotBase(slot);
+    if (esp_partition_read(part, base, h, sizeof(*h)) != ESP_OK || h->magic != DOCSTORE_MAGIC ||
+        h->version != DOCSTORE_VERSION || h->blocks > DOCSTORE_BLOCKS_MAX ||
+        h->blocks != (h->length + LZ_BLOCK - 1) / LZ_BLOCK)
+        return false;
+    if (esp_partition_read(part, base + sizeof(*h), slot_index, (h->blocks + 1) * 4) != ESP_OK) return false;
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)h + CRC_START, sizeof(*h) - CRC_START);
+    if (esp_rom_crc32_le(crc, (const uint8_t *)slot_index, (h->blocks + 1) * 4) != h->crc) return false;
+    return (slot_index[h->blocks] & ~RAW_BLOCK) <= slot_size - SECTOR;
+}
+
+/* Unpack block i of a slot into dst; adds the stored bytes to *crc */
+static bool readBlock(int slot, const DocHeader_t *h, uint32_t i, uint8_t *dst, uint32_t *crc) {
+    uint32_t span[2];
+    if (esp_partition_read(part, slotBase(slot) + sizeof(*h) + i * 4, span, sizeof(span)) != ESP_OK) return false;
+    uint32_t at = span[0] & ~RAW_BLOCK, end = span[1] & ~RAW_BLOCK, out = blockLength(h, i);
+    if (end < at || end - at > sizeof(packed) || end > slot_size - SECTOR) return false;
+    if (esp_partition_read(part, slotBase(slot) + SECTOR + at, packed, end - at) != ESP_OK) return false;
+    *crc = esp_rom_crc32_le(*crc, packed, end - at);
+    if (!(span[0] & RAW_BLOCK)) return lzUnpack(packed, end - at, dst, out);
+    if (end - at != out) return false;
+    memcpy(dst, packed, out);
+    return true;
+}
+
+bool docStoreInit(void) {
+    DocHeader_t h[2];
+    bool valid[2];
+
+    memRegisterStatic("docstore buffers", sizeof(lz) + sizeof(slot_index) + sizeof(raw) + sizeof(packed),
+                      MEM_INTERNAL);
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "docs");
+    if (!part) {
+        printf("Docs: no \"docs\" partition, documents are not saved\n");
+        return false;
+    }
+    slot_size = part->size / 2 / SECTOR * SECTOR;
+    for (int s = 0; s < 2; s++) valid[s] = readHeader(s, &h[s]);
+    if (valid[0] || valid[1]) {
+        current = (valid[0] && (!valid[1] || (int32_t)(h[0].seq - h[1].seq) > 0)) ? 0 : 1;
+        header = h[current];
+        printf("Docs: %" PRIu32 " bytes saved in slot %d\n", header.length, current);
+    }
+    return true;
+}
+
+static bool loadSlot(int slot, const DocHeader_t *h, Doc_t *doc) {
+    uint32_t crc = 0;
+    docClear(doc);
+    for (uint32_t i = 0; i < h->blocks; i++) {
+        if (!readBlock(slot, h, i, raw, &crc) || !docInsert(doc, docLength(doc), raw, blockLength(h, i), 1)) {
+            docClear(doc);
+            return false;
+        }
+    }
+    if (crc == h->data_crc) return true;
+    docClear(doc);
+    return false;
+}
+
+bool docStoreLoad(Doc_t *doc, size_t *point, size_t *top) {
+    DocHeader_t h;
+    if (!part || current < 0 || save.running) return false;
+    // The newest slot, or the one before it if that does not read back
+    for (int i = 0, slot = current; i < 2; i++, slot = !slot) {
+        if (!readHeader(slot, &h) || !loadSlot(slot, &h, doc)) continue;
+        if (slot != current) printf("Docs: slot %d is damaged, loaded the save before it\n", current);
+        current = slot;
+        header = h;
+        *point = h.point;
+        *top = h.top;
+        saved_doc = slot_doc = doc;
+        saved_version = slot_version = doc->version;
+        return true;
+    }
+    printf("Error: saved document was NOT loaded\n");
+    current = -1;
+    return false;
+}
+
+uint32_t docStoreAutosave(const Doc_t *doc, size_t point, size_t top) {
+    if (!part || save.running || (doc == saved_doc && doc->version == saved_version)) return 0;
+    int64_t now = esp_timer_get_time();
+    if (last_save && now - last_save < DOCSTORE_INTERVAL_US)
+        return (DOCSTORE_INTERVAL_US - (now - last_save)) / 1000 + 1;
+
+    size_t length = docLength(doc);
+    int slot = (current == 0) ? 1 : 0;
+    saved_doc = doc;        // a failure is not retried until the next edit
+    saved_version = doc->version;
+    if ((length + LZ_BLOCK - 1) / LZ_BLOCK > DOCSTORE_BLOCKS_MAX) {
+        printf("Error: document too long to save\n");
+        stats.failed++;
+        return 0;
+    }
+    // The old header goes first: the slot is not valid again until the end
+    if (esp_partition_erase_range(part, slotBase(slot), SECTOR) != ESP_OK) {
+        printf("Error: docs slot %d was NOT erased\n", slot);
+        stats.failed++;
+        return 0;
+    }
+    memset(&save, 0, sizeof(save));
+    save.running = true;
+    save.slot = slot;
+    save.doc = doc;
+    save.version = doc->version;
+    save.length = length;
+    save.blocks = (length + LZ_BLOCK - 1) / LZ_BLOCK;
+    save.point = point;
+    save.top = top;
+    last_save = now;
+    return 0;
+}
+
+uint32_t docStoreStamp(const Doc_t *doc) {
+    if (!part) return 0;
+    if (current < 0) return docLength(doc) ? DOCSTORE_UNSAVED : 0;
+    return (doc == slot_doc && doc->version == slot_version) ? header.seq : DOCSTORE_UNSAVED;
+}
+
+bool docStoreBusy(void) {
+    return save.running;
+}
+
+static void fail(const char *what) {
+    printf("Error: document was NOT saved, %s\n", what);
+    stats.failed++;
+    save.running = false;
+}
+
+/* Append to the slot's data, erasing the sectors it reaches first */
+static bool dataWrite(const uint8_t *data, size_t len) {
+    uint32_t base = slotBase(save.slot) + SECTOR;
+    if (save.written + len > slot_size - SECTOR) return false;
+    if (save.written + len > save.erased) {
+        uint32_t to = (save.written + len + SECTOR - 1) / SECTOR * SECTOR;
+        if (esp_partition_erase_range(part, base + save.erased, to - save.erased) != ESP_OK) return false;
+        save.erased = to;
+    }
+    if (esp_partition_write(part, base + save.written, data, len) != ESP_OK) return false;
+    save.crc = esp_rom_crc32_le(save.crc, data, len);
+    save.written += len;
+    return true;
+}
+
+static void writeBlock(const Doc_t *doc) {
+    size_t n = docCopy(doc, (size_t)save.block * LZ_BLOCK, LZ_BLOCK, raw);
+    size_t len = lzPack(&lz, raw, n, packed, sizeof(packed));
+    uint32_t at = save.written;
+    bool keep = (len == 0 || len >= n);     // did not pack, store it as is
+    if (!dataWrite(keep ? raw : packed, keep ? n : len)) {
+        fail(save.written + n > slot_size - SECTOR ? "it does not fit the docs partition" : "flash write failed");
+        return;
+    }
+    slot_index[save.block++] = at | (keep ? RAW_BLOCK : 0);
+}
+
+static void commit(void) {
+    DocHeader_t h = {
+        .magic = DOCSTORE_MAGIC,
+        .version = DOCSTORE_VERSION,
+        .seq = (current < 0) ? 1 : header.seq + 1,
+        .length = save.length,
+        .blocks = save.blocks,
+        .point = save.point,
+        .top = save.top,
+        .data_crc = save.crc,
+    };
+    slot_index[save.blocks] = save.written;
+    h.crc = esp_rom_crc32_le(0, (const uint8_t *)&h + CRC_START, sizeof(h) - CRC_START);
+    h.crc = esp_rom_crc32_le(h.crc, (const uint8_t *)slot_index, (save.blocks + 1) * 4);
+    // Index before header: the slot counts once the header is there
+    uint32_t base = slotBase(save.slot);
+    if (esp_partition_write(part, base + sizeof(h), slot_index, (save.blocks + 1) * 4) != ESP_OK ||
+        esp_partition_write(part, base, &h, sizeof(h)) != ESP_OK) {
+        fail("flash write failed");
+        return;
+    }
+    current = save.slot;
+    header = h;
+    slot_doc = save.doc;
+    slot_version = save.version;
+    save.running = false;
+    stats.saves++;
+    stats.length = save.length;
+    stats.packed = save.written;
+    stats.save_us = save.us;
+}
+
+void docStoreStep(const Doc_t *doc) {
+    if (!save.running || doc != save.doc) return;
+    if (doc->version != save.version) {
+        save.running = false;
+        stats.dropped++;
+        saved_doc = NULL;       // save it again at the next idle time
+        return;
+    }
+    int64_t t0 = esp_timer_get_time();
+    if (save.block < save.blocks) writeBlock(doc);
+    else commit();
+    save.us += esp_timer_get_time() - t0;
+}
+
+void docStoreReport(void) {
+    if (!part) {
+        printf("no docs partition\n");
+        return;
+    }
+    if (current < 0) printf("saved     nothing\n");
+    else printf("saved     slot %d, save %" PRIu32 ", %" PRIu32 " bytes in %" PRIu32 " blocks\n",
+                current, header.seq, header.length, header.blocks);
+    printf("saves     %" PRIu32 ", %" PRIu32 " dropped, %" PRIu32 " failed%s\n",
+           stats.saves, stats.dropped, stats.failed, save.running ? ", one running" : "");
+    if (stats.saves)
+        printf("last      %" PRIu32 " bytes packed to %" PRIu32 " (%" PRIu32 "%%) in %" PRId64 " ms\n",
+               stats.length, stats.packed, stats.length ? (uint32_t)((uint64_t)stats.packed * 100 / stats.length) : 0,
+               stats.save_us / 1000);
+}
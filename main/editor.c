@@ -0,0 +1,1041 @@
+/*
+ *  Modal editor. See editor.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "keyboard_input.h"
+#include "editor.h"
+#include "compositor.h"
+
+enum { ED_NONE, ED_MOTION, ED_OPERATOR, ED_ACTION };
+
+#define ED_LINEWISE  0x01   /* motion covers whole lines (j k G) */
+#define ED_INCLUSIVE 0x02   /* operator range includes the target (e) */
+
+#define COUNT_MAX 99999
+
+typedef size_t (*EdMotion)(Editor_t *ed, size_t pos, uint32_t count);
+typedef void (*EdOperator)(Editor_t *ed, size_t from, size_t to, bool lines);
+typedef void (*EdAction)(Editor_t *ed, uint32_t count);
+
+struct EdCommand {
+    uint8_t kind;
+    uint8_t flags;
+    EdMotion motion;
+    EdOperator op;
+    EdAction action;
+};
+
+static uint32_t times(uint32_t count) {
+    return count ? count : 1;
+}
+
+static bool isBlank(uint32_t cp) {
+    return cp == ' ' || cp == '\t';
+}
+
+/* 0 blank, 1 punctuation, 2 word */
+static int wordClass(uint32_t cp) {
+    if (cp == 0 || cp == '\n' || isBlank(cp)) return 0;
+    if (cp >= 0x80 || cp == '_' || (cp >= '0' && cp <= '9') || ((cp | 0x20) >= 'a' && (cp | 0x20) <= 'z')) return 2;
+    return 1;
+}
+
+/* A letter, or an apostrophe inside a word (don't, l'acqua) */
+static bool inWord(const Doc_t *doc, size_t pos) {
+    uint32_t cp = docCodepoint(doc, pos);
+    if (cp == '\'' || cp == 0x2019)
+        return pos > 0 && pos < docLength(doc) && wordClass(docCodepoint(doc, docPrev(doc, pos))) == 2 &&
+               wordClass(docCodepoint(doc, docNext(doc, pos))) == 2;
+    return wordClass(cp) == 2;
+}
+
+static size_t wordStart(const Doc_t *doc, size_t pos) {
+    while (pos > 0 && inWord(doc, docPrev(doc, pos))) pos = docPrev(doc, pos);
+    return pos;
+}
+
+static size_t wordEnd(const Doc_t *doc, size_t pos) {
+    while (pos < docLength(doc) && inWord(doc, pos)) pos = docNext(doc, pos);
+    return pos;
+}
+
+/* Point while a word is being typed there, SEARCH_NONE otherwise */
+static size_t typing(const Editor_t *ed) {
+    return (ed->cur->mode == INSERT || ed->cur->mode == REPLACE) ? ed->point : SEARCH_NONE;
+}
+
+static size_t column(const Doc_t *doc, size_t pos) {
+    size_t col = 0;
+    for (size_t p = docLineStart(doc, pos); p < pos; p = docNext(doc, p)) col++;
+    return col;
+}
+
+static size_t toColumn(const Doc_t *doc, size_t line, size_t col) {
+    size_t end = docLineEnd(doc, line);
+    while (col-- && line < end) line = docNext(doc, line);
+    return line;
+}
+
+/* NORMAL mode never rests on a line's '\n' unless the line is empty */
+static size_t clampNormal(const Doc_t *doc, size_t pos) {
+    size_t len = docLength(doc);
+    if (pos > len) pos = len;
+    if (pos > docLineStart(doc, pos) && (pos == len || docByte(doc, pos) == '\n')) pos = docPrev(doc, pos);
+    return pos;
+}
+
+static void setMode(Editor_t *ed, enum Mode mode) {
+    ed->cur->mode = mode;
+}
+
+static bool insertText(Editor_t *ed, size_t pos, const uint8_t *text, size_t len, uint32_t count) {
+    if (docInsert(&ed->doc, pos, text, len, count)) return true;
+    printf("Error: document full\n");
+    return false;
+}
+
+static void yank(Editor_t *ed, size_t from, size_t to, bool lines) {
+    size_t room = EDITOR_YANK_MAX - (lines ? 1 : 0);
+    ed->yank_len = docCopy(&ed->doc, from, to - from < room ? to - from : room, ed->yank);
+    if (lines) ed->yank[ed->yank_len++] = '\n';     // stored as whole lines
+    ed->yank_lines = lines;
+}
+
+/* ---- motions ---- */
+
+static size_t motionLeft(Editor_t *ed, size_t pos, uint32_t count) {
+    size_t start = docLineStart(&ed->doc, pos);
+    for (uint32_t i = times(count); i && pos > start; i--) pos = docPrev(&ed->doc, pos);
+    return pos;
+}
+
+static size_t motionRight(Editor_t *ed, size_t pos, uint32_t count) {
+    size_t end = docLineEnd(&ed->doc, pos);
+    for (uint32_t i = times(count); i && pos < end; i--) pos = docNext(&ed->doc, pos);
+    return pos;
+}
+
+static size_t motionDown(Editor_t *ed, size_t pos, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    size_t col = column(doc, pos), line = docLineStart(doc, pos);
+    for (uint32_t i = times(count); i; i--) {
+        size_t end = docLineEnd(doc, line);
+        if (end == docLength(doc)) break;
+        line = end + 1;
+    }
+    return toColumn(doc, line, col);
+}
+
+static size_t motionUp(Editor_t *ed, size_t pos, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    size_t col = column(doc, pos), line = docLineStart(doc, pos);
+    for (uint32_t i = times(count); i && line > 0; i--) line = docLineStart(doc, line - 1);
+    return toColumn(doc, line, col);
+}
+
+static size_t motionWord(Editor_t *ed, size_t pos, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    size_t len = docLength(doc);
+    for (uint32_t i = times(count); i && pos < len; i--) {
+        int cls = wordClass(docCodepoint(doc, pos));
+        if (cls) while (pos < len && wordClass(docCodepoint(doc, pos)) == cls) pos = docNext(doc, pos);
+        while (pos < len && !wordClass(docCodepoint(doc, pos))) pos = docNext(doc, pos);
+    }
+    return pos;
+}
+
+static size_t motionWordEnd(Editor_t *ed, size_t pos, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    size_t len = docLength(doc);
+    for (uint32_t i = times(count); i && pos < len; i--) {
+        pos = docNext(doc, pos);
+        while (pos < len && !wordClass(docCodepoint(doc, pos))) pos = docNext(doc, pos);
+        int cls = wordClass(docCodepoint(doc, pos));
+        for (size_t n = docNext(doc, pos); n < len && wordClass(docCodepoint(doc, n)) == cls; n = docNext(doc, n)) pos = n;
+    }
+    return pos;
+}
+
+static size_t motionWordBack(Editor_t *ed, size_t pos, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    for (uint32_t i = times(count); i && pos > 0; i--) {
+        pos = docPrev(doc, pos);
+        while (pos > 0 && !wordClass(docCodepoint(doc, pos))) pos = docPrev(doc, pos);
+        int cls = wordClass(docCodepoint(doc, pos));
+        while (pos > 0 && wordClass(docCodepoint(doc, docPrev(doc, pos))) == cls) pos = docPrev(doc, pos);
+    }
+    return pos;
+}
+
+static size_t motionLineStart(Editor_t *ed, size_t pos, uint32_t count) {
+    return docLineStart(&ed->doc, pos);
+}
+
+static size_t motionLineEnd(Editor_t *ed, size_t pos, uint32_t count) {
+    if (count > 1) pos = motionDown(ed, pos, count - 1);
+    return docLineEnd(&ed->doc, pos);
+}
+
+/* Line number count, or the last line */
+static size_t motionGoto(Editor_t *ed, size_t pos, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    size_t line = 0, len = docLength(doc);
+    if (!count) return docLineStart(doc, len);
+    while (--count) {
+        size_t end = docLineEnd(doc, line);
+        if (end == len) break;
+        line = end + 1;
+    }
+    return line;
+}
+
+/* ---- operators ---- */
+
+/* Whole lines from a's to b's, with one '\n' so the rest joins up */
+static void lineRange(const Doc_t *doc, size_t a, size_t b, size_t *from, size_t *to) {
+    *from = docLineStart(doc, a);
+    *to = docLineEnd(doc, b);
+    if (*to < docLength(doc)) (*to)++;
+    else if (*from > 0) (*from)--;
+}
+
+static void opDelete(Editor_t *ed, size_t from, size_t to, bool lines) {
+    Doc_t *doc = &ed->doc;
+    if (lines) {
+        size_t start = docLineStart(doc, from);
+        yank(ed, start, docLineEnd(doc, to), true);
+        lineRange(doc, from, to, &from, &to);
+        docDelete(doc, from, to - from);
+        ed->point = docLineStart(doc, from < docLength(doc) ? from : docLength(doc));
+    }
+    else {
+        yank(ed, from, to, false);
+        docDelete(doc, from, to - from);
+        ed->point = from;
+    }
+}
+
+static void opYank(Editor_t *ed, size_t from, size_t to, bool lines) {
+    if (lines) {
+        from = docLineStart(&ed->doc, from);
+        to = docLineEnd(&ed->doc, to);
+    }
+    yank(ed, from, to, lines);
+    ed->point = from;
+}
+
+static void enterInsert(Editor_t *ed, size_t pos, uint32_t count, uint8_t tail) {
+    ed->point = pos;
+    ed->insert_start = pos;
+    ed->insert_tail = tail;
+    ed->insert_count = times(count);
+    setMode(ed, INSERT);
+}
+
+static void opChange(Editor_t *ed, size_t from, size_t to, bool lines) {
+    Doc_t *doc = &ed->doc;
+    if (lines) {
+        // Keep one empty line to type into
+        from = docLineStart(doc, from);
+        to = docLineEnd(doc, to);
+        yank(ed, from, to, true);
+    }
+    else yank(ed, from, to, false);
+    docDelete(doc, from, to - from);
+    enterInsert(ed, from, 1, 0);
+}
+
+/* ---- actions ---- */
+
+static void actDeleteChars(Editor_t *ed, uint32_t count) {
+    size_t to = motionRight(ed, ed->point, count);
+    if (to > ed->point) opDelete(ed, ed->point, to, false);
+}
+
+static void actDeleteToEnd(Editor_t *ed, uint32_t count) {
+    opDelete(ed, ed->point, motionLineEnd(ed, ed->point, count), false);
+}
+
+static void actChangeToEnd(Editor_t *ed, uint32_t count) {
+    opChange(ed, ed->point, motionLineEnd(ed, ed->point, count), false);
+}
+
+static void paste(Editor_t *ed, uint32_t count, bool after) {
+    Doc_t *doc = &ed->doc;
+    size_t pos;
+    if (!ed->yank_len) return;
+    if (ed->yank_lines) {
+        pos = after ? docLineEnd(doc, ed->point) : docLineStart(doc, ed->point);
+        if (after && pos == docLength(doc)) {
+            // Last line has no '\n': add one, and drop the pasted last one
+            if (!insertText(ed, pos, (const uint8_t *)"\n", 1, 1)) return;
+            if (!insertText(ed, ++pos, ed->yank, ed->yank_len, times(count))) return;
+            docDelete(doc, docLength(doc) - 1, 1);
+        }
+        else {
+            if (after) pos++;
+            if (!insertText(ed, pos, ed->yank, ed->yank_len, times(count))) return;
+        }
+        ed->point = pos;
+    }
+    else {
+        pos = (after && ed->point < docLineEnd(doc, ed->point)) ? docNext(doc, ed->point) : ed->point;
+        if (!insertText(ed, pos, ed->yank, ed->yank_len, times(count))) return;
+        ed->point = docPrev(doc, pos + ed->yank_len * times(count));
+    }
+}
+
+static void actPasteAfter(Editor_t *ed, uint32_t count) { paste(ed, count, true); }
+static void actPasteBefore(Editor_t *ed, uint32_t count) { paste(ed, count, false); }
+
+static void actInsert(Editor_t *ed, uint32_t count) {
+    enterInsert(ed, ed->point, count, 0);
+}
+
+static void actAppend(Editor_t *ed, uint32_t count) {
+    enterInsert(ed, motionRight(ed, ed->point, 1), count, 0);
+}
+
+static void actInsertLineStart(Editor_t *ed, uint32_t count) {
+    const Doc_t *doc = &ed->doc;
+    size_t pos = docLineStart(doc, ed->point), end = docLineEnd(doc, pos);
+    while (pos < end && isBlank(docByte(doc, pos))) pos++;
+    enterInsert(ed, pos, count, 0);
+}
+
+static void actAppendLineEnd(Editor_t *ed, uint32_t count) {
+    enterInsert(ed, docLineEnd(&ed->doc, ed->point), count, 0);
+}
+
+/* The repeated unit is "\ntext" below, "text\n" above */
+static void actOpenBelow(Editor_t *ed, uint32_t count) {
+    size_t pos = docLineEnd(&ed->doc, ed->point);
+    if (!insertText(ed, pos, (const uint8_t *)"\n", 1, 1)) return;
+    enterInsert(ed, pos, count, 0);
+    ed->point = pos + 1;
+}
+
+static void actOpenAbove(Editor_t *ed, uint32_t count) {
+    size_t pos = docLineStart(&ed->doc, ed->point);
+    if (!insertText(ed, pos, (const uint8_t *)"\n", 1, 1)) return;
+    enterInsert(ed, pos, count, 1);
+}
+
+static void actReplace(Editor_t *ed, uint32_t count) {
+    enterInsert(ed, ed->point, 1, 0);
+    setMode(ed, REPLACE);
+}
+
+static void actCancel(Editor_t *ed, uint32_t count) {
+    ed->highlight = false;
+}
+
+/* ---- status line ---- */
+
+/* Codepoint of UTF-8 text at *i, moving *i past it */
+static uint32_t utf8Next(const uint8_t *text, size_t len, size_t *i) {
+    uint32_t cp = text[(*i)++];
+    if (cp >= 0xC0) {
+        int more = cp >= 0xF0 ? 3 : cp >= 0xE0 ? 2 : 1;
+        cp &= 0x3F >> more;
+        for (; more && *i < len; more--) cp = (cp << 6) | (text[(*i)++] & 0x3F);
+    }
+    return cp;
+}
+
+/* Font glyphs of UTF-8 text for compPutText(), '?' for any the font lacks */
+static int glyphText(const uint8_t *text, size_t len, char *out, int room) {
+    int n = 0;
+    for (size_t i = 0; i < len && n < room;) {
+        int glyph = keymapGlyph(utf8Next(text, len, &i));
+        out[n++] = glyph > 0 ? glyph : '?';
+    }
+    return n;
+}
+
+static uint8_t statusCols(void) {
+    return compLayer(LAYER_STATUS)->w < EDITOR_MAX_COLS ? compLayer(LAYER_STATUS)->w : EDITOR_MAX_COLS;
+}
+
+/* ---- search ---- */
+
+static uint32_t queryCp(const Editor_t *ed, size_t *i) {
+    return utf8Next(ed->query, ed->query_len, i);
+}
+
+/* Ignore case unless the pattern has a capital */
+static bool smartFold(const Editor_t *ed) {
+    for (size_t i = 0; i < ed->query_len;) {
+        uint32_t cp = queryCp(ed, &i);
+        if (searchFoldCp(cp) != cp) return false;
+    }
+    return true;
+}
+
+static void showPrompt(Editor_t *ed, const char *note) {
+    char line[EDITOR_MAX_COLS + 1];
+    uint8_t cols = statusCols();
+    int n = 0;
+
+    line[n++] = ed->forward ? '/' : '?';
+    n += glyphText(ed->query, ed->query_len, line + n, cols - n);
+    if (note) n += snprintf(line + n, sizeof(line) - n, "  %s", note);
+    line[n < cols ? n : cols] = 0;
+    compClear(LAYER_STATUS);
+    compPutText(LAYER_STATUS, 0, 0, line, FONT_INVERSE);
+    compShow(LAYER_STATUS, true);
+    ed->suggestions = 0;    // the prompt has the status layer now
+}
+
+/* Go to the nearest match in the search direction, or wait for the scan */
+static void jump(Editor_t *ed) {
+    Search_t *s = &ed->search;
+    size_t m = ed->forward ? searchFind(s, ed->jump_from + 1, true) : searchFind(s, ed->jump_from, false);
+    bool wrapped = (m != SEARCH_NONE) && (ed->forward ? m <= ed->jump_from : m >= ed->jump_from);
+
+    if (s->running && (m == SEARCH_NONE || wrapped)) return;    // a nearer one may turn up
+    ed->jump_pending = false;
+    if (m == SEARCH_NONE) {
+        showPrompt(ed, "not found");
+        return;
+    }
+    ed->point = clampNormal(&ed->doc, m);
+    if (wrapped) showPrompt(ed, "wrapped");
+}
+
+static void startSearch(Editor_t *ed) {
+    if (!searchStart(&ed->search, &ed->doc, ed->query, ed->query_len, smartFold(ed), ed->point)) return;
+    ed->highlight = true;
+    ed->jump_pending = true;
+    ed->jump_from = ed->point;
+    editorBackground(ed);
+}
+
+/* The prompt changed: narrow or widen the current matches when the pattern
+ * grew or shrank, start over otherwise */
+static void searchTyped(Editor_t *ed) {
+    Search_t *s = &ed->search;
+    bool fold = smartFold(ed);
+
+    ed->point = ed->prompt_from;
+    if (!ed->query_len) {
+        searchStop(s);
+        ed->highlight = false;
+        return;
+    }
+    bool kept = searchValid(s) &&
+        ((ed->query_len > s->len) ? searchNarrow(s, ed->query, ed->query_len, fold)
+                                  : searchWiden(s, ed->query_len, fold) && memcmp(s->pat, ed->query, s->len) == 0);
+    if (!kept) {
+        startSearch(ed);
+        return;
+    }
+    ed->highlight = true;
+    ed->jump_pending = true;
+    ed->jump_from = ed->point;
+    jump(ed);
+}
+
+static void searchAgain(Editor_t *ed, uint32_t count, bool reverse) {
+    if (!ed->query_len) return;
+    bool was = ed->forward;
+    ed->forward ^= reverse;
+    compShow(LAYER_STATUS, false);
+    if (!searchValid(&ed->search)) startSearch(ed);     // the text changed, scan again
+    else {
+        ed->highlight = true;
+        ed->jump_from = ed->point;
+        for (uint32_t i = times(count); i; i--) {
+            ed->jump_pending = true;
+            jump(ed);
+            if (ed->jump_pending) break;
+            ed->jump_from = ed->point;
+        }
+    }
+    ed->forward = was;
+}
+
+static void actSearchNext(Editor_t *ed, uint32_t count) { searchAgain(ed, count, false); }
+static void actSearchPrev(Editor_t *ed, uint32_t count) { searchAgain(ed, count, true); }
+
+static void openPrompt(Editor_t *ed, bool forward) {
+    ed->prompt = true;
+    ed->prompt_from = ed->point;
+    ed->forward = forward;
+    ed->query_len = 0;
+    showPrompt(ed, NULL);
+}
+
+static void actSearchForward(Editor_t *ed, uint32_t count) { openPrompt(ed, true); }
+static void actSearchBack(Editor_t *ed, uint32_t count) { openPrompt(ed, false); }
+
+static void promptKey(Editor_t *ed, const KeyInput_t *in) {
+    switch (in->vk) {
+    case VK_ESC:
+        ed->prompt = false;
+        ed->query_len = 0;
+        searchTyped(ed);
+        compShow(LAYER_STATUS, false);
+        return;
+    case VK_ENTER:
+        ed->prompt = false;
+        compShow(LAYER_STATUS, false);
+        if (!ed->jump_pending) ed->point = clampNormal(&ed->doc, ed->point);
+        return;
+    case VK_BACKSPACE:
+        if (!ed->query_len) {
+            ed->prompt = false;
+            compShow(LAYER_STATUS, false);
+            return;
+        }
+        while (ed->query_len && (ed->query[--ed->query_len] & 0xC0) == 0x80);
+        break;
+    default:
+        if (!in->printable) return;
+        uint8_t utf8[4];
+        size_t len = docEncode(in->codepoint, utf8);
+        if (ed->query_len + len > SEARCH_PATTERN_MAX) return;
+        memcpy(ed->query + ed->query_len, utf8, len);
+        ed->query_len += len;
+        break;
+    }
+    showPrompt(ed, NULL);
+    searchTyped(ed);
+}
+
+#define MOTION(fn, fl) { .kind = ED_MOTION, .flags = (fl), .motion = (fn) }
+#define OPERATOR(fn)   { .kind = ED_OPERATOR, .op = (fn) }
+#define ACTION(fn)     { .kind = ED_ACTION, .action = (fn) }
+
+static const EdCommand_t normal_cmds[] = {
+    [VK_h] = MOTION(motionLeft, 0),
+    [VK_LEFT] = MOTION(motionLeft, 0),
+    [VK_BACKSPACE] = MOTION(motionLeft, 0),
+    [VK_l] = MOTION(motionRight, 0),
+    [VK_RIGHT] = MOTION(motionRight, 0),
+    [VK_SPACE] = MOTION(motionRight, 0),
+    [VK_j] = MOTION(motionDown, ED_LINEWISE),
+    [VK_DOWN] = MOTION(motionDown, ED_LINEWISE),
+    [VK_ENTER] = MOTION(motionDown, ED_LINEWISE),
+    [VK_k] = MOTION(motionUp, ED_LINEWISE),
+    [VK_UP] = MOTION(motionUp, ED_LINEWISE),
+    [VK_w] = MOTION(motionWord, 0),
+    [VK_e] = MOTION(motionWordEnd, ED_INCLUSIVE),
+    [VK_b] = MOTION(motionWordBack, 0),
+    [VK_0] = MOTION(motionLineStart, 0),
+    [VK_HOME] = MOTION(motionLineStart, 0),
+    [VK_DOLLAR] = MOTION(motionLineEnd, 0),
+    [VK_END] = MOTION(motionLineEnd, 0),
+    [VK_G] = MOTION(motionGoto, ED_LINEWISE),
+    [VK_d] = OPERATOR(opDelete),
+    [VK_y] = OPERATOR(opYank),
+    [VK_c] = OPERATOR(opChange),
+    [VK_x] = ACTION(actDeleteChars),
+    [VK_DELETE] = ACTION(actDeleteChars),
+    [VK_D] = ACTION(actDeleteToEnd),
+    [VK_C] = ACTION(actChangeToEnd),
+    [VK_p] = ACTION(actPasteAfter),
+    [VK_P] = ACTION(actPasteBefore),
+    [VK_i] = ACTION(actInsert),
+    [VK_INSERT] = ACTION(actInsert),
+    [VK_a] = ACTION(actAppend),
+    [VK_I] = ACTION(actInsertLineStart),
+    [VK_A] = ACTION(actAppendLineEnd),
+    [VK_o] = ACTION(actOpenBelow),
+    [VK_O] = ACTION(actOpenAbove),
+    [VK_R] = ACTION(actReplace),
+    [VK_ESC] = ACTION(actCancel),
+    [VK_SLASH] = ACTION(actSearchForward),
+    [VK_QUESTION] = ACTION(actSearchBack),
+    [VK_n] = ACTION(actSearchNext),
+    [VK_N] = ACTION(actSearchPrev),
+};
+
+#define NORMAL_CMDS (sizeof(normal_cmds) / sizeof(normal_cmds[0]))
+
+/* Operator with a motion, or doubled (dd) for count lines */
+static void runOperator(Editor_t *ed, const EdCommand_t *op, const EdCommand_t *cmd, uint32_t count) {
+    size_t a = ed->point, b;
+    bool lines;
+
+    if (cmd == op) {
+        b = a;
+        for (uint32_t i = 1; i < count; i++) {
+            size_t end = docLineEnd(&ed->doc, b);
+            if (end == docLength(&ed->doc)) break;
+            b = end + 1;
+        }
+        lines = true;
+    }
+    else if (cmd->kind == ED_MOTION) {
+        // cw changes to the end of the word, like ce
+        bool word_change = (op->op == opChange && cmd->motion == motionWord && wordClass(docCodepoint(&ed->doc, a)));
+        EdMotion motion = word_change ? motionWordEnd : cmd->motion;
+        bool inclusive = word_change || (cmd->flags & ED_INCLUSIVE);
+        b = motion(ed, a, count);
+        if (b < a) { size_t t = a; a = b; b = t; }
+        lines = cmd->flags & ED_LINEWISE;
+        if (inclusive && !lines) b = docNext(&ed->doc, b);
+        if (a == b && !lines) return;
+    }
+    else return;
+    op->op(ed, a, b, lines);
+}
+
+static void normalKey(Editor_t *ed, const KeyInput_t *in) {
+    int vk = in->vk;
+
+    if ((vk >= VK_1 && vk <= VK_9) || (vk == VK_0 && ed->count)) {
+        ed->count = ed->count * 10 + (vk - VK_0);
+        if (ed->count > COUNT_MAX) ed->count = COUNT_MAX;
+        return;
+    }
+    uint32_t count = ed->count;
+    ed->count = 0;
+    const EdCommand_t *cmd = (vk >= 0 && (size_t)vk < NORMAL_CMDS) ? &normal_cmds[vk] : NULL;
+    if (!cmd || cmd->kind == ED_NONE) {
+        ed->op = NULL;
+        return;
+    }
+
+    if (ed->op) {
+        const EdCommand_t *op = ed->op;
+        // 2d3w deletes six words
+        if (ed->op_count || count) {
+            uint64_t n = (uint64_t)times(ed->op_count) * times(count);
+            count = n > COUNT_MAX ? COUNT_MAX : (uint32_t)n;
+        }
+        ed->op = NULL;
+        runOperator(ed, op, cmd, count);
+    }
+    else switch (cmd->kind) {
+    case ED_MOTION:
+        ed->point = cmd->motion(ed, ed->point, count);
+        break;
+    case ED_OPERATOR:
+        ed->op = cmd;
+        ed->op_count = count;
+        return;
+    case ED_ACTION:
+        cmd->action(ed, count);
+        break;
+    }
+    if (ed->cur->mode == NORMAL) ed->point = clampNormal(&ed->doc, ed->point);
+}
+
+/* ---- completion ---- */
+
+/* Count the word ending at end for completion, unless it is misspelled.
+ * Only the cache is asked here; a word it does not know is kept for
+ * learnSlice(). */
+static void learn(Editor_t *ed, size_t end) {
+    uint8_t word[SPELL_WORD_MAX];
+    size_t start = wordStart(&ed->doc, end);
+    if (start == end || end - start > SPELL_WORD_MAX || docNext(&ed->doc, start) == end) return;
+    size_t len = docCopy(&ed->doc, start, end - start, word);
+    switch (spellCached(word, len)) {
+    case SPELL_OK:
+        completeAdd(&ed->complete, word, len);
+        break;
+    case SPELL_UNKNOWN:
+        if (ed->learn_count == EDITOR_LEARN_MAX) break;
+        memcpy(ed->learn_text[ed->learn_count], word, len);
+        ed->learn_len[ed->learn_count++] = len;
+        break;
+    }
+}
+
+/* Check and count up to EDITOR_SPELL_SLICE of the words typed */
+static void learnSlice(Editor_t *ed) {
+    uint8_t n = ed->learn_count < EDITOR_SPELL_SLICE ? ed->learn_count : EDITOR_SPELL_SLICE;
+    for (uint8_t i = 0; i < n; i++)
+        if (spellCheck(ed->learn_text[i], ed->learn_len[i]) != SPELL_BAD)
+            completeAdd(&ed->complete, ed->learn_text[i], ed->learn_len[i]);
+    ed->learn_count -= n;
+    memmove(ed->learn_text, ed->learn_text[n], ed->learn_count * SPELL_WORD_MAX);
+    memmove(ed->learn_len, ed->learn_len + n, ed->learn_count);
+}
+
+/* Count the words of the next EDITOR_SEED_SLICE bytes of a loaded
+ * document. They go straight to the dictionary, not through the cache the
+ * screen's words are kept in. Edits meanwhile only shift what is counted. */
+static void seedSlice(Editor_t *ed) {
+    const Doc_t *doc = &ed->doc;
+    uint8_t word[SPELL_WORD_MAX];
+    size_t pos = ed->seeded, end = docLength(doc), stop = pos + EDITOR_SEED_SLICE;
+
+    while (pos < end && (docByte(doc, pos) & 0xC0) == 0x80) pos++;
+    while (pos < end && pos < stop) {
+        if (!inWord(doc, pos)) {
+            pos = docNext(doc, pos);
+            continue;
+        }
+        size_t word_end = wordEnd(doc, pos);
+        if (word_end - pos <= SPELL_WORD_MAX && docNext(doc, pos) != word_end) {
+            size_t len = docCopy(doc, pos, word_end - pos, word);
+            if (spellLookup(word, len)) completeAdd(&ed->complete, word, len);
+        }
+        pos = word_end;
+    }
+    ed->seeded = pos;
+    ed->seeding = pos < end;
+}
+
+static bool sameSuggestions(const Completion_t *a, const Completion_t *b, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        if (a[i].len != b[i].len || memcmp(a[i].text, b[i].text, a[i].len) != 0) return false;
+    return true;
+}
+
+/* The first, which TAB takes, is drawn inverse */
+static void showSuggestions(Editor_t *ed) {
+    char line[EDITOR_MAX_COLS + 1];
+    uint8_t cols = statusCols(), col = 0;
+
+    compClear(LAYER_STATUS);
+    for (uint8_t i = 0; i < ed->suggestions && col < cols; i++) {
+        line[glyphText(ed->suggestion[i].text, ed->suggestion[i].len, line, cols - col)] = 0;
+        col += compPutText(LAYER_STATUS, col, 0, line, i == 0 ? FONT_INVERSE : 0) + 1;
+    }
+    compShow(LAYER_STATUS, true);
+}
+
+/* Look up completions of the word before point and put them on the status
+ * layer; true if that changed */
+static bool suggest(Editor_t *ed) {
+    const Doc_t *doc = &ed->doc;
+    Completion_t was[COMPLETE_SHOW];
+    uint8_t had = ed->suggestions, n = 0;
+    uint8_t prefix[SPELL_WORD_MAX];
+    size_t start = wordStart(doc, ed->point);
+
+    ed->complete_pending = false;
+    memcpy(was, ed->suggestion, sizeof(was));
+    if (ed->cur->mode == INSERT && !ed->prompt && start < ed->point && ed->point - start <= SPELL_WORD_MAX &&
+        (ed->point == docLength(doc) || !inWord(doc, ed->point))) {
+        ed->suggested = docCopy(doc, start, ed->point - start, prefix);
+        n = completeLookup(&ed->complete, prefix, ed->suggested, ed->suggestion, COMPLETE_SHOW);
+    }
+    ed->suggestions = n;
+    if (n == had && sameSuggestions(was, ed->suggestion, n)) return false;
+    if (n) showSuggestions(ed);
+    else compShow(LAYER_STATUS, false);
+    return true;
+}
+
+/* TAB takes the first suggestion, if there is one */
+static bool acceptSuggestion(Editor_t *ed) {
+    suggest(ed);
+    if (!ed->suggestions) return false;
+    const Completion_t *s = &ed->suggestion[0];
+    if (insertText(ed, ed->point, s->text + ed->suggested, s->len - ed->suggested, 1))
+        ed->point += s->len - ed->suggested;
+    return true;
+}
+
+/* Back to NORMAL, inserting the count's repeats of what was typed */
+static void leaveInsert(Editor_t *ed) {
+    size_t start = ed->insert_start, end = ed->point + ed->insert_tail;
+    if (ed->cur->mode == INSERT && ed->insert_count > 1 && end > start && end - start <= EDITOR_REPEAT_MAX) {
+        size_t len = docCopy(&ed->doc, start, end - start, ed->repeat);
+        if (insertText(ed, end, ed->repeat, len, ed->insert_count - 1))
+            ed->point += len * (ed->insert_count - 1);
+    }
+    ed->insert_count = 1;
+    setMode(ed, NORMAL);
+    ed->point = clampNormal(&ed->doc, motionLeft(ed, ed->point, 1));
+}
+
+static void insertKey(Editor_t *ed, const KeyInput_t *in) {
+    Doc_t *doc = &ed->doc;
+    uint8_t utf8[4];
+    size_t len;
+
+    switch (in->vk) {
+    case VK_ESC:
+        if (ed->point == docLength(doc) || !inWord(doc, ed->point)) learn(ed, ed->point);
+        leaveInsert(ed);
+        return;
+    case VK_BACKSPACE:
+        if (ed->point == 0) return;
+        if (ed->cur->mode == REPLACE) {
+            ed->point = docPrev(doc, ed->point);
+            return;
+        }
+        len = ed->point - docPrev(doc, ed->point);
+        ed->point -= len;
+        docDelete(doc, ed->point, len);
+        if (ed->point < ed->insert_start) ed->insert_start = ed->point;
+        return;
+    case VK_DELETE:
+        docDelete(doc, ed->point, docNext(doc, ed->point) - ed->point);
+        return;
+    case VK_ENTER:
+        len = docEncode('\n', utf8);
+        break;
+    case VK_TAB:
+        if (ed->cur->mode == INSERT && acceptSuggestion(ed)) return;
+        len = docEncode('\t', utf8);
+        break;
+    default:
+        if (!in->printable) {
+            const EdCommand_t *cmd = ((size_t)in->vk < NORMAL_CMDS) ? &normal_cmds[in->vk] : NULL;
+            if (cmd && cmd->kind == ED_MOTION) {
+                // Moving away ends the text a count would repeat
+                ed->point = cmd->motion(ed, ed->point, 1);
+                ed->insert_start = ed->point;
+                ed->insert_tail = 0;
+                ed->insert_count = 1;
+            }
+            return;
+        }
+        len = docEncode(in->codepoint, utf8);
+        break;
+    }
+    if (ed->cur->mode == REPLACE && ed->point < docLineEnd(doc, ed->point))
+        docDelete(doc, ed->point, docNext(doc, ed->point) - ed->point);
+    if (!insertText(ed, ed->point, utf8, len, 1)) return;
+    // A word just ended
+    if (!inWord(doc, ed->point) && utf8[0] != '\'') learn(ed, ed->point);
+    ed->point += len;
+}
+
+bool editorInit(Editor_t *ed, Cursor_t *cur, MemArena_t *arena, size_t doc_size) {
+    memset(ed, 0, sizeof(*ed) - sizeof(ed->shadow));
+    ed->cur = cur;
+    ed->insert_count = 1;
+    ed->yank = memArenaAlloc(arena, EDITOR_YANK_MAX, 4);
+    ed->repeat = memArenaAlloc(arena, EDITOR_REPEAT_MAX, 4);
+    editorInvalidate(ed);
+    setMode(ed, INSERT);
+    if (!ed->yank || !ed->repeat || !searchInit(&ed->search, arena, EDITOR_MATCHES_MAX) ||
+        // The trie is sized to the document, so small benchmark editors stay small
+        !completeInit(&ed->complete, arena, doc_size / 64 < COMPLETE_NODES ? doc_size / 64 : COMPLETE_NODES) ||
+        !docInit(&ed->doc, arena, doc_size)) {
+        printf("Error: no memory for the editor\n");
+        return false;
+    }
+    return true;
+}
+
+void editorRestore(Editor_t *ed, size_t point, size_t top) {
+    const Doc_t *doc = &ed->doc;
+    size_t len = docLength(doc);
+    ed->point = point < len ? point : len;
+    while (ed->point > 0 && ed->point < len && (docByte(doc, ed->point) & 0xC0) == 0x80) ed->point--;
+    ed->top = top;      // the layout takes it back to a row start
+    ed->seeded = 0;
+    ed->seeding = true;
+}
+
+void editorKey(Editor_t *ed, const KeyInput_t *in) {
+    bool was_typing = typing(ed) != SEARCH_NONE;
+    if (ed->prompt) promptKey(ed, in);
+    else if (was_typing) insertKey(ed, in);
+    else normalKey(ed, in);
+    ed->complete_pending = was_typing || typing(ed) != SEARCH_NONE;
+}
+
+/* ---- spelling ---- */
+
+/* Spelling of the word [start, end): SPELL_OK for what is not checked
+ * (single letters, numbers, identifiers, the word being typed), otherwise
+ * the cached result, looked up first if check is set */
+static int spelling(const Editor_t *ed, size_t start, size_t end, bool check) {
+    uint8_t word[SPELL_WORD_MAX];
+    size_t at = typing(ed);
+    if (end - start > SPELL_WORD_MAX || docNext(&ed->doc, start) == end || (at >= start && at <= end))
+        return SPELL_OK;
+    size_t len = docCopy(&ed->doc, start, end - start, word);
+    for (size_t i = 0; i < len; i++)
+        if (word[i] == '_' || (word[i] >= '0' && word[i] <= '9')) return SPELL_OK;
+    return check ? spellCheck(word, len) : spellCached(word, len);
+}
+
+/* The last pass covered this screen as it is now */
+static bool spelled(const Editor_t *ed) {
+    return ed->spelled_version == ed->doc.version && ed->spelled_top == ed->top &&
+           ed->spelled_typing == typing(ed) && ed->spelled_generation == spellGeneration();
+}
+
+/* Look up to EDITOR_SPELL_SLICE unchecked words on screen; true if one is
+ * misspelled. Words pushed out of the cache by others are not looked up
+ * again until the screen changes, so two can never take turns. */
+static bool spellSlice(Editor_t *ed) {
+    const Doc_t *doc = &ed->doc;
+    size_t end = ed->bottom < docLength(doc) ? ed->bottom : docLength(doc);
+    uint32_t budget = EDITOR_SPELL_SLICE;
+    bool redraw = false;
+
+    for (size_t pos = wordStart(doc, ed->top); pos < end;) {
+        if (!inWord(doc, pos)) {
+            pos = docNext(doc, pos);
+            continue;
+        }
+        size_t word_end = wordEnd(doc, pos);
+        if (spelling(ed, pos, word_end, false) == SPELL_UNKNOWN) {
+            if (!budget--) return redraw;
+            redraw |= (spelling(ed, pos, word_end, true) == SPELL_BAD);
+        }
+        pos = word_end;
+    }
+    ed->spell_pending = false;
+    ed->spelled_version = doc->version;
+    ed->spelled_top = ed->top;
+    ed->spelled_typing = typing(ed);
+    ed->spelled_generation = spellGeneration();
+    return redraw;
+}
+
+bool editorBusy(const Editor_t *ed) {
+    return ed->complete_pending || ed->learn_count || ed->search.running || ed->spell_pending || ed->seeding;
+}
+
+bool editorSeeding(const Editor_t *ed) {
+    return ed->seeding && !ed->complete_pending && !ed->learn_count && !ed->search.running && !ed->spell_pending;
+}
+
+bool editorBackground(Editor_t *ed) {
+    Search_t *s = &ed->search;
+    uint32_t had = s->count;
+    bool pending = ed->jump_pending;
+
+    if (ed->complete_pending) return suggest(ed);
+    if (ed->learn_count) {
+        learnSlice(ed);
+        return false;
+    }
+    if (!s->running && ed->spell_pending) return spellSlice(ed);
+    if (!s->running) {
+        if (ed->seeding) seedSlice(ed);
+        return false;
+    }
+    searchStep(s, SEARCH_SLICE);
+    if (pending) jump(ed);
+    if (pending && !ed->jump_pending) return true;
+    // New matches on screen get their highlight now
+    for (uint32_t i = had; ed->highlight && i < s->count; i++)
+        if (s->matches[i] + s->len > ed->top && s->matches[i] < ed->bottom) return true;
+    return false;
+}
+
+void editorInvalidate(Editor_t *ed) {
+    for (int r = 0; r < TEXT_MAX_ROWS; r++)
+        for (int c = 0; c < EDITOR_MAX_COLS; c++) ed->shadow[r][c] = EDITOR_UNKNOWN;
+}
+
+/* ---- layout ---- */
+
+/* Start of the screen row holding pos: lines wrap every cols codepoints */
+static size_t rowStart(const Editor_t *ed, size_t pos) {
+    const Doc_t *doc = &ed->doc;
+    size_t len = docLength(doc), p = docLineStart(doc, pos), start = p;
+    uint8_t cols = renderCols(), col = 0;
+    for (; p < len && docByte(doc, p) != '\n'; p = docNext(doc, p)) {
+        if (col == cols) {
+            start = p;
+            col = 0;
+        }
+        if (p >= pos) break;
+        col++;
+    }
+    return start;
+}
+
+/* Styles only apply to the built-in font; store glyphs draw plain */
+static void putCell(uint8_t col, uint8_t row, uint32_t cp, uint16_t style) {
+    int glyph = keymapGlyph(cp);
+    if (glyph >= 0) renderPutGlyph(col, row, glyph | style);
+    else renderPutCodepoint(col, row, cp);
+}
+
+/* Queue the cells of one row that differ from the panel; blank runs are
+ * cleared as spans, highlights inverted over the glyph, misspellings
+ * underlined */
+static void emitRow(Editor_t *ed, uint8_t row, const uint32_t *cells, uint8_t cols) {
+    uint32_t *shadow = ed->shadow[row];
+    for (uint8_t c = 0; c < cols;) {
+        uint32_t cp = cells[c] & ~EDITOR_FLAGS;
+        if (cells[c] == shadow[c]) {
+            c++;
+        }
+        else if (cells[c] == ' ') {
+            uint8_t start = c;
+            while (c < cols && cells[c] == ' ' && shadow[c] != ' ') shadow[c++] = ' ';
+            renderClearSpan(start, row, c - start);
+        }
+        else {
+            if (cp == ' ') renderClearSpan(c, row, 1);
+            else putCell(c, row, cp, (cells[c] & EDITOR_BAD) ? FONT_UNDERLINE : 0);
+            if (cells[c] & EDITOR_MARK) renderInvertSpan(c, row, 1);
+            shadow[c] = cells[c];
+            c++;
+        }
+    }
+}
+
+/* One screen from ed->top. Returns false if point is not on it; cells are
+ * only queued when emit is set. */
+static bool layout(Editor_t *ed, bool emit) {
+    const Doc_t *doc = &ed->doc;
+    uint8_t cols = renderCols(), rows = renderRows(), row = 0, col = 0;
+    uint32_t cells[EDITOR_MAX_COLS];
+    size_t pos = ed->top, len = docLength(doc);
+    bool found = false;
+    const Search_t *s = &ed->search;
+    bool marks = emit && ed->highlight && searchValid(s);
+    size_t hl = marks ? searchFirstIn(s, pos > s->len ? pos - s->len + 1 : 0, SEARCH_NONE) : SEARCH_NONE;
+    size_t word_end = 0;
+    uint32_t bad = 0;
+
+    while (row < rows) {
+        bool eof = (pos >= len);
+        uint32_t cp = eof ? '\n' : docCodepoint(doc, pos);
+        if (cp != '\n' && col == cols) {
+            if (emit) emitRow(ed, row, cells, cols);
+            if (++row == rows) break;
+            col = 0;
+        }
+        if (pos == ed->point) {
+            found = true;
+            ed->cur->x = col < cols ? col : cols - 1;
+            ed->cur->y = row;
+        }
+        if (cp == '\n') {
+            // Blank the rest of this row, and every row after the end
+            do {
+                while (col < cols) cells[col++] = ' ';
+                if (emit) emitRow(ed, row, cells, cols);
+                col = 0;
+            } while (++row < rows && eof);
+        }
+        else {
+            while (hl != SEARCH_NONE && pos >= hl + s->len) hl = searchFirstIn(s, hl + 1, SEARCH_NONE);
+            if (emit && pos >= word_end && inWord(doc, pos)) {
+                size_t start = (pos == ed->top) ? wordStart(doc, pos) : pos;
+                word_end = wordEnd(doc, pos);
+                int state = spelling(ed, start, word_end, false);
+                bad = (state == SPELL_BAD) ? EDITOR_BAD : 0;
+                if (state == SPELL_UNKNOWN && !spelled(ed)) ed->spell_pending = true;
+            }
+            cells[col++] = ((cp < ' ' || cp == 0x7F) ? ' ' : cp) | (pos >= hl ? EDITOR_MARK : 0) |
+                           (pos < word_end ? bad : 0);
+        }
+        pos = docNext(doc, pos);
+    }
+    ed->bottom = pos;
+    return found;
+}
+
+void editorRedraw(Editor_t *ed) {
+    // Edits at the top row can move where it starts
+    if (ed->top > docLength(&ed->doc)) ed->top = docLength(&ed->doc);
+    ed->top = (ed->point < ed->top) ? rowStart(ed, ed->point) : rowStart(ed, ed->top);
+    if (!layout(ed, false)) {
+        // Below the screen: scroll so point is on the last row
+        ed->top = rowStart(ed, ed->point);
+        for (uint8_t i = 1; i < renderRows() && ed->top > 0; i++) ed->top = rowStart(ed, ed->top - 1);
+    }
+    layout(ed, true);
+}
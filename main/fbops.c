@@ -0,0 +1,89 @@
+/*
+ *  Framebuffer kernels. See fbops.h.
+ */
+#include <string.h>
+#include "fbops.h"
+
+#define WORDS_PER_LINE (BYTES_PER_LINE / 4)
+
+typedef uint32_t __attribute__((may_alias)) word_t;
+
+static bool aligned(const void *p, uintptr_t a) {
+    return ((uintptr_t)p & (a - 1)) == 0;
+}
+
+#if FBOPS_USE_PIE
+/* All ones, xored in for the invert */
+static const uint8_t ones[16] __attribute__((aligned(16))) = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static void pieInvert(uint8_t *dst, size_t blocks) {
+    const uint8_t *src = dst, *k = ones;
+    // The compiler knows nothing of q registers: load the constant in the
+    // same statement that uses it, not once ahead of the loop
+    while (blocks--) {
+        __asm__ volatile (
+            "ee.vld.128.ip q7, %2, 0\n"
+            "ee.vld.128.ip q0, %0, 16\n"
+            "ee.xorq q0, q0, q7\n"
+            "ee.vst.128.ip q0, %1, 16\n"
+            : "+r"(src), "+r"(dst), "+r"(k) : : "memory");
+    }
+}
+
+static void pieXor(uint8_t *dst, const uint8_t *src, size_t blocks) {
+    const uint8_t *in = dst;
+    while (blocks--) {
+        __asm__ volatile (
+            "ee.vld.128.ip q0, %0, 16\n"
+            "ee.vld.128.ip q1, %1, 16\n"
+            "ee.xorq q0, q0, q1\n"
+            "ee.vst.128.ip q0, %2, 16\n"
+            : "+r"(in), "+r"(src), "+r"(dst) : : "memory");
+    }
+}
+#endif
+
+void fbInvert(uint8_t *dst, size_t n) {
+#if FBOPS_USE_PIE
+    if (aligned(dst, FBOPS_ALIGN)) {
+        pieInvert(dst, n / 16);
+        dst += n & ~(size_t)15;
+        n &= 15;
+    }
+#endif
+    if (aligned(dst, 4)) {
+        for (; n >= 4; n -= 4, dst += 4) *(word_t *)dst = ~*(word_t *)dst;
+    }
+    for (; n; n--, dst++) *dst = ~*dst;
+}
+
+void fbXor(uint8_t *dst, const uint8_t *src, size_t n) {
+#if FBOPS_USE_PIE
+    if (aligned(dst, FBOPS_ALIGN) && aligned(src, FBOPS_ALIGN)) {
+        pieXor(dst, src, n / 16);
+        dst += n & ~(size_t)15;
+        src += n & ~(size_t)15;
+        n &= 15;
+    }
+#endif
+    if (aligned(dst, 4) && aligned(src, 4)) {
+        for (; n >= 4; n -= 4, dst += 4, src += 4) *(word_t *)dst ^= *(const word_t *)src;
+    }
+    while (n--) *dst++ ^= *src++;
+}
+
+bool fbLineEqual(const uint8_t *a, const uint8_t *b) {
+    if (!aligned(a, 4) || !aligned(b, 4)) return memcmp(a, b, BYTES_PER_LINE) == 0;
+    const word_t *wa = (const word_t *)a, *wb = (const word_t *)b;
+    uint32_t diff = 0;
+    for (int i = 0; i < WORDS_PER_LINE; i++) diff |= wa[i] ^ wb[i];
+    return diff == 0;
+}
+
+void fbDiffLines(const uint8_t *a, const uint8_t *b, LineMask_t out) {
+    memset(out, 0, sizeof(LineMask_t));
+    for (uint16_t y = 0; y < PXHEIGHT; y++, a += BYTES_PER_LINE, b += BYTES_PER_LINE)
+        if (!fbLineEqual(a, b)) LINEMASK_SET(out, y);
+}
@@ -0,0 +1,156 @@
+/*
+ *  Font storage and rotation. See font.h.
+ */
+#include <string.h>
+#include "font.h"
+#include "glyphstore.h"
+#include "zap-vga16-raw-neg.h"
+
+static uint8_t rotated[FONT_GLYPHS * FONT_GLYPH_BYTES];
+static Rotation rotation = ROTATE_0;
+const uint8_t *font_glyphs = zap_vga16_psf;
+
+typedef struct {
+    uint32_t index;             /* glyph | styles | tile, 0 = empty */
+    uint8_t bits[FONT_GLYPH_BYTES];
+} StyledGlyph_t;
+
+static StyledGlyph_t styled[FONT_STYLE_CACHE];
+
+/* Each source bit repeated 2 or 3 times, LSB first */
+static uint16_t double_bits[256];
+static uint32_t triple_bits[256];
+
+/* Three block swaps of 4x4, 2x2 and 1x1 sub-matrices, all in one register */
+uint64_t fontTranspose8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+static uint64_t load8(const uint8_t *p) {
+    uint64_t x = 0;
+    for (int i = 7; i >= 0; i--) x = (x << 8) | p[i];
+    return x;
+}
+
+static uint8_t reverse8(uint8_t b) {
+    b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+    b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+    return (b & 0xAA) >> 1 | (b & 0x55) << 1;
+}
+
+/* Line i of a transposed block is column i of the original. For ROTATE_90
+ * the columns are read bottom to top (byte-reversed rows in), for
+ * ROTATE_270 the lines come out in reverse order. */
+void fontRotateGlyph(const uint8_t *src, uint8_t *dst, Rotation rot) {
+    uint64_t top, bottom;
+
+    switch (rot) {
+    case ROTATE_90:
+        top = fontTranspose8(__builtin_bswap64(load8(src)));
+        bottom = fontTranspose8(__builtin_bswap64(load8(src + 8)));
+        for (int i = 0; i < 8; i++) {
+            dst[i * 2] = bottom >> (i * 8);
+            dst[i * 2 + 1] = top >> (i * 8);
+        }
+        break;
+    case ROTATE_180:
+        for (int i = 0; i < FONT_GLYPH_BYTES; i++) dst[i] = reverse8(src[FONT_GLYPH_BYTES - 1 - i]);
+        break;
+    case ROTATE_270:
+        top = fontTranspose8(load8(src));
+        bottom = fontTranspose8(load8(src + 8));
+        for (int i = 0; i < 8; i++) {
+            dst[i * 2] = top >> ((7 - i) * 8);
+            dst[i * 2 + 1] = bottom >> ((7 - i) * 8);
+        }
+        break;
+    default:
+        memcpy(dst, src, FONT_GLYPH_BYTES);
+        break;
+    }
+}
+
+/* The font is stored negative (0 = ink), so styles work on the complement */
+static void applyStyles(const uint8_t *src, uint8_t *dst, uint16_t styles) {
+    for (int m = 0; m < FONT_GLYPH_BYTES; m++) {
+        uint8_t ink = ~src[m];
+        if (styles & FONT_BOLD) ink |= ink << 1;
+        if (styles & FONT_DIM) ink &= (m & 1) ? 0xAA : 0x55;
+        if ((styles & FONT_UNDERLINE) && m == FONT_GLYPH_BYTES - 2) ink = 0xFF;
+        if (styles & FONT_INVERSE) ink = ~ink;
+        dst[m] = ~ink;
+    }
+}
+
+static void buildScaleTables(void) {
+    for (int b = 0; b < 256; b++) {
+        uint16_t d = 0;
+        uint32_t t = 0;
+        for (int i = 0; i < 8; i++) {
+            if (!(b & (1 << i))) continue;
+            d |= 3u << (i * 2);
+            t |= 7u << (i * 3);
+        }
+        double_bits[b] = d;
+        triple_bits[b] = t;
+    }
+}
+
+/* Tile (tx, ty) of the glyph scaled up: output row y is source row
+ * y / scale, widened through the table */
+static void scaleTile(const uint8_t *src, uint8_t *dst, uint8_t scale, uint8_t tx, uint8_t ty) {
+    if (!double_bits[1]) buildScaleTables();
+    for (int m = 0; m < FONT_GLYPH_BYTES; m++) {
+        uint8_t b = src[(ty * FONT_GLYPH_BYTES + m) / scale];
+        uint32_t wide = (scale == 2) ? double_bits[b] : triple_bits[b];
+        dst[m] = wide >> (tx * 8);
+    }
+}
+
+void fontUpright(uint16_t index, uint8_t *dst) {
+    applyStyles(zap_vga16_psf + (index & (FONT_GLYPHS - 1)) * FONT_GLYPH_BYTES, dst, index & FONT_STYLES);
+}
+
+const uint8_t *fontStyled(uint32_t index) {
+    if (index & FONT_CODEPOINT) return glyphStoreGet(index & FONT_CP_MASK);
+    uint16_t glyph = index & (FONT_GLYPHS - 1);
+    uint8_t scale = ((index >> 12) & 3) + 1;
+    index &= FONT_VARIANTS | (FONT_GLYPHS - 1);
+    StyledGlyph_t *e = &styled[(glyph ^ (index >> 8) * 37) & (FONT_STYLE_CACHE - 1)];
+
+    if (e->index != index) {
+        uint8_t upright[FONT_GLYPH_BYTES], tile[FONT_GLYPH_BYTES];
+        applyStyles(zap_vga16_psf + glyph * FONT_GLYPH_BYTES, upright, index & FONT_STYLES);
+        if (scale > 1 && scale <= FONT_MAX_SCALE) {
+            scaleTile(upright, tile, scale, (index >> 14) & 3, (index >> 16) & 3);
+            memcpy(upright, tile, sizeof(upright));
+        }
+        fontRotateGlyph(upright, e->bits, rotation);
+        e->index = index;
+    }
+    return e->bits;
+}
+
+void fontLoad(Rotation rot) {
+    rotation = rot;
+    memset(styled, 0, sizeof(styled));
+    glyphStoreFlush();
+    if (rot == ROTATE_0) {
+        font_glyphs = zap_vga16_psf;
+        return;
+    }
+    for (int g = 0; g < FONT_GLYPHS; g++)
+        fontRotateGlyph(zap_vga16_psf + g * FONT_GLYPH_BYTES, rotated + g * FONT_GLYPH_BYTES, rot);
+    font_glyphs = rotated;
+}
+
+Rotation fontRotation(void) {
+    return rotation;
+}
@@ -0,0 +1,90 @@
+/*
+ *  Span, line and rectangle primitives. See gfx.h.
+ */
+#include <string.h>
+#include "sharp.h"
+#include "render.h"
+#include "gfx.h"
+
+typedef struct {
+    int16_t x0, y0, x1, y1;     /* x1, y1 exclusive */
+} Clip_t;
+
+static Clip_t clip = { 0, 0, PXWIDTH, PXHEIGHT };
+
+void gfxSetClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    clip.x0 = x < 0 ? 0 : x;
+    clip.y0 = y < 0 ? 0 : y;
+    clip.x1 = (x + w > PXWIDTH) ? PXWIDTH : x + w;
+    clip.y1 = (y + h > PXHEIGHT) ? PXHEIGHT : y + h;
+}
+
+void gfxResetClip(void) {
+    gfxSetClip(0, 0, PXWIDTH, PXHEIGHT);
+}
+
+static inline void applyMask(uint8_t *p, uint8_t mask, GfxColor color) {
+    switch (color) {
+    case GFX_BLACK:  *p &= ~mask; break;
+    case GFX_WHITE:  *p |= mask; break;
+    default:         *p ^= mask; break;
+    }
+}
+
+/* Pixels are LSB first: pixel x is bit (x & 7) of byte x >> 3 */
+static void fillClipped(int16_t x0, int16_t y0, int16_t x1, int16_t y1, GfxColor color) {
+    if (x0 < clip.x0) x0 = clip.x0;
+    if (y0 < clip.y0) y0 = clip.y0;
+    if (x1 > clip.x1) x1 = clip.x1;
+    if (y1 > clip.y1) y1 = clip.y1;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    int b0 = x0 >> 3, b1 = (x1 - 1) >> 3;
+    uint8_t m0 = 0xFF << (x0 & 7);
+    uint8_t m1 = 0xFF >> (7 - ((x1 - 1) & 7));
+    uint8_t *line = sharpmem_buffer + y0 * BYTES_PER_LINE;
+
+    if (b0 == b1) {
+        // A column within one byte (vertical lines): pick the operation once
+        uint8_t *end = line + (y1 - y0) * BYTES_PER_LINE + b0;
+        m0 &= m1;
+        if (color == GFX_BLACK) for (line += b0; line < end; line += BYTES_PER_LINE) *line &= ~m0;
+        else if (color == GFX_WHITE) for (line += b0; line < end; line += BYTES_PER_LINE) *line |= m0;
+        else for (line += b0; line < end; line += BYTES_PER_LINE) *line ^= m0;
+        renderMarkLines(y0, y1 - y0);
+        return;
+    }
+    for (int16_t y = y0; y < y1; y++, line += BYTES_PER_LINE) {
+        applyMask(line + b0, m0, color);
+        if (color == GFX_INVERT) {
+            for (int b = b0 + 1; b < b1; b++) line[b] ^= 0xFF;
+        }
+        else if (b1 > b0 + 1) {
+            memset(line + b0 + 1, color == GFX_WHITE ? 0xFF : 0x00, b1 - b0 - 1);
+        }
+        applyMask(line + b1, m1, color);
+    }
+    renderMarkLines(y0, y1 - y0);
+}
+
+void gfxHLine(int16_t x, int16_t y, int16_t w, GfxColor color) {
+    fillClipped(x, y, x + w, y + 1, color);
+}
+
+void gfxVLine(int16_t x, int16_t y, int16_t h, GfxColor color) {
+    fillClipped(x, y, x + 1, y + h, color);
+}
+
+void gfxFillRect(int16_t x, int16_t y, int16_t w, int16_t h, GfxColor color) {
+    fillClipped(x, y, x + w, y + h, color);
+}
+
+void gfxRect(int16_t x, int16_t y, int16_t w, int16_t h, GfxColor color) {
+    if (w <= 0 || h <= 0) return;
+    gfxHLine(x, y, w, color);
+    if (h > 1) gfxHLine(x, y + h - 1, w, color);
+    if (h > 2) {
+        gfxVLine(x, y + 1, h - 2, color);
+        if (w > 1) gfxVLine(x + w - 1, y + 1, h - 2, color);
+    }
+}
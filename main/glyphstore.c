@@ -0,0 +1,171 @@
+/*
+ *  Flash glyph store with an LRU cache. See glyphstore.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_partition.h"
+#include "glyphstore.h"
+#include "font.h"
+#include "mem.h"
+
+#define GLYPHS_MAGIC 0x46475754     /* "TWGF" */
+#define GLYPHS_VERSION 1
+#define NONE 0xFFFF
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t glyph_bytes;
+    uint32_t count;
+    uint32_t reserved;
+} GlyphsHeader_t;
+
+typedef struct {
+    uint32_t cp;
+    uint16_t prev, next;        /* LRU list, most recent at head */
+    uint16_t chain;             /* hash bucket chain */
+    uint8_t bits[FONT_GLYPH_BYTES];
+} CachedGlyph_t;
+
+static const GlyphsHeader_t *header = NULL;
+static const uint32_t *index_cps;
+static const uint8_t *bitmaps;
+
+static CachedGlyph_t cache[GLYPH_CACHE_MAX];
+static uint16_t buckets[GLYPH_CACHE_MAX];
+static uint16_t capacity = GLYPH_CACHE_DEFAULT;
+static uint16_t used = 0;
+static uint16_t head = NONE, tail = NONE;
+static GlyphStoreStats_t stats;
+
+bool glyphStoreInit(void) {
+    const esp_partition_t *part;
+    esp_partition_mmap_handle_t handle;
+    const void *p;
+
+    memRegisterStatic("glyph cache", sizeof(cache) + sizeof(buckets), MEM_INTERNAL);
+    glyphStoreFlush();
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "glyphs");
+    if (!part) {
+        printf("Glyph store: no \"glyphs\" partition\n");
+        return false;
+    }
+    if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &p, &handle) != ESP_OK) {
+        printf("Error: glyph partition was NOT mapped\n");
+        return false;
+    }
+    const GlyphsHeader_t *h = p;
+    if (h->magic != GLYPHS_MAGIC || h->version != GLYPHS_VERSION || h->glyph_bytes != FONT_GLYPH_BYTES ||
+        sizeof(*h) + (uint64_t)h->count * (sizeof(uint32_t) + FONT_GLYPH_BYTES) > part->size) {
+        printf("Glyph store: partition holds no glyph image\n");
+        esp_partition_munmap(handle);
+        return false;
+    }
+    header = h;
+    index_cps = (const uint32_t *)(h + 1);
+    bitmaps = (const uint8_t *)(index_cps + h->count);
+    printf("Glyph store: %" PRIu32 " glyphs, %u cached\n", h->count, capacity);
+    return true;
+}
+
+static const uint8_t *findBitmap(uint32_t cp) {
+    if (!header) return NULL;
+    uint32_t lo = 0, hi = header->count;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (index_cps[mid] < cp) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < header->count && index_cps[lo] == cp) ? bitmaps + lo * FONT_GLYPH_BYTES : NULL;
+}
+
+static uint16_t bucketOf(uint32_t cp) {
+    return (cp * 2654435761u) >> 24 & (GLYPH_CACHE_MAX - 1);
+}
+
+static void lruUnlink(uint16_t i) {
+    CachedGlyph_t *e = &cache[i];
+    if (e->prev != NONE) cache[e->prev].next = e->next;
+    else head = e->next;
+    if (e->next != NONE) cache[e->next].prev = e->prev;
+    else tail = e->prev;
+}
+
+static void lruPush(uint16_t i) {
+    cache[i].prev = NONE;
+    cache[i].next = head;
+    if (head != NONE) cache[head].prev = i;
+    head = i;
+    if (tail == NONE) tail = i;
+}
+
+static void unchain(uint16_t i) {
+    uint16_t *link = &buckets[bucketOf(cache[i].cp)];
+    while (*link != i) link = &cache[*link].chain;
+    *link = cache[i].chain;
+}
+
+const uint8_t *glyphStoreGet(uint32_t cp) {
+    uint16_t b = bucketOf(cp), i;
+
+    for (i = buckets[b]; i != NONE; i = cache[i].chain) {
+        if (cache[i].cp != cp) continue;
+        stats.hits++;
+        if (head != i) {
+            lruUnlink(i);
+            lruPush(i);
+        }
+        return cache[i].bits;
+    }
+
+    stats.misses++;
+    const uint8_t *src = findBitmap(cp);
+    if (!src) {
+        stats.not_found++;
+        return fontGlyph('?');
+    }
+    if (used < capacity) i = used++;
+    else {
+        i = tail;
+        lruUnlink(i);
+        unchain(i);
+        stats.evictions++;
+    }
+    cache[i].cp = cp;
+    cache[i].chain = buckets[b];
+    buckets[b] = i;
+    lruPush(i);
+    fontRotateGlyph(src, cache[i].bits, fontRotation());
+    return cache[i].bits;
+}
+
+void glyphStoreFlush(void) {
+    memset(buckets, 0xff, sizeof(buckets));
+    used = 0;
+    head = tail = NONE;
+}
+
+void glyphStoreSetCacheSize(uint16_t n) {
+    capacity = (n == 0) ? 1 : (n > GLYPH_CACHE_MAX) ? GLYPH_CACHE_MAX : n;
+    glyphStoreFlush();
+}
+
+uint16_t glyphStoreCacheSize(void) {
+    return capacity;
+}
+
+void glyphStoreGetStats(GlyphStoreStats_t *out) {
+    *out = stats;
+}
+
+void glyphStoreResetStats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void glyphStoreReport(void) {
+    uint32_t lookups = stats.hits + stats.misses;
+    printf("glyphs    %" PRIu32 " in store, %u/%u cached\n", header ? header->count : 0, used, capacity);
+    printf("lookups   %" PRIu32 " hits, %" PRIu32 " misses (%" PRIu32 "%% hit), %" PRIu32 " evictions, %" PRIu32 " not found\n",
+           stats.hits, stats.misses, lookups ? stats.hits * 100 / lookups : 0, stats.evictions, stats.not_found);
+}
@@ -0,0 +1,131 @@
+/*
+ *  Key event translation. See keymap.h.
+ */
+#include <stddef.h>
+#include "keyboard_input.h"
+#include "keymap.h"
+
+#define MOD_SHIFT 0x01
+
+static uint8_t KBD_MODS = 0;  /* modifier bits of the modifier events held, see keyboard_input.h */
+
+/* The KBD map results as follows, once we resort the non-mod keys to be contiguous */
+const uint8_t KBDMAP[64] =  {  1 ,  3 ,  5 ,  7 ,  8 , 10 , 12 , 14 , 
+                                    2 ,  4 ,  6 , 20 ,  9 , 11 , 13 ,  0 , 
+                                   15 , 17 , 19 , 21 , 22 , 24 , 25 , 27 , 
+                                   16 , 18 , 33 , 35 , 23 , 38 , 26 , 28 , 
+                                   29 , 31 , 32 , 34 , 36 , 37 , 39 , 41 , 
+                                   30 , 42 , 44 , 46 , 48 , 50 , 40 , 97 , 
+                                   65 , 43 , 45 , 47 , 49 , 51 , 52 ,  0 , 
+                                   66 , 68 , 72 , 53 ,104 , 54 , 55 , 98 };
+
+/* Unicode and font maps from int(VK) - VKCHAROFFSET */
+
+static const int unicodemap[] = {
+0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027, 
+0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f, 
+0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 
+0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f, 
+0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 
+0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f, 
+0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, 
+0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f, 
+0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067, 
+0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f, 
+0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077, 
+0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x2022, 
+0x00E0, 0x00E8, 0x00EC, 0x00F2, 0x00F9, 0x00E1, 0x00E9, 0x00ED, 
+0x00F3, 0x00FA, 0x00FD, 0x00C0, 0x00C8, 0x00CC, 0x00D2, 0x00D9, 
+0x00C1, 0x00C9, 0x00CD, 0x00D3, 0x00DA, 0x00DD, 0x00DE, 0x00FE, 
+0x00E4, 0x00EB, 0x00EF, 0x00F6, 0x00FC, 0x00FF, 0x00C4, 0x00CB, 
+0x00CF, 0x00D6, 0x00DC, 0x0178, 0x00D0, 0x00D7, 0x00E2, 0x00EA, 
+0x00EE, 0x00F4, 0x00FB, 0x00C2, 0x00CA, 0x00CE, 0x00D4, 0x00DB, 
+0x00E7, 0x00C7, 0x00E3, 0x00F5, 0x00F1, 0x00C3, 0x00D5, 0x00D1, 
+0x00DF, 0x2592, 0x00A1, 0x00A2, 0x00A3, 0x00AC, 0x00A5, 0x0160, 
+0x00A7, 0x0161, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00A4, 0x00AE, 
+0x00AF, 0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x017D, 0x00B5, 0x00B6, 
+0x00B7, 0x017E, 0x00B9, 0x00BA, 0x00BB, 0x0152, 0x0153, 0x00BF, 
+0x00E6, 0x00F8, 0x00E5, 0x00C6, 0x00D8, 0x00C5, 0x03c0, 0x2260, 
+0x2264, 0x2265, 0x25a0, 0x25c6, 0x00bc, 0x00bd, 0x00be, 0x00a6, 
+0x00a8, 0x00b8, 0x0192, 0x2020, 0x2021, 0x2030, 0x2122, 0x2026, 
+0x2039, 0x203a, 0x201c, 0x201d, 0x201e, 0x2e42, 0x2e41, 0x011e, 
+0x011f, 0x0130, 0x0131, 0x015e, 0x015f, 0xfffd };
+
+static const uint8_t fontmap[] = {
+ 32,    33,    34,    35,    36,    37,    38,    39,    
+ 40,    41,    42,    43,    44,    45,    46,    47,    
+ 48,    49,    50,    51,    52,    53,    54,    55,    
+ 56,    57,    58,    59,    60,    61,    62,    63,    
+ 64,    65,    66,    67,    68,    69,    70,    71,    
+ 72,    73,    74,    75,    76,    77,    78,    79,    
+ 80,    81,    82,    83,    84,    85,    86,    87,    
+ 88,    89,    90,    91,    92,    93,    94,    95,    
+ 96,    97,    98,    99,    100,    101,    102,    103,    
+104,    105,    106,    107,    108,    109,    110,    111,    
+112,    113,    114,    115,    116,    117,    118,    119,    
+120,    121,    122,    123,    124,    125,    126,    127,    
+224,    232,    236,    242,    249,    225,    233,    237,    
+243,    250,    253,    128,    136,    140,    146,    153,    
+129,    137,    141,    147,    154,    157,    158,    254,    
+228,    235,    239,    246,    252,    255,    132,    139,    
+143,    150,    156,    190,    144,    151,    226,    234,    
+238,    244,    251,    130,   138,   142,   148,   155,   
+231,    135,    227,    245,    241,    131,    149,    145,    
+159,    160,    161,    162,    163,    164,    165,    166,    
+167,    168,    169,    170,    171,    172,    173,    174,    
+175,    176,    177,    178,    179,    180,    181,    182,    
+183,    184,    185,    186,    187,    188,    189,    191,    
+230,    248,    229,    134,    152,    133,    1,    2,    
+  3,    4,    5,    6,    7,    8,    9,    10,    
+ 11,    12,    13,    14,    15,    16,    17,    18,    
+ 19,    20,    21,    22,    23,    24,    25,    26,    
+ 27,    28,    29,    30,    31,    0  }; 
+
+/* US Layout in the 60% keyboard... replacing the ~ for ESC */
+static const int keymap[] =  { VK_NONE,  // 0
+	VK_ESC, VK_1, VK_2, VK_3, VK_4, VK_5, VK_6, VK_7, VK_8, VK_9, VK_0, VK_MINUS, VK_EQUAL, VK_BACKSPACE,  // 14
+	VK_TAB, VK_q, VK_w, VK_e, VK_r, VK_t, VK_y, VK_u, VK_i, VK_o, VK_p, VK_LEFTBRACKET, VK_RIGHTBRACKET, VK_ENTER,  // 28 
+	VK_CAPSLOCK, VK_a, VK_s, VK_d, VK_f, VK_g, VK_h, VK_j, VK_k, VK_l, VK_SEMICOLON, VK_APOSTROPHE, VK_BACKSLASH,  // 41
+	          VK_LESS, VK_z, VK_x, VK_c, VK_v, VK_b, VK_n, VK_m, VK_COMMA, VK_DOT, VK_SLASH,  // 52
+	          VK_SPACE, VK_SYS, VK_LANG }; // 55
+
+static const int keymap_shift[] =  { VK_NONE,  // 0
+	VK_TILDE, VK_EXCLAIM, VK_AT, VK_HASH, VK_DOLLAR, 
+	VK_PERCENT, VK_CARET, VK_AMPERSAND, VK_ASTERISK, VK_LEFTPAREN, 
+	VK_RIGHTPAREN, VK_UNDERSCORE, VK_PLUS, VK_BACKSPACE,  // 14
+	VK_TAB, VK_Q, VK_W, VK_E, VK_R, VK_T, VK_Y, VK_U, VK_I, VK_O, VK_P, VK_LEFTBRACE, VK_RIGHTBRACE, VK_ENTER,  // 28 
+	VK_CAPSLOCK, VK_A, VK_S, VK_D, VK_F, VK_G, VK_H, VK_J, VK_K, VK_L, VK_COLON, VK_QUOTEDBL, VK_VERTICALBAR,  // 41
+	          VK_LESS, VK_Z, VK_X, VK_C, VK_V, VK_B, VK_N, VK_M, VK_LESS, VK_GREATER, VK_QUESTION,  // 52
+	          VK_SPACE, VK_SYS, VK_LANG }; // 55
+
+bool keymapTranslate(uint8_t event, KeyInput_t *in) {
+    bool keydown = (event & KEYDOWN_MASK);
+
+    if (event & MOD_MASK) {
+        if ( keydown ) KBD_MODS |= (event & KEY_MASK );
+        else KBD_MODS &= ~(event & KEY_MASK );
+        return false;
+    }
+    if (!keydown || (event & KEY_MASK) >= sizeof(keymap) / sizeof(keymap[0])) return false;
+
+    keymapFromVk((KBD_MODS & MOD_SHIFT) ? keymap_shift[ (event & KEY_MASK) ] : keymap[ (event & KEY_MASK) ], in);
+    return true;
+}
+
+void keymapFromVk(int vk, KeyInput_t *in) {
+    in->vk = vk;
+    in->printable = (vk >= VKCHAROFFSET);
+    in->glyph = in->printable ? fontmap[vk - VKCHAROFFSET] : 0;
+    in->codepoint = in->printable ? unicodemap[vk - VKCHAROFFSET] : 0;
+}
+
+int keymapGlyph(uint32_t cp) {
+    if (cp >= 0x20 && cp < 0x7F) return cp;     // ASCII is in font order
+    for (size_t i = 0; i < sizeof(unicodemap) / sizeof(unicodemap[0]); i++)
+        if ((uint32_t)unicodemap[i] == cp) return fontmap[i];
+    return -1;
+}
+
+uint8_t keymapModifiers(void) {
+    return KBD_MODS;
+}
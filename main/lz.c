@@ -0,0 +1,101 @@
+/*
+ *  Block LZ codec. See lz.h.
+ */
+#include <string.h>
+#include "lz.h"
+
+static uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint32_t hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+/* Length bytes for what did not fit the token's nibble */
+static uint8_t *putLength(uint8_t *o, size_t len) {
+    for (; len >= 255; len -= 255) *o++ = 255;
+    *o++ = (uint8_t)len;
+    return o;
+}
+
+/* One sequence: literals, then a match unless len is 0. NULL if it does
+ * not fit before end. */
+static uint8_t *sequence(uint8_t *o, const uint8_t *end, const uint8_t *lit, size_t nlit, size_t offset, size_t len) {
+    size_t ml = len ? len - LZ_MIN_MATCH : 0;
+    if ((size_t)(end - o) < 1 + nlit / 255 + 1 + nlit + 2 + ml / 255 + 1) return NULL;
+    uint8_t *token = o++;
+    *token = (uint8_t)((nlit < 15 ? nlit : 15) << 4);
+    if (nlit >= 15) o = putLength(o, nlit - 15);
+    memcpy(o, lit, nlit);
+    o += nlit;
+    if (!len) return o;
+    *o++ = (uint8_t)offset;
+    *o++ = (uint8_t)(offset >> 8);
+    *token |= (uint8_t)(ml < 15 ? ml : 15);
+    if (ml >= 15) o = putLength(o, ml - 15);
+    return o;
+}
+
+size_t lzPack(Lz_t *lz, const uint8_t *src, size_t n, uint8_t *dst, size_t cap) {
+    uint8_t *o = dst, *end = dst + cap;
+    size_t i = 0, anchor = 0;
+    uint32_t misses = 0;
+
+    if (n > LZ_BLOCK) return 0;
+    memset(lz->table, 0, sizeof(lz->table));
+    while (i + LZ_MIN_MATCH <= n) {
+        uint32_t v = read32(src + i), h = hash(v);
+        size_t at = lz->table[h];
+        lz->table[h] = (uint16_t)(i + 1);
+        if (!at || read32(src + at - 1) != v) {
+            i += 1 + (misses++ >> 5);       // the longer nothing matches, the less it is looked for
+            continue;
+        }
+        size_t from = at - 1, len = LZ_MIN_MATCH;
+        while (i + len < n && src[from + len] == src[i + len]) len++;
+        if (!(o = sequence(o, end, src + anchor, i - anchor, i - from, len))) return 0;
+        i += len;
+        anchor = i;
+        misses = 0;
+        // The match's tail starts the next one often enough to be worth a probe
+        if (i >= 2 && i + 2 <= n) lz->table[hash(read32(src + i - 2))] = (uint16_t)(i - 1);
+    }
+    if (!(o = sequence(o, end, src + anchor, n - anchor, 0, 0))) return 0;
+    return o - dst;
+}
+
+/* A length continued past its nibble; false if src ends first */
+static bool getLength(const uint8_t *src, size_t n, size_t *i, size_t *len) {
+    uint8_t b;
+    do {
+        if (*i >= n) return false;
+        b = src[(*i)++];
+        *len += b;
+    } while (b == 255);
+    return true;
+}
+
+bool lzUnpack(const uint8_t *src, size_t n, uint8_t *dst, size_t out) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        uint8_t token = src[i++];
+        size_t lit = token >> 4, len = (token & 15) + LZ_MIN_MATCH;
+        if (lit == 15 && !getLength(src, n, &i, &lit)) return false;
+        if (lit > n - i || lit > out - o) return false;
+        memcpy(dst + o, src + i, lit);
+        i += lit;
+        o += lit;
+        if (i == n) break;          // the last sequence
+        if (n - i < 2) return false;
+        size_t offset = src[i] | (src[i + 1] << 8);
+        i += 2;
+        if ((token & 15) == 15 && !getLength(src, n, &i, &len)) return false;
+        if (offset == 0 || offset > o || len > out - o) return false;
+        // Byte by byte: a match may overlap the bytes it produces (runs)
+        for (const uint8_t *m = dst + o - offset; len; len--) dst[o++] = *m++;
+    }
+    return o == out;
+}
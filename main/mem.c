@@ -0,0 +1,98 @@
+/*
+ *  Arenas and the memory report. See mem.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "mem.h"
+
+typedef struct {
+    const char *name;
+    size_t size;
+    MemPlacement placement;
+    const MemArena_t *arena;
+} MemRegion_t;
+
+static MemRegion_t regions[MEM_MAX_REGIONS];
+static uint8_t nregions = 0;
+
+MemArena_t doc_arena;
+
+static const char *const placement_name[] = { "dma", "internal", "psram" };
+
+static void addRegion(MemRegion_t r) {
+    if (nregions < MEM_MAX_REGIONS) regions[nregions++] = r;
+    else printf("mem: region table full, %s not reported\n", r.name);
+}
+
+static void *placeBlock(size_t size, MemPlacement *placement) {
+    void *p = NULL;
+    switch (*placement) {
+    case MEM_DMA:
+        return heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    case MEM_PSRAM:
+        p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (p) return p;
+        *placement = MEM_INTERNAL;
+        /* fall through */
+    default:
+        return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+}
+
+void memInit(void) {
+    if (!memArenaInit(&doc_arena, "document", DOC_ARENA_SIZE, MEM_PSRAM))
+        printf("Error: document arena was NOT allocated\n");
+}
+
+bool memArenaInit(MemArena_t *arena, const char *name, size_t size, MemPlacement placement) {
+    memset(arena, 0, sizeof(*arena));
+    arena->name = name;
+    arena->placement = placement;
+    arena->base = placeBlock(size, &arena->placement);
+    if (!arena->base) return false;
+    arena->size = size;
+    addRegion((MemRegion_t){ .name = name, .size = size, .placement = arena->placement, .arena = arena });
+    return true;
+}
+
+void *memArenaAlloc(MemArena_t *arena, size_t size, size_t align) {
+    if (align == 0) align = 4;
+    size_t start = (arena->used + align - 1) & ~(align - 1);
+    if (!arena->base || start + size > arena->size) return NULL;
+    arena->used = start + size;
+    if (arena->used > arena->high) arena->high = arena->used;
+    return arena->base + start;
+}
+
+size_t memArenaMark(const MemArena_t *arena) {
+    return arena->used;
+}
+
+void memArenaRelease(MemArena_t *arena, size_t mark) {
+    if (mark < arena->used) arena->used = mark;
+}
+
+void memRegisterStatic(const char *name, size_t size, MemPlacement placement) {
+    addRegion((MemRegion_t){ .name = name, .size = size, .placement = placement });
+}
+
+void *memPlace(const char *name, size_t size, MemPlacement placement) {
+    void *p = placeBlock(size, &placement);
+    if (p) memRegisterStatic(name, size, placement);
+    return p;
+}
+
+void memReport(void) {
+    printf("%-12s %-8s %9s %9s %9s\n", "region", "where", "size", "used", "high");
+    for (uint8_t i = 0; i < nregions; i++) {
+        const MemRegion_t *r = &regions[i];
+        size_t used = r->size, high = r->size;
+        if (r->arena) {
+            used = r->arena->used;
+            high = r->arena->high;
+        }
+        printf("%-12s %-8s %9u %9u %9u\n", r->name, placement_name[r->placement],
+               (unsigned)r->size, (unsigned)used, (unsigned)high);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ *  Power manager: DFS + automatic light sleep, held off during input bursts.
+ *  See power.h.
+ */
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "power.h"
+#include "trace.h"
+
+#define POWER_MIN_FREQ_MHZ CONFIG_XTAL_FREQ
+
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t input_lock;
+#endif
+static bool active = false;
+static int64_t burst_start;
+static PowerStats_t stats;
+static uint8_t wake_pins;
+
+void powerInit(void)
+{
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = POWER_MIN_FREQ_MHZ,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        .light_sleep_enable = true,
+#endif
+    };
+    ESP_ERROR_CHECK(esp_pm_configure(&pm_config));
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "input", &input_lock));
+    printf("Power management: %d..%d MHz, light sleep %s\n", POWER_MIN_FREQ_MHZ,
+           CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, pm_config.light_sleep_enable ? "on" : "off");
+#else
+    printf("Power management disabled (CONFIG_PM_ENABLE)\n");
+#endif
+}
+
+void powerInputActive(void)
+{
+    if (active) return;
+    active = true;
+    burst_start = esp_timer_get_time();
+    stats.bursts++;
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_acquire(input_lock);
+#endif
+    traceSync();        // cycle counter runs at full clock from here
+}
+
+void powerInputIdle(void)
+{
+    if (!active) return;
+    active = false;
+    stats.active_us += esp_timer_get_time() - burst_start;
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_release(input_lock);
+#endif
+}
+
+void powerRegisterWakeGpio(gpio_num_t pin, int level)
+{
+    ESP_ERROR_CHECK(gpio_wakeup_enable(pin, level ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL));
+    ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+    wake_pins++;
+}
+
+void powerGetStats(PowerStats_t *out)
+{
+    *out = stats;
+    if (active) out->active_us += esp_timer_get_time() - burst_start;
+    out->uptime_us = esp_timer_get_time();
+}
+
+void powerReport(void)
+{
+    PowerStats_t st;
+    powerGetStats(&st);
+    uint32_t permille = st.uptime_us ? (uint32_t)(st.active_us * 1000 / st.uptime_us) : 0;
+    printf("bursts %" PRIu32 ", active %" PRIu64 " ms of %" PRIu64 " ms (%" PRIu32 ".%" PRIu32 "%%), %u wake pins\n",
+           st.bursts, st.active_us / 1000, st.uptime_us / 1000, permille / 10, permille % 10, wake_pins);
+}
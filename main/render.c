@@ -0,0 +1,320 @@
+/*
+ *  Render command queue: merges editor drawing commands before they touch
+ *  sharpmem_buffer, and pushes the touched scanlines in a single flush.
+ *  See render.h. Only the key processing task renders, so there is no locking.
+ */
+#include <string.h>
+#include "render.h"
+#include "trace.h"
+#include "stats.h"
+#include "esp_timer.h"
+
+#define ROW_ALL_CELLS ((1ULL << cols) - 1)
+#define ROW_BYTES (PSF_GLYPH_SIZE * BYTES_PER_LINE)
+
+static RenderCmd_t queue[RENDER_QUEUE_LENGTH];
+static uint16_t queued = 0;
+static LineMask_t dirty;
+
+/* Glyphs waiting to be rasterized: one bit per cell and the glyph for it */
+static uint64_t pendingCells[TEXT_MAX_ROWS];
+static uint32_t pendingGlyph[TEXT_MAX_ROWS][TEXT_COLS];
+
+/* Grid and cell shape on the panel for the current rotation: cells are
+ * cell_lines scanlines of cell_bytes bytes, see font.h */
+static Rotation rotation = ROTATE_0;
+static uint8_t cols = TEXT_COLS, rows = TEXT_ROWS;
+static uint8_t cell_lines = PSF_GLYPH_SIZE, cell_bytes = 1;
+
+/* XOR masks by CursorShape (the block also inverts spans), upright and in
+ * panel orientation */
+static const uint8_t cursor_shapes[3][FONT_GLYPH_BYTES] = {
+    { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+    { 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03 },
+    { [PSF_GLYPH_SIZE - 2] = 0xff, 0xff },
+};
+static uint8_t cursor_rotated[3][FONT_GLYPH_BYTES];
+static const uint8_t (*cursor_masks)[FONT_GLYPH_BYTES] = cursor_shapes;
+
+static uint64_t spanMask(uint8_t col, uint8_t len) {
+    if (col >= cols || len == 0) return 0;
+    if (len > cols - col) len = cols - col;
+    return ((len >= 64) ? ~0ULL : ((1ULL << len) - 1)) << col;
+}
+
+static void push(uint8_t op, uint8_t col, uint8_t row, uint8_t len, uint32_t arg) {
+    if (queued == RENDER_QUEUE_LENGTH) renderExecute();
+    trace(TRACE_RENDER, op, (row << 8) | col, 0);
+    queue[queued++] = (RenderCmd_t){ .op = op, .col = col, .row = row, .len = len, .arg = arg };
+}
+
+void renderPutGlyph(uint8_t col, uint8_t row, uint16_t glyph) { push(RC_PUT_GLYPH, col, row, 1, glyph); }
+
+void renderPutCodepoint(uint8_t col, uint8_t row, uint32_t cp) {
+    if (cp < 0x80) push(RC_PUT_GLYPH, col, row, 1, cp);     // ASCII maps 1:1 onto the font
+    else push(RC_PUT_GLYPH, col, row, 1, FONT_CODEPOINT | (cp & FONT_CP_MASK));
+}
+
+void renderPutScaled(uint8_t col, uint8_t row, uint16_t glyph, uint8_t scale) {
+    if (scale <= 1 || scale > FONT_MAX_SCALE) {
+        renderPutGlyph(col, row, glyph);
+        return;
+    }
+    for (uint8_t ty = 0; ty < scale && row + ty < rows; ty++)
+        for (uint8_t tx = 0; tx < scale && col + tx < cols; tx++)
+            push(RC_PUT_GLYPH, col + tx, row + ty, 1, glyph | FONT_TILE(scale, tx, ty));
+}
+void renderClearSpan(uint8_t col, uint8_t row, uint8_t len) { push(RC_CLEAR_SPAN, col, row, len, 0); }
+void renderInvertSpan(uint8_t col, uint8_t row, uint8_t len) { push(RC_INVERT_SPAN, col, row, len, 0); }
+void renderScroll(uint8_t rows) { push(RC_SCROLL, 0, 0, rows, 0); }
+void renderDrawCursor(uint8_t col, uint8_t row, CursorShape shape) { push(RC_DRAW_CURSOR, col, row, 1, shape); }
+
+/* Walk the queue backwards keeping, per text row, the cells that a later
+ * opaque command (glyph or clear) overwrites. Anything landing only on such
+ * cells is dead. A scroll shifts that coverage: rows scrolled off the top
+ * are dead before the scroll, and adjacent scrolls are folded together. */
+static void mergeQueue(void) {
+    uint64_t covered[TEXT_MAX_ROWS] = {0};
+    RenderCmd_t *later = NULL;
+
+    for (int i = queued - 1; i >= 0; i--) {
+        RenderCmd_t *c = &queue[i];
+        if (c->op == RC_SCROLL) {
+            for (int r = rows - 1; r >= 0; r--)
+                covered[r] = (r < c->len) ? ROW_ALL_CELLS : covered[r - c->len];
+            if (later && later->op == RC_SCROLL) {
+                uint16_t n = later->len + c->len;
+                later->len = (n > rows) ? rows : n;
+                c->op = RC_DROPPED;
+            }
+            else later = c;
+            continue;
+        }
+        uint64_t mask = spanMask(c->col, c->len);
+        if (c->row >= rows || (mask & ~covered[c->row]) == 0) {
+            c->op = RC_DROPPED;
+            continue;
+        }
+        if (c->op == RC_PUT_GLYPH || c->op == RC_CLEAR_SPAN) covered[c->row] |= mask;
+        later = c;
+    }
+}
+
+/* First scanline and byte of a cell on the panel */
+static uint16_t cellLine(uint8_t col, uint8_t row) {
+    switch (rotation) {
+    case ROTATE_90:  return col * cell_lines;
+    case ROTATE_180: return (rows - 1 - row) * cell_lines;
+    case ROTATE_270: return (cols - 1 - col) * cell_lines;
+    default:         return row * cell_lines;
+    }
+}
+
+static uint8_t *cellOrigin(uint8_t col, uint8_t row) {
+    uint8_t x;
+    switch (rotation) {
+    case ROTATE_90:  x = (rows - 1 - row) * cell_bytes; break;
+    case ROTATE_180: x = cols - 1 - col; break;
+    case ROTATE_270: x = row * cell_bytes; break;
+    default:         x = col; break;
+    }
+    return sharpmem_buffer + cellLine(col, row) * BYTES_PER_LINE + x;
+}
+
+static void markRow(uint8_t row) {
+    if (cell_lines == PSF_GLYPH_SIZE) {
+        uint16_t y = cellLine(0, row);
+        dirty[y >> 5] |= 0xFFFFu << (y & 31);   // PSF_GLYPH_SIZE lines, never straddles a word
+    }
+    else memset(dirty, 0xff, sizeof(dirty));    // a portrait row crosses every scanline
+}
+
+static void markCells(uint8_t row, uint64_t cells) {
+    if (cell_lines == PSF_GLYPH_SIZE) {
+        markRow(row);
+        return;
+    }
+    for (; cells; cells &= cells - 1) renderMarkLines(cellLine(__builtin_ctzll(cells), row), cell_lines);
+}
+
+void renderMarkLines(uint16_t y, uint16_t h) {
+    for (uint16_t end = (y + h > PXHEIGHT) ? PXHEIGHT : y + h; y < end; y++) LINEMASK_SET(dirty, y);
+}
+
+/* Rasterize all pending glyphs of one text row in a single pass over its
+ * scanlines */
+static void rasterizeRow(uint8_t row) {
+    uint64_t cells = pendingCells[row];
+    if (!cells) return;
+    uint64_t other = cells;
+    if (rotation == ROTATE_0) {
+        /* Plain glyphs scanline by scanline, styled and scaled ones from the cache below */
+        uint64_t plain = 0;
+        for (uint64_t c = cells; c; c &= c - 1)
+            if (!(pendingGlyph[row][__builtin_ctzll(c)] & FONT_VARIANTS)) plain |= c & -c;
+        other = cells & ~plain;
+        uint8_t *line = sharpmem_buffer + row * ROW_BYTES;
+        for (int m = 0; plain && m < PSF_GLYPH_SIZE; m++, line += BYTES_PER_LINE) {
+            for (uint64_t c = plain; c; c &= c - 1) {
+                int col = __builtin_ctzll(c);
+                line[col] = font_glyphs[pendingGlyph[row][col] * PSF_GLYPH_SIZE + m];
+            }
+        }
+    }
+    for (uint64_t c = other; c; c &= c - 1) {
+        int col = __builtin_ctzll(c);
+        const uint8_t *g = fontGlyph(pendingGlyph[row][col]);
+        uint8_t *line = cellOrigin(col, row);
+        for (int m = 0; m < cell_lines; m++, line += BYTES_PER_LINE, g += cell_bytes)
+            memcpy(line, g, cell_bytes);
+    }
+    pendingCells[row] = 0;
+    STAT_ADD(glyphs, __builtin_popcountll(cells));
+    markCells(row, cells);
+}
+
+static void xorCells(uint8_t row, uint64_t cells, const uint8_t *mask) {
+    for (; cells; cells &= cells - 1) {
+        uint8_t *line = cellOrigin(__builtin_ctzll(cells), row);
+        const uint8_t *m = mask;
+        for (int l = 0; l < cell_lines; l++, line += BYTES_PER_LINE)
+            for (int b = 0; b < cell_bytes; b++) line[b] ^= *m++;
+    }
+}
+
+static void clearCells(uint8_t row, uint8_t col, uint8_t len) {
+    if (len > cols - col) len = cols - col;
+    if (rotation == ROTATE_0) {
+        uint8_t *line = sharpmem_buffer + row * ROW_BYTES + col;
+        for (int m = 0; m < PSF_GLYPH_SIZE; m++, line += BYTES_PER_LINE)
+            memset(line, 0xff, len);
+        return;
+    }
+    for (uint8_t c = col; c < col + len; c++) {
+        uint8_t *line = cellOrigin(c, row);
+        for (int m = 0; m < cell_lines; m++, line += BYTES_PER_LINE)
+            memset(line, 0xff, cell_bytes);
+    }
+}
+
+static void applyCursor(const RenderCmd_t *c) {
+    uint64_t cell = spanMask(c->col, 1);
+    switch (c->arg) {
+    case CURSOR_BAR:       xorCells(c->row, cell, cursor_masks[CURSOR_BAR]); break;
+    case CURSOR_UNDERLINE: xorCells(c->row, cell, cursor_masks[CURSOR_UNDERLINE]); break;
+    default:               xorCells(c->row, cell, cursor_masks[CURSOR_BLOCK]); break;
+    }
+}
+
+/* Up by n text rows. Portrait rows are byte columns, so there every
+ * scanline shifts sideways. */
+static void scrollGrid(uint8_t n) {
+    for (uint8_t r = 0; r < rows; r++) rasterizeRow(r);
+    if (n > rows) n = rows;
+    size_t keep = (rows - n) * ROW_BYTES, gone = n * ROW_BYTES;
+    size_t shift = n * cell_bytes;
+    uint8_t *line = sharpmem_buffer;
+
+    switch (rotation) {
+    case ROTATE_0:
+        memmove(sharpmem_buffer, sharpmem_buffer + gone, keep);
+        memset(sharpmem_buffer + keep, 0xff, gone);
+        break;
+    case ROTATE_180:
+        memmove(sharpmem_buffer + gone, sharpmem_buffer, keep);
+        memset(sharpmem_buffer, 0xff, gone);
+        break;
+    case ROTATE_90:
+        for (int y = 0; y < PXHEIGHT; y++, line += BYTES_PER_LINE) {
+            memmove(line + shift, line, BYTES_PER_LINE - shift);
+            memset(line, 0xff, shift);
+        }
+        break;
+    case ROTATE_270:
+        for (int y = 0; y < PXHEIGHT; y++, line += BYTES_PER_LINE) {
+            memmove(line, line + shift, BYTES_PER_LINE - shift);
+            memset(line + BYTES_PER_LINE - shift, 0xff, shift);
+        }
+        break;
+    }
+    memset(dirty, 0xff, sizeof(dirty));
+}
+
+void renderExecute(void) {
+#if STATS_ENABLED
+    int64_t t0 = esp_timer_get_time();
+#endif
+    mergeQueue();
+    for (uint16_t i = 0; i < queued; i++) {
+        const RenderCmd_t *c = &queue[i];
+        switch (c->op) {
+        case RC_PUT_GLYPH:
+            pendingCells[c->row] |= 1ULL << c->col;
+            pendingGlyph[c->row][c->col] = c->arg;
+            break;
+        case RC_CLEAR_SPAN:
+            rasterizeRow(c->row);
+            clearCells(c->row, c->col, c->len);
+            markCells(c->row, spanMask(c->col, c->len));
+            break;
+        case RC_INVERT_SPAN:
+            rasterizeRow(c->row);
+            xorCells(c->row, spanMask(c->col, c->len), cursor_masks[CURSOR_BLOCK]);
+            markCells(c->row, spanMask(c->col, c->len));
+            break;
+        case RC_DRAW_CURSOR:
+            rasterizeRow(c->row);
+            applyCursor(c);
+            markCells(c->row, spanMask(c->col, 1));
+            break;
+        case RC_SCROLL:
+            scrollGrid(c->len);
+            break;
+        default:
+            break;
+        }
+    }
+    queued = 0;
+    for (uint8_t r = 0; r < rows; r++) rasterizeRow(r);
+    STAT_ADD(raster_us, esp_timer_get_time() - t0);
+}
+
+void renderSetRotation(Rotation rot) {
+    bool portrait = (rot == ROTATE_90 || rot == ROTATE_270);
+
+    queued = 0;
+    memset(pendingCells, 0, sizeof(pendingCells));
+    fontLoad(rot);
+    for (int i = 0; i < 3; i++) fontRotateGlyph(cursor_shapes[i], cursor_rotated[i], rot);
+    cursor_masks = (rot == ROTATE_0) ? cursor_shapes : (const uint8_t (*)[FONT_GLYPH_BYTES])cursor_rotated;
+    rotation = rot;
+    cols = portrait ? PXHEIGHT / 8 : TEXT_COLS;
+    rows = portrait ? PXWIDTH / PSF_GLYPH_SIZE : TEXT_ROWS;
+    cell_lines = portrait ? 8 : PSF_GLYPH_SIZE;
+    cell_bytes = portrait ? 2 : 1;
+}
+
+void renderCellGeometry(uint8_t col, uint8_t row, uint8_t *x, uint16_t *y, uint8_t *w, uint8_t *h) {
+    *y = cellLine(col, row);
+    *x = (cellOrigin(col, row) - sharpmem_buffer) - *y * BYTES_PER_LINE;
+    *w = cell_bytes;
+    *h = cell_lines;
+}
+
+const uint8_t *renderCursorMask(CursorShape shape) {
+    return cursor_masks[shape <= CURSOR_UNDERLINE ? shape : CURSOR_BLOCK];
+}
+
+uint8_t renderCols(void) { return cols; }
+uint8_t renderRows(void) { return rows; }
+
+void renderFlush(void) {
+    renderExecute();
+    updateLines(dirty);
+    memset(dirty, 0, sizeof(dirty));
+}
+
+void displayChar(uint8_t index, Cursor_t *cur) {
+    renderPutGlyph(cur->x, cur->y, index);
+    renderFlush();
+}
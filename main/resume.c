@@ -0,0 +1,158 @@
+/*
+ *  Fast resume snapshot in RTC memory and NVS. See resume.h.
+ */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "resume.h"
+#include "render.h"
+#include "lz.h"
+#include "mem.h"
+
+#define RESUME_MAGIC 0x53484152  // "SHAR"
+#define FRAME_BYTES (PXWIDTH * PXHEIGHT / 8)
+#define FRAME_BLOCKS ((FRAME_BYTES + LZ_BLOCK - 1) / LZ_BLOCK)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t crc;           /* over everything after this field */
+    uint16_t len;           /* bytes used in data[] */
+    uint8_t curx;
+    uint8_t cury;
+    uint32_t doc_stamp;     /* docStoreStamp() of the text on screen */
+    uint16_t block_len[FRAME_BLOCKS];   /* packed bytes of each block in data[] */
+    uint8_t data[RESUME_MAX_PACKED];
+} Snapshot_t;
+
+#define SNAPSHOT_HEADER offsetof(Snapshot_t, data)
+#define SNAPSHOT_CRC_START offsetof(Snapshot_t, len)
+
+static RTC_NOINIT_ATTR Snapshot_t rtc_snapshot;
+static Lz_t lz;
+static bool nvs_ready = false;
+static bool flash_copy = true;      /* NVS may hold a frame, from this boot or an earlier one */
+static int64_t last_flash_write = 0;
+
+static size_t blockBytes(size_t b) {
+    return (b + 1) * LZ_BLOCK <= FRAME_BYTES ? LZ_BLOCK : FRAME_BYTES - b * LZ_BLOCK;
+}
+
+/* The frame as LZ blocks one after the other; 0 if they do not all fit */
+static size_t pack(Snapshot_t *s) {
+    size_t o = 0;
+    for (size_t b = 0; b < FRAME_BLOCKS; b++) {
+        size_t n = blockBytes(b);
+        size_t len = lzPack(&lz, sharpmem_buffer + b * LZ_BLOCK, n, s->data + o, RESUME_MAX_PACKED - o);
+        if (!len) return 0;
+        s->block_len[b] = len;
+        o += len;
+    }
+    return o;
+}
+
+static bool unpack(const Snapshot_t *s) {
+    size_t o = 0;
+    for (size_t b = 0; b < FRAME_BLOCKS; b++) {
+        if (s->block_len[b] > s->len - o ||
+            !lzUnpack(s->data + o, s->block_len[b], sharpmem_buffer + b * LZ_BLOCK, blockBytes(b)))
+            return false;
+        o += s->block_len[b];
+    }
+    return o == s->len;
+}
+
+static uint32_t snapshotCrc(const Snapshot_t *s) {
+    return esp_rom_crc32_le(0, (const uint8_t *)s + SNAPSHOT_CRC_START,
+                            SNAPSHOT_HEADER - SNAPSHOT_CRC_START + s->len);
+}
+
+static bool restore(const Snapshot_t *s, Cursor_t *cur) {
+    if (s->magic != RESUME_MAGIC || s->len > RESUME_MAX_PACKED || s->crc != snapshotCrc(s))
+        return false;
+    if (!unpack(s))
+        return false;
+    cur->x = (s->curx < renderCols()) ? s->curx : 0;
+    cur->y = (s->cury < renderRows()) ? s->cury : 0;
+    return true;
+}
+
+static bool nvsOpen(nvs_handle_t *h, nvs_open_mode_t mode) {
+    if (!nvs_ready) {
+        esp_err_t ret = nvs_flash_init();
+        if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+            nvs_flash_erase();
+            ret = nvs_flash_init();
+        }
+        if (ret != ESP_OK) return false;
+        nvs_ready = true;
+    }
+    return nvs_open("resume", mode, h) == ESP_OK;
+}
+
+ResumeSource resumeBoot(Cursor_t *cur) {
+    esp_reset_reason_t why = esp_reset_reason();
+    bool warm = (why != ESP_RST_POWERON && why != ESP_RST_BROWNOUT && why != ESP_RST_UNKNOWN);
+
+    memRegisterStatic("resume codec", sizeof(lz), MEM_INTERNAL);
+
+    if (warm && restore(&rtc_snapshot, cur))
+        return RESUME_WARM;
+    rtc_snapshot.magic = 0;
+
+    // The flash copy is only worth an NVS init on a cold boot
+    nvs_handle_t h;
+    if (!nvsOpen(&h, NVS_READONLY)) return RESUME_NONE;
+    size_t len = sizeof(rtc_snapshot);
+    bool ok = nvs_get_blob(h, "frame", &rtc_snapshot, &len) == ESP_OK &&
+              len >= SNAPSHOT_HEADER && restore(&rtc_snapshot, cur);
+    nvs_close(h);
+    if (!ok) {
+        rtc_snapshot.magic = 0;
+        return RESUME_NONE;
+    }
+    return RESUME_FLASH;
+}
+
+uint32_t resumeDocStamp(void) {
+    return rtc_snapshot.doc_stamp;
+}
+
+uint32_t resumeSnapshot(const Cursor_t *cur, uint32_t doc_stamp) {
+    nvs_handle_t h;
+    size_t len = pack(&rtc_snapshot);
+    if (len == 0) {
+        // Does not fit: better no snapshot than a stale one, in either copy
+        rtc_snapshot.magic = 0;
+        if (flash_copy && nvsOpen(&h, NVS_READWRITE)) {
+            if (nvs_erase_key(h, "frame") != ESP_ERR_NVS_NOT_FOUND) nvs_commit(h);
+            flash_copy = false;
+            nvs_close(h);
+        }
+        return 0;
+    }
+    rtc_snapshot.len = len;
+    rtc_snapshot.curx = cur->x;
+    rtc_snapshot.cury = cur->y;
+    rtc_snapshot.doc_stamp = doc_stamp;
+    rtc_snapshot.crc = snapshotCrc(&rtc_snapshot);
+    rtc_snapshot.magic = RESUME_MAGIC;
+
+    int64_t now = esp_timer_get_time();
+    if (last_flash_write && now - last_flash_write < RESUME_FLASH_INTERVAL_US)
+        return (RESUME_FLASH_INTERVAL_US - (now - last_flash_write)) / 1000 + 1;
+    if (!nvsOpen(&h, NVS_READWRITE)) return 0;
+    if (nvs_set_blob(h, "frame", &rtc_snapshot, SNAPSHOT_HEADER + len) == ESP_OK) {
+        nvs_commit(h);
+        last_flash_write = now;
+        flash_copy = true;
+    }
+    nvs_close(h);
+    return 0;
+}
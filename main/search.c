@@ -0,0 +1,302 @@
+/*
+ *  Incremental Horspool search over the gap buffer. See search.h.
+ */
+#include <string.h>
+#include "search.h"
+
+/* Byte folding: ASCII capitals down, the lead bytes of U+00C0..U+017F to
+ * one, and all continuation bytes to one. Case pairs in Latin Extended-A
+ * are even/odd in some ranges and odd/even in others (Ž/ž is C5 BD/BE),
+ * so no cheaper rule keeps them together; foldEqual() sorts out the hits,
+ * and ASCII keeps its skips. */
+static uint8_t fold_byte[256];
+
+static void foldInit(void) {
+    for (int b = 0; b < 256; b++) {
+        if (b >= 'A' && b <= 'Z') fold_byte[b] = b | 0x20;
+        else if (b >= 0xC3 && b <= 0xC5) fold_byte[b] = 0xC3;
+        else if (b >= 0x80 && b <= 0xBF) fold_byte[b] = 0x80;
+        else fold_byte[b] = b;
+    }
+}
+
+uint32_t searchFoldCp(uint32_t cp) {
+    if (cp >= 'A' && cp <= 'Z') return cp | 0x20;
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp | 0x20;
+    if (cp == 0x178) return 0xFF;
+    if (cp == 0x130 || cp == 0x131) return cp;
+    if ((cp >= 0x100 && cp <= 0x137) || (cp >= 0x14A && cp <= 0x177)) return cp | 1;
+    if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) return (cp + 1) & ~1;
+    return cp;
+}
+
+static const uint8_t *utf8Decode(const uint8_t *p, uint32_t *cp) {
+    uint8_t c = *p++;
+    int n = c < 0x80 ? 0 : c < 0xE0 ? 1 : c < 0xF0 ? 2 : 3;
+    *cp = n ? c & (0x3F >> n) : c;
+    while (n--) *cp = (*cp << 6) | (*p++ & 0x3F);
+    return p;
+}
+
+/* Codepoint compare of a byte-folded hit; folding partners have equal
+ * UTF-8 lengths, so the hit is exactly len bytes */
+static bool foldEqual(const uint8_t *text, const uint8_t *pat, uint8_t len) {
+    const uint8_t *end = pat + len;
+    while (pat < end) {
+        uint32_t a, b;
+        if ((*text & 0xC0) == 0x80) return false;
+        text = utf8Decode(text, &a);
+        pat = utf8Decode(pat, &b);
+        if (searchFoldCp(a) != searchFoldCp(b)) return false;
+    }
+    return true;
+}
+
+static void record(Search_t *s, size_t pos) {
+    if (s->count == s->capacity) {
+        s->overflow = true;
+        return;
+    }
+    s->matches[s->count++] = pos;
+}
+
+/* Window starts 0..n-1 of text (logical position base); text holds at
+ * least n - 1 + len bytes */
+static void scanSpan(Search_t *s, const uint8_t *text, size_t base, size_t n) {
+    const uint8_t len = s->len, last = len - 1;
+    size_t i = 0;
+
+    if (!s->fold && len <= SEARCH_MEMCHR_MAX) {
+        while (i < n) {
+            const uint8_t *hit = memchr(text + i, s->pat[0], n - i);
+            if (!hit) break;
+            i = hit - text;
+            if (memcmp(hit, s->pat, len) == 0) record(s, base + i);
+            i++;
+        }
+    }
+    else if (!s->fold) {
+        const uint8_t tail = s->pat[last];
+        while (i < n) {
+            uint8_t c = text[i + last];
+            if (c == tail && memcmp(text + i, s->pat, last) == 0) record(s, base + i);
+            i += s->shift[c];
+        }
+    }
+    else {
+        const uint8_t tail = s->folded[last], head = s->folded[0];
+        while (i < n) {
+            uint8_t c = fold_byte[text[i + last]];
+            if (c == tail && fold_byte[text[i]] == head && foldEqual(text + i, s->pat, len)) record(s, base + i);
+            i += s->shift[c];
+        }
+    }
+}
+
+/* Window starts [from, to) of the document, all of which fit */
+static void scanRange(Search_t *s, size_t from, size_t to) {
+    const uint8_t *a, *b;
+    size_t alen, blen;
+    docSegments(s->doc, &a, &alen, &b, &blen);
+
+    // Windows wholly before the gap
+    size_t split = alen >= s->len ? alen - s->len + 1 : 0;
+    if (from < split) {
+        size_t end = to < split ? to : split;
+        scanSpan(s, a + from, from, end - from);
+        from = end;
+    }
+    // Straddling it, through a stitched copy
+    if (from < to && from < alen) {
+        uint8_t window[2 * SEARCH_PATTERN_MAX];
+        size_t end = to < alen ? to : alen;
+        size_t got = docCopy(s->doc, from, end - from + s->len - 1, window);
+        if (got >= s->len) scanSpan(s, window, from, got - s->len + 1);
+        from = end;
+    }
+    // Wholly after
+    if (from < to) scanSpan(s, b + (from - alen), from, to - from);
+}
+
+bool searchInit(Search_t *s, MemArena_t *arena, uint32_t capacity) {
+    memset(s, 0, sizeof(*s));
+    if (!fold_byte['A']) foldInit();
+    s->stack = s->matches = memArenaAlloc(arena, capacity * sizeof(uint32_t), 4);
+    s->stack_size = s->capacity = s->matches ? capacity : 0;
+    return s->matches != NULL;
+}
+
+/* Folded pattern and skip table for the first s->len bytes of s->pat */
+static void compile(Search_t *s) {
+    for (size_t i = 0; i < s->len; i++) s->folded[i] = s->fold ? fold_byte[s->pat[i]] : s->pat[i];
+    memset(s->shift, s->len, sizeof(s->shift));
+    for (size_t i = 0; i + 1 < s->len; i++) s->shift[s->folded[i]] = s->len - 1 - i;
+}
+
+bool searchStart(Search_t *s, const Doc_t *doc, const uint8_t *pat, size_t len, bool fold, size_t pos) {
+    searchStop(s);
+    s->depth = 0;
+    s->matches = s->stack;
+    s->capacity = s->stack_size;
+    if (len == 0 || len > SEARCH_PATTERN_MAX) return false;
+    s->doc = doc;
+    s->version = doc->version;
+    s->len = len;
+    s->fold = fold;
+    memcpy(s->pat, pat, len);
+    compile(s);
+
+    size_t windows = docLength(doc) >= len ? docLength(doc) - len + 1 : 0;
+    s->origin = s->scan = pos < windows ? pos : 0;
+    s->wrapped = false;
+    s->count = s->wrap_index = 0;
+    s->overflow = false;
+    s->running = windows > 0;
+    return true;
+}
+
+bool searchStep(Search_t *s, size_t budget) {
+    if (!s->running) return false;
+    if (!searchValid(s) || docLength(s->doc) < s->len) {
+        s->running = false;
+        return false;
+    }
+    size_t windows = docLength(s->doc) - s->len + 1;
+    size_t stop = s->wrapped ? s->origin : windows;
+    size_t to = (stop - s->scan > budget) ? s->scan + budget : stop;
+
+    scanRange(s, s->scan, to);
+    s->scan = to;
+    if (s->scan == stop) {
+        if (s->wrapped || s->origin == 0) s->running = false;
+        else {
+            s->wrapped = true;
+            s->wrap_index = s->count;
+            s->scan = 0;
+        }
+    }
+    return s->running;
+}
+
+void searchStop(Search_t *s) {
+    s->running = false;
+}
+
+/* The current pattern matches at pos */
+static bool matchAt(const Search_t *s, size_t pos) {
+    uint8_t text[SEARCH_PATTERN_MAX];
+    if (docCopy(s->doc, pos, s->len, text) != s->len) return false;
+    if (!s->fold) return memcmp(text, s->pat, s->len) == 0;
+    for (size_t i = 0; i < s->len; i++)
+        if (fold_byte[text[i]] != s->folded[i]) return false;
+    return foldEqual(text, s->pat, s->len);
+}
+
+bool searchNarrow(Search_t *s, const uint8_t *pat, size_t len, bool fold) {
+    if (!searchValid(s) || s->overflow || len <= s->len || len > SEARCH_PATTERN_MAX || (fold && !s->fold) ||
+        memcmp(pat, s->pat, s->len) != 0)
+        return false;
+
+    // Keep the current set below if there is room for a filtered copy
+    uint32_t *from = s->matches, *to = s->matches;
+    if (s->depth < SEARCH_PATTERN_MAX && s->count <= s->capacity - s->count) {
+        s->levels[s->depth++] = (SearchLevel_t){
+            .len = s->len, .fold = s->fold, .wrapped = s->wrapped, .running = s->running,
+            .overflow = s->overflow, .scan = s->scan, .count = s->count, .wrap_index = s->wrap_index,
+        };
+        to = s->matches + s->count;
+        s->capacity -= s->count;
+    }
+    memcpy(s->pat, pat, len);
+    s->len = len;
+    s->fold = fold;
+    compile(s);
+
+    uint32_t n = 0, wrap_index = 0;
+    for (uint32_t i = 0; i < s->count; i++) {
+        if (i == s->wrap_index) wrap_index = n;
+        if (matchAt(s, from[i])) to[n++] = from[i];
+    }
+    if (s->count == s->wrap_index) wrap_index = n;
+    s->matches = to;
+    s->count = n;
+    s->wrap_index = s->wrapped ? wrap_index : 0;
+    // A scan in progress stops short of windows the longer pattern no longer fits
+    size_t windows = docLength(s->doc) >= len ? docLength(s->doc) - len + 1 : 0;
+    if (s->scan > windows) s->scan = windows;
+    if (s->origin > windows) s->origin = windows;
+    return true;
+}
+
+bool searchWiden(Search_t *s, size_t len, bool fold) {
+    while (s->depth && s->levels[s->depth - 1].len >= len) {
+        const SearchLevel_t *l = &s->levels[--s->depth];
+        s->matches -= l->count;
+        s->capacity += l->count;
+        s->len = l->len;
+        s->fold = l->fold;
+        s->wrapped = l->wrapped;
+        s->running = l->running;
+        s->overflow = l->overflow;
+        s->scan = l->scan;
+        s->count = l->count;
+        s->wrap_index = l->wrap_index;
+        if (s->len == len) break;
+    }
+    if (s->len != len || s->fold != fold || !searchValid(s)) return false;
+    compile(s);
+    return true;
+}
+
+bool searchValid(const Search_t *s) {
+    return s->doc && s->len && s->version == s->doc->version;
+}
+
+/* First index in m[0..n) holding an offset >= pos */
+static uint32_t lowerBound(const uint32_t *m, uint32_t n, size_t pos) {
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (m[mid] < pos) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* The two ascending runs, before and after the wrap */
+static void runs(const Search_t *s, const uint32_t **r1, uint32_t *n1, const uint32_t **r2, uint32_t *n2) {
+    *n1 = s->wrapped ? s->wrap_index : s->count;
+    *r1 = s->matches;
+    *r2 = s->matches + *n1;
+    *n2 = s->count - *n1;
+}
+
+size_t searchFirstIn(const Search_t *s, size_t from, size_t to) {
+    const uint32_t *r1, *r2;
+    uint32_t n1, n2, i;
+    size_t best = SEARCH_NONE;
+    if (!searchValid(s)) return SEARCH_NONE;
+    runs(s, &r1, &n1, &r2, &n2);
+    if ((i = lowerBound(r1, n1, from)) < n1 && r1[i] < to) best = r1[i];
+    if ((i = lowerBound(r2, n2, from)) < n2 && r2[i] < to && r2[i] < best) best = r2[i];
+    return best;
+}
+
+size_t searchFind(const Search_t *s, size_t pos, bool forward) {
+    const uint32_t *r1, *r2;
+    uint32_t n1, n2, i;
+    size_t best = SEARCH_NONE;
+    if (!searchValid(s) || !s->count) return SEARCH_NONE;
+    runs(s, &r1, &n1, &r2, &n2);
+
+    if (forward) {
+        best = searchFirstIn(s, pos, SEARCH_NONE);
+        if (best == SEARCH_NONE) best = n2 ? r2[0] : r1[0];     // wrap to the first
+    }
+    else {
+        if ((i = lowerBound(r1, n1, pos)) > 0) best = r1[i - 1];
+        if ((i = lowerBound(r2, n2, pos)) > 0 && (best == SEARCH_NONE || r2[i - 1] > best)) best = r2[i - 1];
+        if (best == SEARCH_NONE) best = n1 ? r1[n1 - 1] : r2[n2 - 1];   // wrap to the last
+    }
+    return best;
+}
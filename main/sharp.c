@@ -13,14 +13,32 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_system.h"
 #include "driver/spi_master.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
-#include "zap-vga16-raw-neg.h"
 #include "keyboard_input.h"
-#define PSF_GLYPH_SIZE 16
+#include "sharp.h"
+#include "render.h"
+#include "vcom.h"
+#include "power.h"
+#include "resume.h"
+#include "mem.h"
+#include "tasks.h"
+#include "console.h"
+#include "trace.h"
+#include "stats.h"
+#include "keymap.h"
+#include "glyphstore.h"
+#include "fbops.h"
+#include "compositor.h"
+#include "cursor.h"
+#include "editor.h"
+#include "spell.h"
+#include "docstore.h"
 
 /*
  This example demonstrates the use of both spi_device_transmit as well as
@@ -40,11 +58,6 @@
 #define PIN_NUM_MOSI 35
 #define PIN_NUM_CLK  36
 #define PIN_NUM_CS   38
-#define PIN_NUM_VCOM   33
-#define PIN_BLUE_LED   13
-
-#define PXWIDTH 320
-#define PXHEIGHT 240
 
 
 #define KEY(r, c) ((r << 3) + c)
@@ -52,6 +65,8 @@
 
 #define KBD_EVENT_QUEUE_LENGTH 32
 #define KBD_EVENT_SIZE sizeof( uint8_t )
+/* Not a key: run the console's call_fn on the key task (keyTaskCall()) */
+#define KBD_EVENT_CALL (KEYDOWN_MASK | KEY_MASK)
 
 #define SPI_TAG "spi_protocol"
 void displayInit(void);
@@ -63,51 +78,43 @@ void display_write_data(uint8_t addr, uint8_t data);
 StaticQueue_t kbd_StaticQueue;
 uint8_t kbd_QueueStorage[ KBD_EVENT_QUEUE_LENGTH * KBD_EVENT_SIZE ];
 QueueHandle_t keyboard;
+static QueueSlot_t kbd_slot = { .name = "keyboard", .length = KBD_EVENT_QUEUE_LENGTH };
 
+/* One call at a time handed to the key task, see keyTaskCall() */
+static void (*call_fn)(void *arg);
+static void *call_arg;
+static StaticSemaphore_t call_lock_buf, call_done_buf;
+static SemaphoreHandle_t call_lock, call_done;
 
-spi_device_handle_t spi;
-DMA_ATTR uint8_t *sharpmem_buffer = NULL;
-
-typedef struct {
-    enum Mode {
-	HIDDEN,
-        NORMAL,
-	INSERT,
-	REPLACE
-    } mode;
-    uint8_t x;
-    uint8_t y;
-} Cursor_t;
 
+spi_device_handle_t spi;
 
-void vcom_toggle_task(void *pvParameters) 
-{
-    gpio_set_direction(PIN_NUM_VCOM, GPIO_MODE_OUTPUT);
-    gpio_set_direction(PIN_BLUE_LED, GPIO_MODE_OUTPUT);
-    while (1) {
-        // Toggle the GPIO state
-        gpio_set_level((gpio_num_t)PIN_NUM_VCOM, 0);
-        gpio_set_level((gpio_num_t)PIN_BLUE_LED, 0);
-        vTaskDelay(500 / portTICK_PERIOD_MS); // Delay for 1 second
-        gpio_set_level((gpio_num_t)PIN_NUM_VCOM, 1);
-        gpio_set_level((gpio_num_t)PIN_BLUE_LED, 1);
-        vTaskDelay(500 / portTICK_PERIOD_MS); // Delay for 1 second
-    }
+/* Framebuffer and line staging are static in internal, DMA-capable SRAM.
+ * Lines go out framed by sharpFrameLines(). A whole set of
+ * dirty lines is sent under one CS window, batched LINES_PER_TRANS lines per
+ * SPI transaction, instead of one transaction per line. */
+#define LINES_PER_TRANS 24
+static DMA_ATTR uint8_t framebuffer[(PXWIDTH * PXHEIGHT) / 8] __attribute__((aligned(FBOPS_ALIGN)));
+static DMA_ATTR uint8_t line_batch[1 + LINES_PER_TRANS * SHARP_LINE_FRAME + 1];
+uint8_t *sharpmem_buffer = framebuffer;
+
+/* Serializes CS windows between the flush path and VCOM maintenance */
+static StaticSemaphore_t display_lock_buf;
+static SemaphoreHandle_t display_lock;
+static bool inverted = false;
+
+/* Command byte with the current software VCOM polarity; under display_lock */
+static uint8_t commandByte(uint8_t cmd) {
+  return cmd | (vcomPhase() ? SHARPMEM_BIT_VCOM : 0);
 }
 
 
 void displayInit(void)
 {
-    // Start the VCOM toggling task
-    xTaskCreate(&vcom_toggle_task, "vcom", 2048, NULL, 5, NULL);
-
     esp_err_t ret;
-    /* Allocate pixel buffer for SHARP DISP*/
-    sharpmem_buffer = (uint8_t *)malloc((PXWIDTH * PXHEIGHT) / 8);
-    if (!sharpmem_buffer) {
-      printf("Error: sharpmem_buffer was NOT allocated\n\n");
-      return;
-    }
+    display_lock = xSemaphoreCreateMutexStatic(&display_lock_buf);
+    memRegisterStatic("framebuffer", sizeof(framebuffer), MEM_DMA);
+    memRegisterStatic("line stage", sizeof(line_batch), MEM_DMA);
 
     gpio_set_direction(PIN_NUM_CS, GPIO_MODE_OUTPUT);                   // Setting the CS' pin to work in OUTPUT mode
 
@@ -121,7 +128,7 @@ void displayInit(void)
     };
 
     spi_device_interface_config_t devcfg = {
-        .clock_speed_hz = 2 * 1000 * 1000,                             // Clock out at 12 MHz
+        .clock_speed_hz = SHARP_SPI_CLOCK_HZ,                          // Clock out at 2 MHz
         .mode = 0,                                                      // SPI mode 0: CPOL:-0 and CPHA:-0
         .spics_io_num = -1,                                     // Control the CS ourselves
         .flags = (SPI_DEVICE_TXBIT_LSBFIRST | SPI_DEVICE_3WIRE),
@@ -135,9 +142,7 @@ void displayInit(void)
     ESP_ERROR_CHECK(ret);
     printf("SPI initialized. MOSI:%d CLK:%d CS:%d\n", PIN_NUM_MOSI, PIN_NUM_CLK, PIN_NUM_CS);
     gpio_set_level((gpio_num_t)PIN_NUM_CS, 0);
-
-    // Wait and clear display
-    vTaskDelay(100 / portTICK_PERIOD_MS); 
+    vcomInit();
 }
 
 
@@ -162,11 +167,16 @@ uint8_t getPixel(uint16_t x, uint16_t y) {
   return sharpmem_buffer[(y * PXWIDTH + x) / 8] & set[x & 7] ? 1 : 0;
 }
 
-void clearDisplay() {
+void clearDisplay(void) {
   memset(sharpmem_buffer, 0xff, (PXWIDTH * PXHEIGHT) / 8);
+  if (inverted) {         // the panel clears to white, send the dark frame instead
+    refreshDisplay();
+    return;
+  }
+  xSemaphoreTake(display_lock, portMAX_DELAY);
   gpio_set_level((gpio_num_t)PIN_NUM_CS, 1);
-  esp_rom_delay_us(6);
-  uint8_t clear_data[2] = {(uint8_t)(SHARPMEM_BIT_CLEAR), 0x00};
+  esp_rom_delay_us(SHARP_CS_SETUP_US);
+  uint8_t clear_data[2] = {commandByte(SHARPMEM_BIT_CLEAR), 0x00};
   esp_err_t ret;
   spi_transaction_t t;
   memset(&t, 0, sizeof(t));        //Zero out the transaction
@@ -174,106 +184,120 @@ void clearDisplay() {
   t.tx_buffer = clear_data;
   ret = spi_device_polling_transmit(spi, &t); // spi_device_polling_transmit
   gpio_set_level((gpio_num_t)PIN_NUM_CS, 0);
-  esp_rom_delay_us(2);
+  esp_rom_delay_us(SHARP_CS_HOLD_US);
+  xSemaphoreGive(display_lock);
+  STAT_ADD(spi_bytes, sizeof(clear_data));
+  STAT_INC(spi_transactions);
+  STAT_INC(full_refreshes);
   //printf("clearDisplay b1:%02x 2:%02x lenght:%d\n\n", clear_data[0], clear_data[1], t.length);
   assert(ret==ESP_OK);
+  (void)ret;                      // unused once NDEBUG drops the assert
 }
 
-void refreshDisplay(void) {
-  uint16_t i, currentline;
-
+static void sendBatch(size_t len) {
   esp_err_t ret;
   spi_transaction_t t;
   memset(&t, 0, sizeof(t));       //Zero out the transaction
-
-  gpio_set_level((gpio_num_t)PIN_NUM_CS, 1);
-  esp_rom_delay_us(6);
-  uint8_t write_data[1] = {(uint8_t)SHARPMEM_BIT_WRITECMD};
-  t.length = sizeof(write_data)*8;                  //Each data byte is 8 bits
-  t.tx_buffer = write_data;
+  t.length = len * 8;
+  t.tx_buffer = line_batch;
+  trace(TRACE_SPI_BEGIN, 0, 0, len);
+  STAT_ADD(spi_bytes, len);
+  STAT_INC(spi_transactions);
   ret = spi_device_transmit(spi, &t);
+  trace(TRACE_SPI_END, 0, 0, 0);
+  assert(ret==ESP_OK);
+  (void)ret;
+}
 
-  uint8_t bytes_per_line = PXWIDTH / 8;
-  uint16_t totalbytes = (PXWIDTH * PXHEIGHT) / 8;
-
-  for (i = 0; i < totalbytes; i += bytes_per_line) {
-    uint8_t line[bytes_per_line + 2];
+void updateLines(const LineMask_t dirty) {
+  uint16_t y = 0, lines = 0;
+  size_t n;
 
-    // Send address byte
-    currentline = ((i + 1) / (PXWIDTH / 8)) + 1;
-    line[0] = currentline;
-    // copy over this line
-    memcpy(line + 1, sharpmem_buffer + i, bytes_per_line);
-    // Send end of line
-    line[bytes_per_line + 1] = 0x00;
+  for (int w = 0; w < DIRTY_WORDS; w++) lines += __builtin_popcount(dirty[w]);
+  if (!lines) return;
+  trace(TRACE_FLUSH_BEGIN, 0, lines, 0);
+#if STATS_ENABLED
+  int64_t t0 = esp_timer_get_time();
+#endif
 
-    t.length = (bytes_per_line+2) *8; // bytes_per_line+2
-    t.tx_buffer = line;
-    ret = spi_device_transmit(spi, &t);
-    assert(ret==ESP_OK);
+  xSemaphoreTake(display_lock, portMAX_DELAY);
+  gpio_set_level((gpio_num_t)PIN_NUM_CS, 1);
+  esp_rom_delay_us(SHARP_CS_SETUP_US);
+  line_batch[0] = commandByte(SHARPMEM_BIT_WRITECMD);
+  n = 1;
+  for (;;) {
+    // Keep a byte free for the trailer
+    n += sharpFrameLines(line_batch + n, sizeof(line_batch) - 1 - n, compLine, dirty, &y, inverted);
+    if (y >= PXHEIGHT) break;
+    sendBatch(n);
+    n = 0;
   }
   // Send another trailing 8 bits for the last line
-  int last_line[1] = {0x00};
-  t.length = 8;
-
-  t.tx_buffer = last_line;
-  ret = spi_device_transmit(spi, &t); // spi_device_polling_transmit
+  line_batch[n++] = 0x00;
+  sendBatch(n);
   gpio_set_level((gpio_num_t)PIN_NUM_CS, 0);
-  esp_rom_delay_us(2);
-
-  assert(ret==ESP_OK);
-  }
+  esp_rom_delay_us(SHARP_CS_HOLD_US);
+  xSemaphoreGive(display_lock);
+  trace(TRACE_FLUSH_END, 0, 0, 0);
+
+#if STATS_ENABLED
+  uint32_t dt = esp_timer_get_time() - t0;
+  if (lines == PXHEIGHT) STAT_INC(full_refreshes);
+  else STAT_INC(partial_refreshes);
+  STAT_ADD(lines_sent, lines);
+  STAT_ADD(lines_skipped, PXHEIGHT - lines);
+  STAT_ADD(flush_us, dt);
+  STAT_MAX(flush_us_max, dt);
+#endif
+}
 
-void updateRow(uint8_t row) {
-  uint8_t i;
+/* Software VCOM: send a bare command byte if a flip is due and no transfer
+ * made it. A flush in progress will, so never wait for one. */
+void displayMaintainVcom(void) {
+  if (!display_lock || !vcomDue()) return;
+  if (xSemaphoreTake(display_lock, 0) != pdTRUE) return;
 
   esp_err_t ret;
   spi_transaction_t t;
-  memset(&t, 0, sizeof(t));       //Zero out the transaction
-
+  uint8_t maintain[2] = {commandByte(0), 0x00};
+  memset(&t, 0, sizeof(t));
+  t.length = sizeof(maintain)*8;
+  t.tx_buffer = maintain;
   gpio_set_level((gpio_num_t)PIN_NUM_CS, 1);
-  esp_rom_delay_us(1);
-  uint8_t write_data[1] = {(uint8_t)SHARPMEM_BIT_WRITECMD};
-  t.length = sizeof(write_data)*8;                  //Each data byte is 8 bits
-  t.tx_buffer = write_data;
-  ret = spi_device_transmit(spi, &t);
-
-  uint8_t bytes_per_line = PXWIDTH / 8;
-  uint8_t line[bytes_per_line + 2];
-  line[0] = (uint8_t)(PSF_GLYPH_SIZE * row);
-
-  for (i = 0; i < PSF_GLYPH_SIZE; i++) {
-    memcpy(line + 1, sharpmem_buffer + line[0]*bytes_per_line, bytes_per_line);
-    line[0]++;
-    line[bytes_per_line + 1] = 0x00;
-
-    t.length = (bytes_per_line+2) *8; // bytes_per_line+2
-    t.tx_buffer = line;
-    ret = spi_device_transmit(spi, &t);
-    assert(ret==ESP_OK);
-  }
-  // Send another trailing 8 bits for the last line
-  int last_line[1] = {0x00};
-  t.length = 8;
-
-  t.tx_buffer = last_line;
-  ret = spi_device_transmit(spi, &t); // spi_device_polling_transmit
+  esp_rom_delay_us(SHARP_CS_SETUP_US);
+  ret = spi_device_polling_transmit(spi, &t);
   gpio_set_level((gpio_num_t)PIN_NUM_CS, 0);
-  esp_rom_delay_us(1);
-
+  esp_rom_delay_us(SHARP_CS_HOLD_US);
+  xSemaphoreGive(display_lock);
   assert(ret==ESP_OK);
-  }
+  (void)ret;
+}
 
+void refreshDisplay(void) {
+  LineMask_t all;
+  memset(all, 0xff, sizeof(all));
+  updateLines(all);
+}
 
-void displayChar(uint8_t index, Cursor_t *cur) {
-    for (int m =0; m < PSF_GLYPH_SIZE; m++) {
-       sharpmem_buffer[(( (cur->y) * PSF_GLYPH_SIZE +m)*PXWIDTH + 8 * (cur->x)) / 8] = zap_vga16_psf[ index * PSF_GLYPH_SIZE +m];
-    }
-    updateRow(cur->y);
+void updateRow(uint8_t row) {
+  LineMask_t rows = {0};
+  for (uint8_t i = 0; i < PSF_GLYPH_SIZE; i++)
+    LINEMASK_SET(rows, row * PSF_GLYPH_SIZE + i);
+  updateLines(rows);
 }
 
 
-void clearDisplayBuffer() {
+void displaySetInverted(bool on) {
+  if (on == inverted) return;
+  inverted = on;
+  refreshDisplay();
+}
+
+bool displayInverted(void) {
+  return inverted;
+}
+
+void clearDisplayBuffer(void) {
   memset(sharpmem_buffer, 0xFF, (PXWIDTH * PXHEIGHT) / 8);
 }
 
@@ -306,95 +330,243 @@ static void vKeyboardSimuTask( void *pvParameters )
         //keyevent++;
         //if (xQueueSend( keyboard , (void *)&keyevent , portMAX_DELAY) == pdTRUE) {
         if (xQueueSend( keyboard , &keyevent[ m ] , portMAX_DELAY) == pdTRUE) {
-            printf("Item Send: %d \n", keyevent[ m ]);
+            queueNoteDepth(&kbd_slot);
         }
         else {
+            STAT_INC(keys_dropped);
             printf("Item Send FALSE\n");
         }
     }}
-    vTaskDelete( NULL ); // needs to be called for the task to finish without errors.
+    tasksExit(); // needs to be called for the task to finish without errors.
 }
  
 
 
+/* SYS pops the counters up in the status layer over the bottom text row;
+ * the text underneath comes back when it closes */
+static void toggleStatusOverlay(void)
+{
+    if (compVisible(LAYER_STATUS)) {
+        compShow(LAYER_STATUS, false);
+        return;
+    }
+    char line[TEXT_COLS + 1];
+    statsFormatLine(line, sizeof(line));
+    compClear(LAYER_STATUS);
+    compPutText(LAYER_STATUS, 0, 0, line, FONT_INVERSE);
+    compShow(LAYER_STATUS, true);
+}
+
+
+/* LANG is a deadkey: LANG + e, u, i, n picks Spanish, English, Italian or
+ * Norwegian (keyboard_input.h). Only the spelling dictionary follows it so
+ * far; the next redraw checks the screen again. */
+static void selectLanguage(uint32_t cp)
+{
+    const char *code = cp == 'e' ? "es" : cp == 'u' ? "en" : cp == 'i' ? "it" : cp == 'n' ? "no" : NULL;
+    if (!code) return;
+    if (spellSetLanguage(code)) printf("Spell: %s\n", code);
+    else printf("Spell: no %s dictionary\n", code);
+}
+
+
+/* pdMS_TO_TICKS() rounds down, and a wait of less than a tick comes out as
+ * 0: the task would poll the queue instead of blocking. Round up. */
+static TickType_t ticksFor(uint32_t ms) {
+    return pdMS_TO_TICKS(ms + portTICK_PERIOD_MS - 1);
+}
+
+/* Sleep until the next cursor blink or resume snapshot, whichever is first,
+ * or just poll for keys while the editor has background work. A save
+ * writes a block a tick, and a loaded document's words are counted a slice
+ * a tick, so lower priority tasks run (and the chip idles) between them
+ * instead of the key task spinning on the queue. */
+static TickType_t nextWait(const Editor_t *ed, bool snapshot_pending, TickType_t snapshot_at) {
+    TickType_t wait = portMAX_DELAY;
+    if (editorBusy(ed)) return editorSeeding(ed) ? 1 : 0;
+    if (docStoreBusy()) return 1;
+    uint32_t blink = cursorNextBlinkMs();
+    if (blink) wait = ticksFor(blink);
+    if (snapshot_pending) {
+        int32_t left = (int32_t)(snapshot_at - xTaskGetTickCount());
+        if (left < 0) left = 0;
+        if ((TickType_t)left < wait) wait = left;
+    }
+    return wait;
+}
+
 /* And this could be the processing of the keyboard keys using the keymapping*/
 static void vProcessKeyTask( void *pvParameters )
 {
     uint8_t key = 0;   // received key-event data
-    uint8_t fontchar = 0;
-    Cursor_t *cur = (Cursor_t *) pvParameters;
+    Editor_t *ed = (Editor_t *) pvParameters;
+    Cursor_t *cur = ed->cur;
+    TickType_t wait = nextWait(ed, false, 0);
+    TickType_t snapshot_at = 0;
+    bool snapshot_pending = false;
+    bool running = false;
+    bool lang = false;
     while (1) {
-        if (xQueueReceive( keyboard , (void *)&key, portMAX_DELAY) == pdTRUE) {  //this is blocking inf.
-	    bool keydown = (key & KEYDOWN_MASK);
-	    bool modifier = (key & MOD_MASK);
-
-	    if ( modifier ) {
-		    printf("Key is a modifier \n");
-		    if ( keydown ) KBD_MODS |= (key & KEY_MASK );
-		    else KBD_MODS &= ~(key & KEY_MASK );
+        if (xQueueReceive( keyboard , (void *)&key, wait) == pdTRUE) {  //blocking until input, blink or snapshot time
+	    powerInputActive();
+	    if (!running) trace(TRACE_TASK_RUN, TRACE_TASK_KEYBOARD, 0, 0);
+	    running = true;
+	    KeyInput_t in;
+
+	    if (key == KBD_EVENT_CALL) {
+	        // Console work between keys; the burst end below redraws over it
+	        call_fn(call_arg);
+	        xSemaphoreGive(call_done);
+	        cursorMove(cur);
+	        cursorActivity();
 	    }
-	    else if ( keydown ) {
-		    Virtual_Key vk = keymap[ (key & KEY_MASK) ];
-		    if (vk < VKCHAROFFSET) {
-		        printf("Key is a control key (non printable) \n");
-		    }
-		    else {
-		        fontchar = fontmap[vk - VKCHAROFFSET];
-                        displayChar(fontchar, cur);
-			cur->x++;
-			if (cur->x == 40) {
-			    cur->y++;
-			    cur->x = 0;
-			    if (cur->y == 14) cur->y = 0;
-			}
-	                //curx++;
-			//if (curx > 39) { 
-			//	curx = 0 ; 
-			//	cury++;
-			//	cury = cury %15;
-			//}
-		    }
+	    else {
+	        trace(TRACE_KEY, key, 0, 0);
+	        STAT_INC(keys_received);
+	        if ( keymapTranslate(key, &in) ) {
+		        if (in.vk == VK_SYS) {
+		            toggleStatusOverlay();
+		        }
+		        else if (in.vk == VK_LANG || lang) {
+		            if (lang) selectLanguage(in.codepoint);
+		            lang = !lang;
+		        }
+		        else {
+		            editorKey(ed, &in);
+		        }
+		        cursorActivity();
+	        }
 	    }
-	    /* Associate the key event with a key through the keymap,
-	     * Then, if it is a modifier, change the modifiers byte, 
-	     * Then, if check what does result from the combination of all modifiers,
-	     * If it results in a system/control, call the respective function.
-	     * If it results in a printable character,
-	     * check if the combination produces another control secquence (either
-	     * in the editor or in any other framework...(editor normal mode, wifi menu...)
-	     * Depending on the status, the printable character is then
-	     * interpreted as unicode to save the text, and simultaneously
-	     * mapped to the font to produce the glyph on display.
-	     */
         }
         else {
-            printf("Item Receive FALSE\n");
+            // Background work (a search scanning) between keys
+            if (editorBackground(ed)) {
+                editorRedraw(ed);
+                cursorMove(cur);
+                renderFlush();
+            }
+            // A save in progress writes a block between keys
+            if (docStoreBusy()) docStoreStep(&ed->doc);
+            // Blink: the cursor layer's lines are all that go out
+            if (cursorTick()) renderFlush();
+            // Input went idle: keep the saved document and the resume snapshot
+            // current. A save goes first and the snapshot waits for it, so
+            // the picture is tagged with the save it shows.
+            if (snapshot_pending && !docStoreBusy() && (int32_t)(snapshot_at - xTaskGetTickCount()) <= 0) {
+                uint32_t again = docStoreAutosave(&ed->doc, ed->point, ed->top);
+                if (!docStoreBusy()) {
+                    uint32_t snap = resumeSnapshot(cur, docStoreStamp(&ed->doc));
+                    if (snap && (!again || snap < again)) again = snap;
+                }
+                snapshot_pending = (again != 0) || docStoreBusy();
+                snapshot_at = xTaskGetTickCount() + ticksFor(again);
+            }
+            wait = nextWait(ed, snapshot_pending, snapshot_at);
+            continue;
         }
-        vTaskDelay(1);
+        // Push everything typed so far once the burst is drained, then let the chip sleep
+        if (uxQueueMessagesWaiting(keyboard) == 0) {
+            // One layout and one flush for the whole burst, however many keys
+            editorRedraw(ed);
+            cursorMove(cur);
+            renderFlush();
+            trace(TRACE_TASK_WAIT, TRACE_TASK_KEYBOARD, 0, 0);
+            running = false;
+            powerInputIdle();
+            snapshot_pending = true;
+            snapshot_at = xTaskGetTickCount() + pdMS_TO_TICKS(RESUME_IDLE_MS);
+        }
+        wait = nextWait(ed, snapshot_pending, snapshot_at);
+        }
+}
+
+
+/* All runtime tasks, with stacks and TCBs in static storage. Sizes come
+ * from the peak column of the "tasks" console report plus headroom. */
+static Cursor_t cursor; // initializes to position (0,0)
+static Editor_t editor;
+TASK_STATIC(keyboard, 6144);      // render flush, resume snapshot (NVS), document save, search: 3.6 KB peak on the host (test_stack)
+TASK_STATIC(keysimu, 2048);
+
+static TaskSlot_t task_table[] = {
+    TASK_ENTRY(keyboard, vProcessKeyTask, "keyboard", 5, &editor),
+    TASK_ENTRY(keysimu, vKeyboardSimuTask, "keysimu", 5, NULL),
+};
+
+void keyTaskCall(void (*fn)(void *arg), void *arg)
+{
+    uint8_t event = KBD_EVENT_CALL;
+
+    if (!keyboard || xTaskGetCurrentTaskHandle() == task_table[0].handle) {
+        fn(arg);
+        return;
     }
+    xSemaphoreTake(call_lock, portMAX_DELAY);
+    call_fn = fn;
+    call_arg = arg;
+    xQueueSend(keyboard, &event, portMAX_DELAY);
+    queueNoteDepth(&kbd_slot);
+    xSemaphoreTake(call_done, portMAX_DELAY);
+    xSemaphoreGive(call_lock);
 }
 
 
 void app_main(void)
 {
+    powerInit();
+    memInit();
+    compInit();
+    compPlace(LAYER_STATUS, 0, PXHEIGHT - PSF_GLYPH_SIZE, BYTES_PER_LINE, PSF_GLYPH_SIZE, BLEND_COPY);
+
     // Initialize Display
     displayInit();
-    clearDisplay();
+    renderSetRotation(RENDER_ROTATION);
 
-    static Cursor_t cursor; // initializes to position (0,0)
-    cursor.mode = NORMAL;
+    // Bring the last screen back before anything else
     Cursor_t *cur = &cursor;
-    //cur->x = 0;
+    ResumeSource resumed = resumeBoot(cur);
+    switch (resumed) {
+    case RESUME_WARM:       // panel still shows it
+        break;
+    case RESUME_FLASH:
+        vTaskDelay(100 / portTICK_PERIOD_MS);   // panel power-up
+        refreshDisplay();
+        break;
+    default:
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+        clearDisplay();
+        break;
+    }
+
+    glyphStoreInit();
+    spellInit();
+    docStoreInit();
+    editorInit(&editor, cur, &doc_arena, EDITOR_DOC_SIZE);
+    size_t point, top;
+    bool loaded = docStoreLoad(&editor.doc, &point, &top);
+    if (loaded) editorRestore(&editor, point, top);
+    // The picture must be of the document loaded, else draw that instead
+    if (resumed == RESUME_NONE ? loaded : resumeDocStamp() != docStoreStamp(&editor.doc))
+        editorRedraw(&editor);
+    cursorMove(cur);
+    cursorActivity();
+    renderFlush();
+    printf("Boot to usable: %" PRId64 " us\n", esp_timer_get_time());
     
     // Start reading the keyboard
+    call_lock = xSemaphoreCreateMutexStatic(&call_lock_buf);
+    call_done = xSemaphoreCreateBinaryStatic(&call_done_buf);
     keyboard = xQueueCreateStatic( KBD_EVENT_QUEUE_LENGTH, // The number of items the queue can hold.
                          KBD_EVENT_SIZE,      // The size of each item in the queue
                          &( kbd_QueueStorage[ 0 ] ), // The buffer that will hold the items in the queue.
                          &kbd_StaticQueue ); // The buffer that will hold the queue structure.
-    xTaskCreate(vProcessKeyTask, "keyboard", 2048, (void *) cur, 5, NULL);
-    xTaskCreate(vKeyboardSimuTask, "keysimu", 2048, NULL, 5, NULL);
-    while(1) {
-     vTaskDelay(pdMS_TO_TICKS(10000)); 
-    }
+    kbd_slot.handle = keyboard;
+    tasksRegisterQueue(&kbd_slot);
+    tasksStart(task_table, sizeof(task_table) / sizeof(task_table[0]));
+
+    memReport();
+    tasksReport();
+    consoleInit();
+    // Nothing left for the main task; returning deletes it instead of waking it every 10 s
 }
 
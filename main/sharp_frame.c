@@ -0,0 +1,26 @@
+/*
+ *  Sharp line framing, kept apart from the SPI driver so it has no IDF
+ *  dependencies. See sharpFrameLines() in sharp.h.
+ */
+#include <string.h>
+#include "sharp.h"
+
+void sharpFramebufferLine(uint16_t y, uint8_t *dst) {
+    memcpy(dst, sharpmem_buffer + y * BYTES_PER_LINE, BYTES_PER_LINE);
+}
+
+size_t sharpFrameLines(uint8_t *dst, size_t cap, LineSource line, const LineMask_t dirty, uint16_t *y, bool invert) {
+    size_t n = 0;
+
+    for (; *y < PXHEIGHT; (*y)++) {
+        if (!LINEMASK_TEST(dirty, *y)) continue;
+        if (n + SHARP_LINE_FRAME > cap) break;
+        dst[n] = (uint8_t)(*y + 1);
+        line(*y, dst + n + 1);
+        if (invert)
+            for (int i = 0; i < BYTES_PER_LINE; i++) dst[n + 1 + i] = ~dst[n + 1 + i];
+        dst[n + SHARP_LINE_FRAME - 1] = 0x00;
+        n += SHARP_LINE_FRAME;
+    }
+    return n;
+}
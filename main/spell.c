@@ -0,0 +1,264 @@
+/*
+ *  Flash DAWG spell checker. See spell.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_partition.h"
+#include "spell.h"
+#include "search.h"
+#include "doc.h"
+#include "mem.h"
+
+#define DICT_MAGIC 0x44535754       /* "TWSD" */
+#define DICT_VERSION 2
+#define EDGE_LAST 0x100
+#define EDGE_FINAL 0x200
+#define CHILD_SHIFT 10
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t size;
+    uint32_t reserved;
+} DictHeader_t;
+
+typedef struct {
+    char code[4];
+    uint32_t root;
+    uint32_t offset;
+    uint32_t edges;
+    uint32_t words;
+    uint32_t ranked;        /* words kept for completion, most frequent first */
+    uint32_t rank_offset;   /* their trie, RankEdge_t */
+    uint32_t rank_edges;
+    uint32_t text_offset;   /* ranked + 1 end offsets, then the words */
+} DictLang_t;
+
+/* An edge of the completion trie, with the best words below it */
+typedef struct {
+    uint32_t edge;
+    uint16_t top[SPELL_COMPLETE_TOP];
+} RankEdge_t;
+
+#define NO_WORD 0xFFFF
+
+static const DictLang_t *langs = NULL;
+static uint16_t nlangs = 0;
+static const DictLang_t *lang = NULL;
+static const uint32_t *edges = NULL;
+static const RankEdge_t *rank_edges = NULL;
+static const uint8_t *text = NULL;
+
+/* Word hash with the state in its low two bits, 0 for an empty entry. Each
+ * set is most recently checked first. */
+static uint32_t cache[SPELL_CACHE_SIZE];
+static uint16_t generation = 0;
+static SpellStats_t stats;
+
+/* Everything the directory entry points at is inside the image */
+static bool langValid(const DictHeader_t *h, const DictLang_t *l) {
+    const uint8_t *image = (const uint8_t *)h;
+    if (l->offset % 4 || l->offset + (uint64_t)l->edges * 4 > h->size || l->root >= l->edges) return false;
+    if (!l->ranked) return true;
+    if (l->rank_offset % 4 || l->text_offset % 4 || l->ranked >= NO_WORD ||
+        l->rank_offset + (uint64_t)l->rank_edges * sizeof(RankEdge_t) > h->size ||
+        l->text_offset + (uint64_t)(l->ranked + 1) * 4 > h->size)
+        return false;
+    return l->text_offset + (uint64_t)((const uint32_t *)(image + l->text_offset))[l->ranked] <= h->size;
+}
+
+bool spellInit(void) {
+    const esp_partition_t *part;
+    esp_partition_mmap_handle_t handle;
+    const void *p;
+
+    memRegisterStatic("spell cache", sizeof(cache), MEM_INTERNAL);
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "dict");
+    if (!part) {
+        printf("Spell: no \"dict\" partition\n");
+        return false;
+    }
+    if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &p, &handle) != ESP_OK) {
+        printf("Error: dict partition was NOT mapped\n");
+        return false;
+    }
+    const DictHeader_t *h = p;
+    bool valid = h->magic == DICT_MAGIC && h->version == DICT_VERSION && h->size <= part->size &&
+                 sizeof(*h) + (uint64_t)h->count * sizeof(DictLang_t) <= h->size;
+    for (uint16_t i = 0; valid && i < h->count; i++) valid = langValid(h, (const DictLang_t *)(h + 1) + i);
+    if (!valid) {
+        printf("Spell: partition holds no dictionary image\n");
+        esp_partition_munmap(handle);
+        return false;
+    }
+    langs = (const DictLang_t *)(h + 1);
+    nlangs = h->count;
+    if (nlangs) spellSetLanguage(langs[0].code);
+    printf("Spell: %u languages, %s selected\n", nlangs, spellLanguage());
+    return true;
+}
+
+bool spellSetLanguage(const char *code) {
+    for (uint16_t i = 0; i < nlangs; i++) {
+        if (strncmp(langs[i].code, code, sizeof(langs[i].code)) != 0) continue;
+        lang = &langs[i];
+        const uint8_t *image = (const uint8_t *)langs - sizeof(DictHeader_t);
+        edges = (const uint32_t *)(image + lang->offset);
+        rank_edges = (const RankEdge_t *)(image + lang->rank_offset);
+        text = image + lang->text_offset;
+        memset(cache, 0, sizeof(cache));
+        generation++;
+        return true;
+    }
+    return false;
+}
+
+const char *spellLanguage(void) {
+    static char code[sizeof(lang->code) + 1];
+    if (!lang) return "";
+    memcpy(code, lang->code, sizeof(lang->code));
+    return code;
+}
+
+uint16_t spellGeneration(void) {
+    return generation;
+}
+
+static bool walk(const uint8_t *word, size_t len) {
+    uint32_t node = lang->root, e = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!node) return false;
+        for (;; node++) {
+            e = edges[node];
+            if ((e & 0xFF) == word[i]) break;
+            if ((e & 0xFF) > word[i] || (e & EDGE_LAST)) return false;
+        }
+        node = e >> CHILD_SHIFT;
+    }
+    return e & EDGE_FINAL;
+}
+
+/* A letter written in capitals, or something that is no letter at all */
+static bool capital(uint32_t cp) {
+    return searchFoldCp(cp) != cp || (cp < 0x80 && ((cp | 0x20) < 'a' || (cp | 0x20) > 'z'));
+}
+
+static uint32_t nextCp(const uint8_t *word, size_t len, size_t *i) {
+    uint32_t cp = word[(*i)++];
+    if (cp >= 0xC0) {
+        int more = cp >= 0xF0 ? 3 : cp >= 0xE0 ? 2 : 1;
+        cp &= 0x3F >> more;
+        for (; more && *i < len; more--) cp = (cp << 6) | (word[(*i)++] & 0x3F);
+    }
+    return cp;
+}
+
+/* Lowercase the codepoints of word from first to before last into out;
+ * folding keeps UTF-8 lengths (search.c). Returns whether any was a capital. */
+static bool lower(const uint8_t *word, size_t len, uint8_t *out, size_t first, size_t last) {
+    bool changed = false;
+    size_t i = 0, n = 0;
+    for (size_t k = 0; i < len; k++) {
+        uint32_t cp = nextCp(word, len, &i);
+        uint32_t folded = (k >= first && k < last) ? searchFoldCp(cp) : cp;
+        changed |= (folded != cp);
+        n += docEncode(folded, out + n);
+    }
+    return changed;
+}
+
+/* Every codepoint after the first a capital: PARIS is Paris or paris */
+static bool shouted(const uint8_t *word, size_t len) {
+    size_t i = 0, n = 0;
+    while (i < len) {
+        uint32_t cp = nextCp(word, len, &i);
+        if (n++ && !capital(cp)) return false;
+    }
+    return n > 1;
+}
+
+bool spellLookup(const uint8_t *word, size_t len) {
+    uint8_t low[SPELL_WORD_MAX];
+    if (!lang || len == 0 || len > SPELL_WORD_MAX) return true;
+    if (walk(word, len)) return true;
+    if (lower(word, len, low, 0, 1) && walk(low, len)) return true;
+    if (!shouted(word, len)) return false;
+    return (lower(word, len, low, 1, len) && walk(low, len)) || (lower(word, len, low, 0, len) && walk(low, len));
+}
+
+size_t spellComplete(const uint8_t *prefix, size_t len, SpellWord_t *out, size_t max) {
+    const RankEdge_t *e = NULL;
+    uint32_t node = 1;
+    size_t n = 0;
+
+    if (!lang || !lang->ranked || len == 0) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!node) return 0;
+        for (;; node++) {
+            e = &rank_edges[node];
+            if ((e->edge & 0xFF) == prefix[i]) break;
+            if ((e->edge & 0xFF) > prefix[i] || (e->edge & EDGE_LAST)) return 0;
+        }
+        node = e->edge >> CHILD_SHIFT;
+    }
+    const uint32_t *ends = (const uint32_t *)text;
+    for (int i = 0; i < SPELL_COMPLETE_TOP && n < max; i++) {
+        uint16_t rank = e->top[i];
+        if (rank >= lang->ranked) break;
+        out[n].text = text + ends[rank];
+        out[n].len = ends[rank + 1] - ends[rank];
+        out[n++].rank = rank;
+    }
+    return n;
+}
+
+static uint32_t hashWord(const uint8_t *word, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) h = (h ^ word[i]) * 16777619u;
+    return h;
+}
+
+static uint32_t *cacheSet(uint32_t h) {
+    return &cache[(h % (SPELL_CACHE_SIZE / SPELL_CACHE_WAYS)) * SPELL_CACHE_WAYS];
+}
+
+int spellCached(const uint8_t *word, size_t len) {
+    if (!lang || len > SPELL_WORD_MAX) return SPELL_OK;
+    uint32_t h = hashWord(word, len) & ~3u, *set = cacheSet(h);
+    for (int i = 0; i < SPELL_CACHE_WAYS; i++)
+        if ((set[i] & ~3u) == h && set[i]) return set[i] & 3;
+    return SPELL_UNKNOWN;
+}
+
+int spellCheck(const uint8_t *word, size_t len) {
+    int state = spellCached(word, len);
+    stats.lookups++;
+    if (state != SPELL_UNKNOWN) {
+        stats.hits++;
+        return state;
+    }
+    stats.misses++;
+    uint32_t h = hashWord(word, len) & ~3u, *set = cacheSet(h);
+    state = spellLookup(word, len) ? SPELL_OK : SPELL_BAD;
+    if (state == SPELL_BAD) stats.bad++;
+    memmove(set + 1, set, (SPELL_CACHE_WAYS - 1) * sizeof(*set));
+    set[0] = h | state;
+    return state;
+}
+
+void spellReport(void) {
+    printf("languages");
+    for (uint16_t i = 0; i < nlangs; i++)
+        printf(" %.4s%s (%" PRIu32 " words, %" PRIu32 " KB)", langs[i].code, &langs[i] == lang ? "*" : "",
+               langs[i].words, langs[i].edges * 4 / 1024);
+    printf("%s\n", nlangs ? "" : " none");
+    if (lang) printf("complete  %" PRIu32 " ranked words\n", lang->ranked);
+    printf("checks    %" PRIu32 ", %" PRIu32 " cached, %" PRIu32 " looked up, %" PRIu32 " misspelled\n",
+           stats.lookups, stats.hits, stats.misses, stats.bad);
+}
+
+void spellResetStats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
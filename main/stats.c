@@ -0,0 +1,33 @@
+/*
+ *  Display and input counters. See stats.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "stats.h"
+
+DisplayStats_t display_stats;
+
+void statsReset(void) {
+    memset(&display_stats, 0, sizeof(display_stats));
+}
+
+void statsPrint(void) {
+    const DisplayStats_t *s = &display_stats;
+    uint32_t flushes = s->full_refreshes + s->partial_refreshes;
+    printf("spi       %" PRIu32 " bytes in %" PRIu32 " transactions\n", s->spi_bytes, s->spi_transactions);
+    printf("refresh   %" PRIu32 " full, %" PRIu32 " partial\n", s->full_refreshes, s->partial_refreshes);
+    printf("lines     %" PRIu32 " sent, %" PRIu32 " skipped\n", s->lines_sent, s->lines_skipped);
+    printf("flush     %" PRIu32 " us total, %" PRIu32 " us avg, %" PRIu32 " us max\n", s->flush_us,
+           flushes ? s->flush_us / flushes : 0, s->flush_us_max);
+    printf("keys      %" PRIu32 " received, %" PRIu32 " dropped\n", s->keys_received, s->keys_dropped);
+    printf("render    %" PRIu32 " glyphs, %" PRIu32 " us\n", s->glyphs, s->raster_us);
+    printf("cursor    %" PRIu32 " blinks, %" PRIu32 " lines\n", s->blinks, s->blink_lines);
+}
+
+int statsFormatLine(char *buf, int size) {
+    const DisplayStats_t *s = &display_stats;
+    return snprintf(buf, size, "SPI %" PRIu32 "k/%" PRIu32 "t L%" PRIu32 "/%" PRIu32 " K%" PRIu32 "/%" PRIu32 " F%" PRIu32 "us",
+                    s->spi_bytes / 1024, s->spi_transactions, s->lines_sent, s->lines_skipped,
+                    s->keys_received, s->keys_dropped, s->flush_us_max);
+}
@@ -0,0 +1,61 @@
+/*
+ *  Static task table and budget report. See tasks.h.
+ */
+#include <stdio.h>
+#include "esp_heap_caps.h"
+#include "tasks.h"
+
+static TaskSlot_t *task_table = NULL;
+static size_t ntasks = 0;
+static QueueSlot_t *queues[MAX_QUEUE_SLOTS];
+static uint8_t nqueues = 0;
+
+void tasksStart(TaskSlot_t *table, size_t n) {
+    task_table = table;
+    ntasks = n;
+    for (size_t i = 0; i < n; i++) {
+        TaskSlot_t *t = &table[i];
+        t->handle = xTaskCreateStaticPinnedToCore(t->fn, t->name, t->stack_size, t->arg, t->priority, t->stack, t->tcb,
+                                                  TASKS_CORE);
+        if (!t->handle) printf("Error: task %s was NOT created\n", t->name);
+    }
+}
+
+void tasksRegisterQueue(QueueSlot_t *queue) {
+    if (nqueues < MAX_QUEUE_SLOTS) queues[nqueues++] = queue;
+}
+
+void tasksExit(void) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (size_t i = 0; i < ntasks; i++)
+        if (task_table[i].handle == self) task_table[i].handle = NULL;
+    vTaskDelete(NULL);
+}
+
+static void heapLine(const char *name, uint32_t caps) {
+    printf("%-10s %9u %9u %9u\n", name, (unsigned)heap_caps_get_free_size(caps),
+           (unsigned)heap_caps_get_minimum_free_size(caps), (unsigned)heap_caps_get_largest_free_block(caps));
+}
+
+void tasksReport(void) {
+    printf("%-10s %6s %6s %6s\n", "task", "stack", "peak", "free");
+    for (size_t i = 0; i < ntasks; i++) {
+        const TaskSlot_t *t = &task_table[i];
+        if (!t->handle) {
+            printf("%-10s %6u exited\n", t->name, (unsigned)t->stack_size);
+            continue;
+        }
+        unsigned free = uxTaskGetStackHighWaterMark(t->handle);    // bytes on ESP-IDF
+        printf("%-10s %6u %6u %6u\n", t->name, (unsigned)t->stack_size, (unsigned)(t->stack_size - free), free);
+    }
+
+    printf("%-10s %6s %6s %6s\n", "queue", "length", "now", "high");
+    for (uint8_t i = 0; i < nqueues; i++)
+        printf("%-10s %6u %6u %6u\n", queues[i]->name, queues[i]->length,
+               (unsigned)uxQueueMessagesWaiting(queues[i]->handle), queues[i]->high);
+
+    printf("%-10s %9s %9s %9s\n", "heap", "free", "min free", "largest");
+    heapLine("internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    heapLine("dma", MALLOC_CAP_DMA);
+    heapLine("psram", MALLOC_CAP_SPIRAM);
+}
@@ -0,0 +1,79 @@
+/*
+ *  Trace ring storage and Chrome trace JSON export. See trace.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "trace.h"
+
+TraceEvent_t trace_ring[TRACE_EVENTS];
+uint32_t trace_head = 0;
+
+static const char *const task_names[] = { "keyboard", "keysimu" };
+static const char *const render_names[] = { "put-glyph", "clear-span", "invert-span", "scroll", "draw-cursor", "dropped" };
+
+void traceSync(void) {
+    trace(TRACE_SYNC, 0, 0, (uint32_t)esp_timer_get_time());
+}
+
+void traceClear(void) {
+    trace_head = 0;
+    memset(trace_ring, 0, sizeof(trace_ring));
+}
+
+static const char *taskName(uint8_t id) {
+    return id < sizeof(task_names) / sizeof(task_names[0]) ? task_names[id] : "task";
+}
+
+void traceDumpJson(void) {
+    uint32_t head = trace_head;
+    uint32_t n = head < TRACE_EVENTS ? head : TRACE_EVENTS;
+    double base_us = 0;
+    uint32_t base_cycles = n ? trace_ring[(head - n) & (TRACE_EVENTS - 1)].cycles : 0;
+    const char *sep = "";
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (uint32_t i = head - n; i != head; i++) {
+        const TraceEvent_t *e = &trace_ring[i & (TRACE_EVENTS - 1)];
+        if (e->type == TRACE_SYNC) {
+            base_us = e->arg32;
+            base_cycles = e->cycles;
+            continue;
+        }
+        double ts = base_us + (double)(uint32_t)(e->cycles - base_cycles) / TRACE_TICKS_PER_US;
+
+        printf("%s{\"ts\":%.3f,\"pid\":0,", sep, ts);
+        sep = ",\n";
+        switch (e->type) {
+        case TRACE_TASK_RUN:
+        case TRACE_TASK_WAIT:
+            printf("\"tid\":\"%s\",\"name\":\"run\",\"ph\":\"%c\"}", taskName(e->arg8),
+                   e->type == TRACE_TASK_RUN ? 'B' : 'E');
+            break;
+        case TRACE_KEY:
+            printf("\"tid\":\"input\",\"name\":\"key\",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"event\":%u}}", e->arg8);
+            break;
+        case TRACE_RENDER:
+            printf("\"tid\":\"render\",\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"col\":%u,\"row\":%u}}",
+                   e->arg8 < sizeof(render_names) / sizeof(render_names[0]) ? render_names[e->arg8] : "op",
+                   e->arg16 & 0xff, e->arg16 >> 8);
+            break;
+        case TRACE_FLUSH_BEGIN:
+            printf("\"tid\":\"display\",\"name\":\"flush\",\"ph\":\"B\",\"args\":{\"lines\":%u}}", e->arg16);
+            break;
+        case TRACE_FLUSH_END:
+            printf("\"tid\":\"display\",\"name\":\"flush\",\"ph\":\"E\"}");
+            break;
+        case TRACE_SPI_BEGIN:
+            printf("\"tid\":\"spi\",\"name\":\"transfer\",\"ph\":\"B\",\"args\":{\"bytes\":%u}}", (unsigned)e->arg32);
+            break;
+        case TRACE_SPI_END:
+            printf("\"tid\":\"spi\",\"name\":\"transfer\",\"ph\":\"E\"}");
+            break;
+        default:
+            printf("\"tid\":\"other\",\"name\":\"event %u\",\"ph\":\"i\",\"s\":\"t\"}", e->type);
+            break;
+        }
+    }
+    printf("\n]}\n");
+}
@@ -0,0 +1,100 @@
+/*
+ *  VCOM inversion without a dedicated task. See vcom.h.
+ */
+#include <stdio.h>
+#include "driver/ledc.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "sharp.h"
+#include "vcom.h"
+
+#define PIN_NUM_VCOM   33
+#define PIN_BLUE_LED   13
+
+#define VCOM_DUTY_RES LEDC_TIMER_14_BIT
+#define VCOM_DUTY_HALF (1 << (VCOM_DUTY_RES - 1))
+
+#if VCOM_MODE == VCOM_MODE_LEDC
+
+void vcomInit(void)
+{
+    ledc_timer_config_t timer = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .duty_resolution = VCOM_DUTY_RES,
+        .timer_num = LEDC_TIMER_0,
+        .freq_hz = VCOM_FREQ_HZ,
+        .clk_cfg = LEDC_USE_RC_FAST_CLK,        // keeps running in light sleep
+    };
+    ESP_ERROR_CHECK(ledc_timer_config(&timer));
+
+    // The blue LED follows VCOM on a second channel of the same timer
+    const int pins[] = { PIN_NUM_VCOM, PIN_BLUE_LED };
+    for (int i = 0; i < 2; i++) {
+        ledc_channel_config_t channel = {
+            .gpio_num = pins[i],
+            .speed_mode = LEDC_LOW_SPEED_MODE,
+            .channel = (ledc_channel_t)(LEDC_CHANNEL_0 + i),
+            .timer_sel = LEDC_TIMER_0,
+            .duty = VCOM_DUTY_HALF,
+            .hpoint = 0,
+            .sleep_mode = LEDC_SLEEP_MODE_KEEP_ALIVE,
+        };
+        ESP_ERROR_CHECK(ledc_channel_config(&channel));
+    }
+    printf("VCOM on LEDC at %d Hz, pin %d\n", VCOM_FREQ_HZ, PIN_NUM_VCOM);
+}
+
+bool vcomPhase(void)
+{
+    return false;
+}
+
+bool vcomDue(void)
+{
+    return false;
+}
+
+#else
+
+static esp_timer_handle_t vcom_timer;
+static int64_t flipped_at;
+static bool phase;
+
+static void vcomMaintain(void *arg)
+{
+    displayMaintainVcom();
+}
+
+void vcomInit(void)
+{
+    // EXTCOMIN is unused in this mode, keep it at a defined level
+    gpio_set_direction(PIN_NUM_VCOM, GPIO_MODE_OUTPUT);
+    gpio_set_level((gpio_num_t)PIN_NUM_VCOM, 0);
+
+    const esp_timer_create_args_t args = {
+        .callback = vcomMaintain,
+        .name = "vcom",
+        .skip_unhandled_events = true,
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&args, &vcom_timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(vcom_timer, VCOM_HALF_PERIOD_US));
+    printf("VCOM in software at %d Hz\n", VCOM_FREQ_HZ);
+}
+
+bool vcomDue(void)
+{
+    return esp_timer_get_time() - flipped_at >= VCOM_HALF_PERIOD_US;
+}
+
+/* Transfers flip early, so the timer's checks drift off the flips and
+ * find them already made while flushes keep coming */
+bool vcomPhase(void)
+{
+    if (esp_timer_get_time() - flipped_at >= VCOM_HALF_PERIOD_US / 2) {
+        phase = !phase;
+        flipped_at = esp_timer_get_time();
+    }
+    return phase;
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ *  Sharp transport timing model and calibration. See wire.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_timer.h"
+#include "sharp.h"
+#include "trace.h"
+#include "wire.h"
+
+#define LINES_PER_TRANS 24      /* as batched by updateLines() */
+
+WireParams_t wire_params = {
+    .clock_hz = SHARP_SPI_CLOCK_HZ,
+    .cs_setup_us = SHARP_CS_SETUP_US,
+    .cs_hold_us = SHARP_CS_HOLD_US,
+    .trans_ns = 20000,          /* until calibrated */
+    .queue_depth = 1,
+};
+
+static WireFlush_t flushes[WIRE_MAX_FLUSHES];
+
+static uint32_t max32(uint32_t a, uint32_t b) { return a > b ? a : b; }
+
+/* Two-stage pipeline: the driver sets a transaction up while up to
+ * queue_depth - 1 earlier ones are still on the wire. */
+uint32_t wireModelFlush(const WireParams_t *p, const WireFlush_t *f) {
+    uint32_t wire_done[WIRE_MAX_TRANS];
+    uint32_t start = p->cs_setup_us * 1000;
+    uint32_t setup = start, wire = start;
+    uint8_t depth = p->queue_depth ? p->queue_depth : 1;
+
+    for (uint8_t i = 0; i < f->ntrans; i++) {
+        uint32_t slot = i >= depth ? wire_done[i - depth] : start;
+        setup = max32(setup, slot) + p->trans_ns;
+        wire = max32(setup, wire) + (uint32_t)((uint64_t)f->bytes[i] * 8 * 1000000000ULL / p->clock_hz);
+        wire_done[i] = wire;
+    }
+    return wire + p->cs_hold_us * 1000;
+}
+
+static void append(WireFlush_t *out, size_t max, size_t *n, const WireFlush_t *f) {
+    if (*n == max) {
+        memmove(out, out + 1, (max - 1) * sizeof(*out));
+        (*n)--;
+    }
+    out[(*n)++] = *f;
+}
+
+size_t wireCollect(WireFlush_t *out, size_t max) {
+    uint32_t head = trace_head;
+    uint32_t n = head < TRACE_EVENTS ? head : TRACE_EVENTS;
+    uint32_t begin = 0;
+    bool open = false;
+    WireFlush_t cur;
+    size_t count = 0;
+
+    for (uint32_t i = head - n; i != head; i++) {
+        const TraceEvent_t *e = &trace_ring[i & (TRACE_EVENTS - 1)];
+        switch (e->type) {
+        case TRACE_FLUSH_BEGIN:
+            memset(&cur, 0, sizeof(cur));
+            cur.lines = e->arg16;
+            begin = e->cycles;
+            open = true;
+            break;
+        case TRACE_SPI_BEGIN:
+            if (open && cur.ntrans < WIRE_MAX_TRANS) cur.bytes[cur.ntrans++] = e->arg32;
+            break;
+        case TRACE_FLUSH_END:
+            if (!open) break;
+            cur.measured_us = (e->cycles - begin) / TRACE_TICKS_PER_US;
+            append(out, max, &count, &cur);
+            open = false;
+            break;
+        default:
+            break;
+        }
+    }
+    return count;
+}
+
+/* The transactions updateLines() sends for a given number of lines */
+static void shape(WireFlush_t *f, uint16_t lines) {
+    memset(f, 0, sizeof(*f));
+    f->lines = lines;
+    for (uint16_t left = lines; left && f->ntrans < WIRE_MAX_TRANS; ) {
+        uint16_t k = left < LINES_PER_TRANS ? left : LINES_PER_TRANS;
+        f->bytes[f->ntrans++] = k * SHARP_LINE_FRAME;
+        left -= k;
+    }
+    f->bytes[0] += 1;                   /* command byte */
+    f->bytes[f->ntrans - 1] += 1;       /* trailer */
+}
+
+static void printFlushes(const WireParams_t *p, const WireFlush_t *f, size_t n) {
+    uint64_t measured = 0, predicted = 0;
+
+    printf("clock %" PRIu32 " Hz, depth %u, CS %u+%u us, %u ns/transaction\n", p->clock_hz,
+           p->queue_depth, p->cs_setup_us, p->cs_hold_us, p->trans_ns);
+    printf("lines trans  bytes  measured_us predicted_us\n");
+    for (size_t i = 0; i < n; i++) {
+        uint32_t bytes = 0, us = wireModelFlush(p, &f[i]) / 1000;
+        for (uint8_t t = 0; t < f[i].ntrans; t++) bytes += f[i].bytes[t];
+        printf("%5u %5u %6" PRIu32 " %12" PRIu32 " %12" PRIu32 "\n", f[i].lines, f[i].ntrans, bytes,
+               f[i].measured_us, us);
+        measured += f[i].measured_us;
+        predicted += us;
+    }
+    printf("total %" PRIu64 " us measured, %" PRIu64 " us predicted\n", measured, predicted);
+}
+
+void wireReport(const WireParams_t *p) {
+    size_t n = wireCollect(flushes, WIRE_MAX_FLUSHES);
+    if (!n) {
+        printf("No flushes in the trace\n");
+        return;
+    }
+    printf("%u flushes from the trace\n", (unsigned)n);
+    printFlushes(p, flushes, n);
+}
+
+void wireCalibrate(WireParams_t *p) {
+    static const uint16_t standard[] = { 1, PSF_GLYPH_SIZE, PXHEIGHT };
+    size_t n = wireCollect(flushes, WIRE_MAX_FLUSHES);
+    int64_t excess = 0;
+    uint32_t ntrans = 0;
+    WireParams_t bare = *p;
+
+    if (!n) {
+        for (n = 0; n < sizeof(standard) / sizeof(standard[0]); n++) shape(&flushes[n], standard[n]);
+    }
+
+    /* Replay: same line counts give the same transactions; the content is
+     * whatever is in the framebuffer, so the panel does not change. */
+    for (size_t i = 0; i < n; i++) {
+        LineMask_t lines = {0};
+        for (uint16_t y = 0; y < flushes[i].lines && y < PXHEIGHT; y++) LINEMASK_SET(lines, y);
+        int64_t t0 = esp_timer_get_time();
+        updateLines(lines);
+        flushes[i].measured_us = esp_timer_get_time() - t0;
+    }
+
+    /* Whatever the wire and CS delays do not explain is per-transaction cost */
+    bare.trans_ns = 0;
+    bare.queue_depth = 1;
+    for (size_t i = 0; i < n; i++) {
+        excess += (int64_t)flushes[i].measured_us * 1000 - wireModelFlush(&bare, &flushes[i]);
+        ntrans += flushes[i].ntrans;
+    }
+    if (ntrans) {
+        int64_t per = excess / ntrans;
+        p->trans_ns = per < 0 ? 0 : per > UINT16_MAX ? UINT16_MAX : per;
+    }
+    p->queue_depth = 1;
+    printf("Replayed %u flushes\n", (unsigned)n);
+    printFlushes(p, flushes, n);
+}
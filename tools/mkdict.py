@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""Build a spelling dictionary image (see include/spell.h) from word lists.
+
+Each list is UTF-8, one word per line. Hunspell .dic files work too: the
+count on the first line and /flags are dropped, so give them expanded
+(unmunch) so that every inflected form is listed.
+
+A word may be followed by a frequency count ("the 23135851162"); the most
+frequent --top of those (default 4096) are also kept, ranked, for word
+completion.
+
+    tools/mkdict.py [--top N] en:en_US.txt es:es_ES.txt it:it_IT.txt no:nb_NO.txt dict.bin
+    parttool.py write_partition --partition-name dict --input dict.bin
+
+Check words and completions against an image the way the firmware does:
+
+    tools/mkdict.py --lookup dict.bin en colour color
+    tools/mkdict.py --complete dict.bin en th
+"""
+import struct
+import sys
+
+DICT_MAGIC = 0x44535754     # "TWSD"
+DICT_VERSION = 2
+EDGE_LAST = 1 << 8
+EDGE_FINAL = 1 << 9
+CHILD_SHIFT = 10
+MAX_EDGES = 1 << (32 - CHILD_SHIFT)
+WORD_MAX = 32
+TOP = 4                     # completions kept per ranked trie node
+NO_WORD = 0xFFFF
+HEADER = '<IHHII'
+LANG = '<4s8I'
+
+
+class Node:
+    __slots__ = ('final', 'edges', 'uid')
+
+    def __init__(self):
+        self.final = False
+        self.edges = []         # (byte, Node), ascending
+        self.uid = None
+
+    def key(self):
+        return (self.final, tuple((b, n.uid) for b, n in self.edges))
+
+
+def build(words):
+    """Minimal DAWG from sorted unique byte strings (Daciuk et al.)"""
+    root = Node()
+    register = {}
+    count = [0]
+
+    def replace_or_register(state):
+        b, child = state.edges[-1]
+        if child.edges:
+            replace_or_register(child)
+        k = child.key()
+        if k in register:
+            state.edges[-1] = (b, register[k])
+        else:
+            child.uid = count[0]
+            count[0] += 1
+            register[k] = child
+
+    prev = b''
+    for w in words:
+        i = 0
+        node = root
+        while i < len(w) and i < len(prev) and w[i] == prev[i]:
+            node = node.edges[-1][1]
+            i += 1
+        if node.edges:
+            replace_or_register(node)
+        for b in w[i:]:
+            n = Node()
+            node.edges.append((b, n))
+            node = n
+        node.final = True
+        prev = w
+    if root.edges:
+        replace_or_register(root)
+    return root
+
+
+def encode(root):
+    """Edge lists breadth first from the root's at index 1; 0 means no children"""
+    edges = [0]
+    where = {}
+    order = [root]
+    where[id(root)] = 1
+    size = 1 + len(root.edges)
+    i = 0
+    while i < len(order):
+        node = order[i]
+        i += 1
+        for _, child in node.edges:
+            if child.edges and id(child) not in where:
+                where[id(child)] = size
+                size += len(child.edges)
+                order.append(child)
+    if size > MAX_EDGES:
+        sys.exit('dictionary too large: %d edges' % size)
+    for node in order:
+        for j, (b, child) in enumerate(node.edges):
+            e = b | (where[id(child)] << CHILD_SHIFT if child.edges else 0)
+            if child.final:
+                e |= EDGE_FINAL
+            if j == len(node.edges) - 1:
+                e |= EDGE_LAST
+            edges.append(e)
+    return edges
+
+
+def read_words(path):
+    """Sorted words, and the counted ones most frequent first"""
+    words = set()
+    counts = {}
+    with open(path, encoding='utf-8') as f:
+        for n, line in enumerate(f):
+            fields = line.split()
+            if not fields or fields[0].startswith('#') or (n == 0 and fields[0].isdigit()):
+                continue
+            b = fields[0].split('/')[0].encode('utf-8')
+            if not b or len(b) > WORD_MAX:
+                continue
+            words.add(b)
+            if len(fields) > 1 and fields[1].isdigit():
+                counts[b] = counts.get(b, 0) + int(fields[1])
+    return sorted(words), sorted(counts, key=lambda w: (-counts[w], w))
+
+
+def ranked_trie(ranked):
+    """Plain trie of the ranked words, each edge carrying the TOP best (lowest
+    rank) words below it, as 12-byte records: edge, then TOP uint16 ranks"""
+    root = {}
+    for rank, w in enumerate(ranked):
+        node = root
+        for b in w:
+            node = node.setdefault(b, [{}, False, []])
+            if len(node[2]) < TOP:
+                node[2].append(rank)    # ranks arrive in order, best first
+            node, last = node[0], node
+        last[1] = True
+
+    records = [b'\0' * (4 + 2 * TOP)]
+    lists = [root]
+    where = [1]
+    size = 1 + len(root)
+    i = 0
+    while i < len(lists):               # breadth first, as encode()
+        for b in sorted(lists[i]):
+            kids = lists[i][b][0]
+            if kids:
+                where.append(size)
+                size += len(kids)
+                lists.append(kids)
+        i += 1
+    if size > MAX_EDGES:
+        sys.exit('too many ranked words')
+    k = 1
+    for node in lists:
+        labels = sorted(node)
+        for j, b in enumerate(labels):
+            kids, final, top = node[b]
+            e = b | (where[k] << CHILD_SHIFT if kids else 0)
+            if kids:
+                k += 1
+            if final:
+                e |= EDGE_FINAL
+            if j == len(labels) - 1:
+                e |= EDGE_LAST
+            records.append(struct.pack('<I%dH' % TOP, e, *(top + [NO_WORD] * (TOP - len(top)))))
+    return records
+
+
+def lookup(edges, root, word):
+    node = root
+    for i, b in enumerate(word):
+        if not node:
+            return False
+        while True:
+            e = edges[node]
+            if e & 0xFF == b:
+                break
+            if e & 0xFF > b or e & EDGE_LAST:
+                return False
+            node += 1
+        if i == len(word) - 1:
+            return bool(e & EDGE_FINAL)
+        node = e >> CHILD_SHIFT
+    return False
+
+
+def complete(data, lang, prefix):
+    _, _, _, _, _, ranked, rank_offset, _, text_offset = lang
+    node = 1
+    top = []
+    for b in prefix:
+        if not node or not ranked:
+            return []
+        while True:
+            e, *top = struct.unpack_from('<I%dH' % TOP, data, rank_offset + (4 + 2 * TOP) * node)
+            if e & 0xFF == b:
+                break
+            if e & 0xFF > b or e & EDGE_LAST:
+                return []
+            node += 1
+        node = e >> CHILD_SHIFT
+    words = []
+    for rank in top:
+        if rank != NO_WORD:
+            a, z = struct.unpack_from('<2I', data, text_offset + 4 * rank)
+            words.append(data[text_offset + a:text_offset + z].decode('utf-8'))
+    return words
+
+
+def load(path):
+    data = open(path, 'rb').read()
+    magic, version, count, _, _ = struct.unpack_from(HEADER, data)
+    if magic != DICT_MAGIC or version != DICT_VERSION:
+        sys.exit('%s is not a dictionary image' % path)
+    langs = {}
+    for i in range(count):
+        lang = struct.unpack_from(LANG, data, struct.calcsize(HEADER) + struct.calcsize(LANG) * i)
+        code, root, offset, n = lang[:4]
+        langs[code.rstrip(b'\0').decode()] = (struct.unpack_from('<%dI' % n, data, offset), root, lang, data)
+    return langs
+
+
+def main():
+    args = sys.argv[1:]
+    if len(args) > 2 and args[0] in ('--lookup', '--complete'):
+        edges, root, lang, data = load(args[1])[args[2]]
+        for w in args[3:]:
+            if args[0] == '--lookup':
+                print('%-20s %s' % (w, 'ok' if lookup(edges, root, w.encode('utf-8')) else 'unknown'))
+            else:
+                print('%-20s %s' % (w, ' '.join(complete(data, lang, w.encode('utf-8')))))
+        return
+    top = 4096
+    if len(args) > 1 and args[0] == '--top':
+        top = int(args[1])
+        args = args[2:]
+    if len(args) < 2:
+        sys.exit(__doc__)
+
+    langs = []
+    for arg in args[:-1]:
+        code, _, path = arg.partition(':')
+        if not path or not 0 < len(code) < 4:
+            sys.exit('expected lang:file, got %s' % arg)
+        words, ranked = read_words(path)
+        ranked = ranked[:min(top, NO_WORD)]
+        edges = encode(build(words))
+        records = ranked_trie(ranked) if ranked else []
+        langs.append((code, words, edges, ranked, records))
+        print('%s: %d words, %d edges, %d bytes; %d ranked, %d bytes' %
+              (code, len(words), len(edges), 4 * len(edges), len(ranked), sum(map(len, records))))
+
+    offset = struct.calcsize(HEADER) + struct.calcsize(LANG) * len(langs)
+    head = b''
+    body = b''
+    for code, words, edges, ranked, records in langs:
+        dawg = offset + len(body)
+        body += struct.pack('<%dI' % len(edges), *edges)
+        rank_offset = offset + len(body)
+        body += b''.join(records)
+        text_offset = offset + len(body)
+        text = b''
+        ends = [4 * (len(ranked) + 1)]
+        for w in ranked:
+            text += w
+            ends.append(ends[0] + len(text))
+        body += struct.pack('<%dI' % len(ends), *ends) + text if ranked else b''
+        body += b'\0' * (-len(body) % 4)
+        head += struct.pack(LANG, code.encode(), 1, dawg, len(edges), len(words),
+                            len(ranked), rank_offset, len(records), text_offset)
+    out = struct.pack(HEADER, DICT_MAGIC, DICT_VERSION, len(langs), offset + len(body), 0) + head + body
+    open(sys.argv[-1], 'wb').write(out)
+    print('%d bytes' % len(out))
+
+
+if __name__ == '__main__':
+    main()
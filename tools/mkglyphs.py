@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Build a glyph store image (see include/glyphstore.h) from a PSF2 font.
+
+Only 8x16 fonts with a Unicode table are supported, such as the Terminus
+or Lat2/Greek/Cyrillic console fonts (gunzip the .psf.gz first).
+
+    tools/mkglyphs.py ter-v16n.psf glyphs.bin
+    parttool.py write_partition --partition-name glyphs --input glyphs.bin
+"""
+import struct
+import sys
+
+PSF2_MAGIC = 0x864AB572
+PSF2_HAS_UNICODE_TABLE = 0x01
+GLYPH_BYTES = 16
+
+
+def reverse_bits(b):
+    return int('{:08b}'.format(b)[::-1], 2)
+
+
+def read_psf2(data):
+    magic, version, headersize, flags, length, charsize, height, width = struct.unpack_from('<8I', data)
+    if magic != PSF2_MAGIC:
+        sys.exit('not a PSF2 font')
+    if width != 8 or height != 16 or charsize != GLYPH_BYTES:
+        sys.exit('need an 8x16 font, got %dx%d' % (width, height))
+    if not flags & PSF2_HAS_UNICODE_TABLE:
+        sys.exit('font has no Unicode table')
+    glyphs = [data[headersize + i * charsize:headersize + (i + 1) * charsize] for i in range(length)]
+
+    # Unicode table: per glyph, UTF-8 codepoints then sequences, ended by 0xFF
+    cps = {}
+    pos = headersize + length * charsize
+    for i in range(length):
+        end = data.index(b'\xff', pos)
+        entry = data[pos:end].split(b'\xfe')[0]    # skip combining sequences
+        for ch in entry.decode('utf-8'):
+            cps.setdefault(ord(ch), i)
+        pos = end + 1
+    return glyphs, cps
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    glyphs, cps = read_psf2(open(sys.argv[1], 'rb').read())
+    order = sorted(cps)
+    out = struct.pack('<IHHII', 0x46475754, 1, GLYPH_BYTES, len(order), 0)
+    out += struct.pack('<%dI' % len(order), *order)
+    for cp in order:
+        # PSF is MSB first with 1 = ink; the panel is LSB first with 0 = ink
+        out += bytes(reverse_bits(b) ^ 0xFF for b in glyphs[cps[cp]])
+    open(sys.argv[2], 'wb').write(out)
+    print('%d glyphs, %d bytes' % (len(order), len(out)))
+
+
+if __name__ == '__main__':
+    main()